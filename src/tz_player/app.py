@@ -21,10 +21,12 @@ import sqlite3
 import sys
 import time
 from dataclasses import replace
+from functools import partial
 from pathlib import Path
 from typing import Any, Callable, Literal, cast
 
 from rich.text import Text
+from textual import events
 from textual.app import App, ComposeResult
 from textual.containers import Horizontal, Vertical
 from textual.css.query import NoMatches
@@ -37,18 +39,42 @@ from . import __version__
 from .doctor import render_report, run_doctor
 from .events import PlayerStateChanged, TrackChanged
 from .logging_utils import setup_logging
-from .paths import db_path, log_dir, state_path, visualizer_plugin_dir
+from .paths import (
+    analysis_cache_db_path,
+    db_path,
+    log_dir,
+    state_path,
+    visualizer_plugin_dir,
+)
+from .perf_profiling import DEFAULT_SAMPLE_HZ, StackSampler
 from .runtime_config import (
     VISUALIZER_RESPONSIVENESS_PROFILES,
     normalize_visualizer_responsiveness_profile,
     profile_default_beat_hop_ms,
     profile_default_player_poll_interval_s,
     profile_default_spectrum_hop_ms,
+    profile_default_spectrum_interpolation,
     profile_default_visualizer_fps,
     resolve_log_level,
 )
+from .services.analysis_availability import AnalysisAvailabilityIndex
+from .services.analysis_cache_db import (
+    import_legacy_analysis_cache,
+    list_analysis_entries,
+)
 from .services.analysis_cache_pruner import SqliteAnalysisCachePruner
-from .services.audio_analysis_bundle import analyze_track_analysis_bundle
+from .services.analysis_io import analysis_io_budget
+from .services.analysis_lease import (
+    LEASE_POLL_S,
+    LEASE_WAIT_TIMEOUT_S,
+    SqliteAnalysisLeaseStore,
+    analysis_lease_key,
+)
+from .services.audio_analysis_bundle import (
+    AnalysisBundleResult,
+    analysis_segment_ms,
+    analyze_track_analysis_bundle,
+)
 from .services.audio_envelope_analysis import (
     analyze_track_envelope,
     ffmpeg_available,
@@ -63,7 +89,7 @@ from .services.fake_backend import FakePlaybackBackend
 from .services.metadata_service import MetadataService
 from .services.player_service import PlayerService, PlayerState, TrackInfo
 from .services.playlist_store import PlaylistStore
-from .services.spectrum_service import SpectrumService
+from .services.spectrum_service import SpectrumInterpolation, SpectrumService
 from .services.spectrum_store import SpectrumParams, SqliteSpectrumStore
 from .services.vlc_backend import VLCPlaybackBackend
 from .services.waveform_proxy_service import WaveformProxyService
@@ -77,14 +103,15 @@ from .ui.actions_menu import ActionsMenuDismissed, ActionsMenuPopup, ActionsMenu
 from .ui.modals.error import ErrorModal
 from .ui.playlist_pane import PlaylistPane
 from .ui.status_pane import StatusPane
-from .utils.async_utils import run_blocking, run_cpu_bound
+from .utils.async_utils import executor_lane, run_blocking, run_cpu_bound
+from .utils.tick_scheduler import TickScheduler
 from .version import build_help_epilog
 from .visualizers import (
     VisualizerContext,
-    VisualizerFrameInput,
     VisualizerHost,
     VisualizerRegistry,
 )
+from .visualizers.frame_snapshot import FrameSnapshotBuilder
 
 logger = logging.getLogger(__name__)
 METADATA_REFRESH_DEBOUNCE = 0.2
@@ -94,7 +121,6 @@ ANALYSIS_CACHE_MAX_BYTES = 2 * 1024 * 1024 * 1024
 ANALYSIS_CACHE_MAX_AGE_DAYS = 180
 ANALYSIS_CACHE_MIN_RECENT_TRACKS_PROTECTED = 200
 ANALYSIS_CACHE_PRUNE_TRIGGER_THRESHOLD = 0.90
-ANALYSIS_MAX_CONCURRENT_PER_TYPE = 2
 ANALYSIS_MAX_PENDING_TASKS_PER_TYPE = 8
 ANALYSIS_SCHEDULE_COOLDOWN_S = 0.75
 ENVELOPE_ANALYSIS_MIN_DWELL_S = 1.5
@@ -107,6 +133,7 @@ VISUALIZER_HEALTHY_FRAMES_FOR_RECOVERY = 120
 VISUALIZER_OVERRUN_SCORE_BACKOFF = 2.5
 VISUALIZER_OVERRUN_SCORE_DECAY = 0.15
 VISUALIZER_BACKOFF_COOLDOWN_FRAMES = 30
+_PLAYING_ROW_FIELDS = frozenset({"status", "item_id"})
 CYBERPUNK_THEME = Theme(
     name="cyberpunk-clean",
     primary="#00D7E6",
@@ -351,6 +378,10 @@ class TzPlayerApp(App):
         self.waveform_proxy_store: SqliteWaveformProxyStore | None = None
         self.waveform_proxy_service: WaveformProxyService | None = None
         self.analysis_cache_pruner: SqliteAnalysisCachePruner | None = None
+        self.analysis_leases: SqliteAnalysisLeaseStore | None = None
+        self.analysis_availability = AnalysisAvailabilityIndex()
+        self.tick_scheduler = TickScheduler()
+        self.tick_scheduler.add_listener(self._on_tick_mode_changed)
         self._metadata_refresh_task: asyncio.Task[None] | None = None
         self._metadata_pending_ids: set[int] = set()
         self._envelope_analysis_tasks: dict[str, asyncio.Task[None]] = {}
@@ -387,6 +418,7 @@ class TzPlayerApp(App):
         self.visualizer_host: VisualizerHost | None = None
         self._visualizer_timer: Timer | None = None
         self._visualizer_render_task: asyncio.Task[None] | None = None
+        self._visualizer_frame_builder = FrameSnapshotBuilder()
         self._visualizer_render_pending = False
         self._visualizer_frames_coalesced = 0
         self._visualizer_runtime_fps = 0
@@ -506,6 +538,9 @@ class TzPlayerApp(App):
                     "profile": effective_profile,
                     "visualizer_fps": effective_fps,
                     "spectrum_hop_ms": profile_spectrum_hop_ms,
+                    "spectrum_interpolation": profile_default_spectrum_interpolation(
+                        effective_profile
+                    ),
                     "beat_hop_ms": profile_beat_hop_ms,
                     "waveform_proxy_hop_ms": waveform_hop_ms,
                     "player_poll_interval_s": profile_poll_interval_s,
@@ -514,27 +549,51 @@ class TzPlayerApp(App):
             await self._save_state_snapshot(self.state)
             try:
                 await self.store.initialize()
-                self.audio_envelope_store = SqliteEnvelopeStore(db_path())
+                cache_db = analysis_cache_db_path()
+                self.audio_envelope_store = SqliteEnvelopeStore(cache_db)
                 await self.audio_envelope_store.initialize()
-                self.spectrum_store = SqliteSpectrumStore(db_path())
+                self.spectrum_store = SqliteSpectrumStore(cache_db)
                 await self.spectrum_store.initialize()
                 self.spectrum_service = SpectrumService(
                     cache_provider=self.spectrum_store,
                     schedule_analysis=self._schedule_spectrum_analysis_for_path,
+                    availability=self.analysis_availability,
+                    interpolation=cast(
+                        SpectrumInterpolation,
+                        profile_default_spectrum_interpolation(effective_profile),
+                    ),
                 )
-                self.beat_store = SqliteBeatStore(db_path())
+                self.beat_store = SqliteBeatStore(cache_db)
                 await self.beat_store.initialize()
                 self.beat_service = BeatService(
                     cache_provider=self.beat_store,
                     schedule_analysis=self._schedule_beat_analysis_for_path,
+                    availability=self.analysis_availability,
                 )
-                self.waveform_proxy_store = SqliteWaveformProxyStore(db_path())
+                self.waveform_proxy_store = SqliteWaveformProxyStore(cache_db)
                 await self.waveform_proxy_store.initialize()
                 self.waveform_proxy_service = WaveformProxyService(
                     cache_provider=self.waveform_proxy_store,
                     schedule_analysis=self._schedule_waveform_proxy_analysis_for_path,
+                    availability=self.analysis_availability,
+                )
+                self.analysis_cache_pruner = SqliteAnalysisCachePruner(cache_db)
+                self.analysis_leases = SqliteAnalysisLeaseStore(cache_db)
+                await self.analysis_leases.initialize()
+                await run_blocking(import_legacy_analysis_cache, cache_db, db_path())
+                self.analysis_availability.load_ready(
+                    await run_blocking(list_analysis_entries, cache_db),
+                    {
+                        SqliteSpectrumStore.ANALYSIS_TYPE: SpectrumParams,
+                        SqliteBeatStore.ANALYSIS_TYPE: BeatParams,
+                        SqliteWaveformProxyStore.ANALYSIS_TYPE: WaveformProxyParams,
+                    },
+                    analysis_versions={
+                        SqliteSpectrumStore.ANALYSIS_TYPE: (
+                            SqliteSpectrumStore.ANALYSIS_VERSION
+                        ),
+                    },
                 )
-                self.analysis_cache_pruner = SqliteAnalysisCachePruner(db_path())
                 playlist_id = await self.store.ensure_playlist("Default")
             except Exception as exc:
                 raise RuntimeError("Database startup failed") from exc
@@ -544,6 +603,8 @@ class TzPlayerApp(App):
             self.playlist_id = playlist_id
             self.player_state = self._player_state_from_appstate(playlist_id)
             backend = _build_backend(backend_name)
+            if isinstance(backend, VLCPlaybackBackend):
+                backend.set_wakeup_observer(self.tick_scheduler.record_wakeup)
             self.player_service = PlayerService(
                 emit_event=self._handle_player_event,
                 track_info_provider=self._track_info_provider,
@@ -559,6 +620,7 @@ class TzPlayerApp(App):
                 waveform_proxy_service=self.waveform_proxy_service,
                 waveform_proxy_params=self._waveform_proxy_params,
                 should_sample_waveform=self._active_visualizer_requests_waveform,
+                tick_scheduler=self.tick_scheduler,
                 beat_service=self.beat_service,
                 beat_params=self._beat_params,
                 should_sample_beat=self._active_visualizer_requests_beat,
@@ -880,16 +942,18 @@ class TzPlayerApp(App):
             return
         if isinstance(event, PlayerStateChanged):
             self.player_state = event.state
+            analysis_io_budget().set_playback_active(event.state.status == "playing")
             if event.state.error:
                 self._set_runtime_notice(event.state.error, ttl_s=8.0)
-            playing_id = (
-                event.state.item_id
-                if event.state.status in {"playing", "paused"}
-                else None
-            )
-            pane.set_playing_item_id(playing_id)
-            self._update_status_pane()
-            await pane.update_transport_controls(self.player_state)
+            if event.touches(_PLAYING_ROW_FIELDS):
+                playing_id = (
+                    event.state.item_id
+                    if event.state.status in {"playing", "paused"}
+                    else None
+                )
+                pane.set_playing_item_id(playing_id)
+            self._update_status_pane(event.changed)
+            await pane.update_transport_controls(self.player_state, event.changed)
             if self._state_tuple(self.player_state) != self._last_persisted:
                 await self._schedule_state_save()
         elif isinstance(event, TrackChanged):
@@ -972,8 +1036,17 @@ class TzPlayerApp(App):
             return
         task = asyncio.create_task(self._ensure_spectrum_for_track(track_path, params))
         self._spectrum_analysis_tasks[key] = task
+        self.analysis_availability.mark_pending(
+            track_path, SqliteSpectrumStore.ANALYSIS_TYPE, params
+        )
         task.add_done_callback(
-            lambda _task: self._spectrum_analysis_tasks.pop(key, None)
+            self._make_analysis_task_cleanup(
+                self._spectrum_analysis_tasks,
+                key,
+                track_path,
+                SqliteSpectrumStore.ANALYSIS_TYPE,
+                params,
+            )
         )
 
     async def _ensure_spectrum_for_track(
@@ -983,7 +1056,9 @@ class TzPlayerApp(App):
             return
         path = Path(track_path)
         try:
-            if await self.spectrum_store.has_spectrum(path, params=params):
+            if await self._analysis_ready(
+                path, SqliteSpectrumStore.ANALYSIS_TYPE, params
+            ):
                 return
             await self._ensure_analysis_bundle_for_track(track_path)
         except Exception as exc:
@@ -1008,14 +1083,25 @@ class TzPlayerApp(App):
             return
         task = asyncio.create_task(self._ensure_beat_for_track(track_path, params))
         self._beat_analysis_tasks[key] = task
-        task.add_done_callback(lambda _task: self._beat_analysis_tasks.pop(key, None))
+        self.analysis_availability.mark_pending(
+            track_path, SqliteBeatStore.ANALYSIS_TYPE, params
+        )
+        task.add_done_callback(
+            self._make_analysis_task_cleanup(
+                self._beat_analysis_tasks,
+                key,
+                track_path,
+                SqliteBeatStore.ANALYSIS_TYPE,
+                params,
+            )
+        )
 
     async def _ensure_beat_for_track(self, track_path: str, params: BeatParams) -> None:
         if self.beat_store is None:
             return
         path = Path(track_path)
         try:
-            if await self.beat_store.has_beats(path, params=params):
+            if await self._analysis_ready(path, SqliteBeatStore.ANALYSIS_TYPE, params):
                 return
             await self._ensure_analysis_bundle_for_track(track_path)
         except Exception as exc:
@@ -1047,8 +1133,17 @@ class TzPlayerApp(App):
             self._ensure_waveform_proxy_for_track(track_path, params)
         )
         self._waveform_proxy_analysis_tasks[key] = task
+        self.analysis_availability.mark_pending(
+            track_path, SqliteWaveformProxyStore.ANALYSIS_TYPE, params
+        )
         task.add_done_callback(
-            lambda _task: self._waveform_proxy_analysis_tasks.pop(key, None)
+            self._make_analysis_task_cleanup(
+                self._waveform_proxy_analysis_tasks,
+                key,
+                track_path,
+                SqliteWaveformProxyStore.ANALYSIS_TYPE,
+                params,
+            )
         )
 
     async def _ensure_waveform_proxy_for_track(
@@ -1058,17 +1153,16 @@ class TzPlayerApp(App):
             return
         path = Path(track_path)
         try:
-            if await self.waveform_proxy_store.has_waveform_proxy(path, params=params):
+            if await self._analysis_ready(
+                path, SqliteWaveformProxyStore.ANALYSIS_TYPE, params
+            ):
                 return
             await self._ensure_analysis_bundle_for_track(track_path)
         except Exception as exc:
             logger.debug("Waveform proxy analysis failed for %s: %s", path, exc)
 
     async def _ensure_analysis_bundle_for_track(self, track_path: str) -> None:
-        key = (
-            f"{track_path}|spectrum={self._spectrum_params.band_count}/{self._spectrum_params.hop_ms}"
-            f"|beat={self._beat_params.hop_ms}|waveform={self._waveform_proxy_params.hop_ms}"
-        )
+        key = f"{track_path}|{self._analysis_bundle_params_token()}"
         existing = self._analysis_bundle_tasks.get(key)
         if existing is not None and not existing.done():
             await existing
@@ -1090,101 +1184,441 @@ class TzPlayerApp(App):
             return
 
         path = Path(track_path)
-        spectrum_missing = (
-            self.spectrum_store is not None
-            and not await self.spectrum_store.has_spectrum(
-                path, params=self._spectrum_params
-            )
-        )
-        beat_missing = (
-            self.beat_store is not None
-            and not await self.beat_store.has_beats(path, params=self._beat_params)
+        resume = await self._analysis_bundle_resume_points(path)
+        if resume is None:
+            return
+        leases = self.analysis_leases
+        if leases is None:
+            await self._analyze_bundle_segments(path, resume, None)
+            return
+        lease_key = await run_blocking(
+            analysis_lease_key, path, self._analysis_bundle_params_token()
         )
-        waveform_missing = (
-            self.waveform_proxy_store is not None
-            and not await self.waveform_proxy_store.has_waveform_proxy(
-                path, params=self._waveform_proxy_params
-            )
+        held = await leases.acquire(lease_key)
+        try:
+            while True:
+                if not held:
+                    waited = await self._wait_for_analysis_lease(
+                        leases, path, lease_key
+                    )
+                    if waited is None:
+                        return
+                    resume, held = waited
+                if await self._analyze_bundle_segments(
+                    path, resume, lease_key if held else None
+                ):
+                    return
+                # Another process took the lease over; wait on its result.
+                held = False
+        finally:
+            await leases.release(lease_key)
+
+    def _analysis_bundle_params_token(self) -> str:
+        return (
+            f"spectrum={self._spectrum_params.band_count}/{self._spectrum_params.hop_ms}"
+            f"|beat={self._beat_params.hop_ms}|waveform={self._waveform_proxy_params.hop_ms}"
         )
-        if not (spectrum_missing or beat_missing or waveform_missing):
-            return
 
-        semaphore = self._ensure_analysis_bundle_semaphore()
-        async with semaphore:
-            bundle = await run_cpu_bound(
-                analyze_track_analysis_bundle,
+    async def _analysis_bundle_resume_points(
+        self, path: Path
+    ) -> tuple[int | None, int | None, int | None] | None:
+        """Return per-kind resume points, or ``None`` when every kind is stored."""
+        resume = (
+            await self._analysis_resume_ms(
+                path, SqliteSpectrumStore.ANALYSIS_TYPE, self._spectrum_params
+            ),
+            await self._analysis_resume_ms(
+                path, SqliteBeatStore.ANALYSIS_TYPE, self._beat_params
+            ),
+            await self._analysis_resume_ms(
                 path,
-                spectrum_band_count=self._spectrum_params.band_count,
-                spectrum_hop_ms=self._spectrum_params.hop_ms,
-                beat_hop_ms=self._beat_params.hop_ms,
-                waveform_hop_ms=self._waveform_proxy_params.hop_ms,
-                include_spectrum=spectrum_missing,
-                include_beat=beat_missing,
-                include_waveform_proxy=waveform_missing,
-            )
-            if bundle is None:
-                return
+                SqliteWaveformProxyStore.ANALYSIS_TYPE,
+                self._waveform_proxy_params,
+            ),
+        )
+        if all(start is None for start in resume):
+            return None
+        return resume
 
-            wrote_any = False
-            if (
-                spectrum_missing
-                and self.spectrum_store is not None
-                and bundle.spectrum is not None
-                and bundle.spectrum.frames
-            ):
-                await self.spectrum_store.upsert_spectrum(
+    async def _wait_for_analysis_lease(
+        self, leases: SqliteAnalysisLeaseStore, path: Path, lease_key: str
+    ) -> tuple[tuple[int | None, int | None, int | None], bool] | None:
+        """Wait while another process analyzes ``path``.
+
+        Returns ``None`` once its result is cached, or fresh resume points plus
+        whether the lease is now held: it was released or went stale, or the
+        wait timed out and analysis proceeds without it.
+        """
+        logger.info(
+            "Waiting for another process to analyze %s",
+            path,
+            extra={"event": "analysis_lease_wait", "track": str(path)},
+        )
+        deadline = time.monotonic() + LEASE_WAIT_TIMEOUT_S
+        while True:
+            await asyncio.sleep(LEASE_POLL_S)
+            resume = await self._analysis_bundle_resume_points(path)
+            if resume is None:
+                if self.player_service is not None:
+                    await self.player_service.prime_analysis_memory_cache(str(path))
+                return None
+            if await leases.acquire(lease_key):
+                # The previous holder may have stored segments before stopping.
+                fresh = await self._analysis_bundle_resume_points(path)
+                return None if fresh is None else (fresh, True)
+            if time.monotonic() >= deadline:
+                logger.warning(
+                    "Timed out waiting for analysis lease on %s; analyzing locally",
                     path,
-                    duration_ms=max(1, bundle.spectrum.duration_ms),
-                    params=self._spectrum_params,
-                    frames=bundle.spectrum.frames,
+                    extra={"event": "analysis_lease_timeout", "track": str(path)},
                 )
-                wrote_any = True
-                logger.info(
-                    "Spectrum analyzed for %s (%d frames)",
-                    path,
-                    len(bundle.spectrum.frames),
+                return resume, False
+
+    async def _analyze_bundle_segments(
+        self,
+        path: Path,
+        resume: tuple[int | None, int | None, int | None],
+        lease_key: str | None,
+    ) -> bool:
+        """Analyze outstanding segments; ``False`` when the lease was lost."""
+        spectrum_from, beat_from, waveform_from = resume
+        resume_points = [
+            start
+            for start in (spectrum_from, beat_from, waveform_from)
+            if start is not None
+        ]
+        # Kinds that got further are redone from the earliest gap so each
+        # segment is written for every outstanding kind together.
+        segment_start_ms = min(resume_points)
+        spectrum_missing = spectrum_from is not None
+        beat_missing = beat_from is not None
+        waveform_missing = waveform_from is not None
+        segment_ms = analysis_segment_ms(
+            spectrum_hop_ms=self._spectrum_params.hop_ms,
+            beat_hop_ms=self._beat_params.hop_ms,
+            waveform_hop_ms=self._waveform_proxy_params.hop_ms,
+        )
+        # Resumed segments quantize against the scale the first segment stored.
+        spectrum_peak: float | None = None
+        beat_peak: float | None = None
+        if segment_start_ms > 0:
+            if spectrum_missing and self.spectrum_store is not None:
+                spectrum_peak = await self.spectrum_store.spectrum_norm_peak(
+                    path, params=self._spectrum_params
                 )
-            if (
-                beat_missing
-                and self.beat_store is not None
-                and bundle.beat is not None
-                and bundle.beat.frames
-            ):
-                await self.beat_store.upsert_beats(
+            if beat_missing and self.beat_store is not None:
+                beat_peak = await self.beat_store.beat_norm_peak(
+                    path, params=self._beat_params
+                )
+
+        wrote_any = False
+        lease_held = True
+        while spectrum_missing or beat_missing or waveform_missing:
+            semaphore = self._ensure_analysis_bundle_semaphore()
+            async with semaphore:
+                bundle = await run_cpu_bound(
+                    analyze_track_analysis_bundle,
                     path,
-                    duration_ms=max(1, bundle.beat.duration_ms),
-                    params=self._beat_params,
-                    bpm=bundle.beat.bpm,
-                    frames=bundle.beat.frames,
+                    spectrum_band_count=self._spectrum_params.band_count,
+                    spectrum_hop_ms=self._spectrum_params.hop_ms,
+                    beat_hop_ms=self._beat_params.hop_ms,
+                    waveform_hop_ms=self._waveform_proxy_params.hop_ms,
+                    include_spectrum=spectrum_missing,
+                    include_beat=beat_missing,
+                    include_waveform_proxy=waveform_missing,
+                    segment_start_ms=segment_start_ms,
+                    segment_ms=segment_ms,
+                    spectrum_peak=spectrum_peak,
+                    beat_peak=beat_peak,
                 )
-                wrote_any = True
-                logger.info(
-                    "Beat analysis completed for %s (%d frames)",
+                if bundle is None:
+                    if segment_start_ms > 0:
+                        # Nothing decodes past a boundary the track ended on.
+                        await self._complete_analysis_segments(
+                            path,
+                            spectrum=spectrum_missing,
+                            beat=beat_missing,
+                            waveform_proxy=waveform_missing,
+                        )
+                    else:
+                        self._mark_analysis_failed(
+                            path,
+                            spectrum=spectrum_missing,
+                            beat=beat_missing,
+                            waveform_proxy=waveform_missing,
+                        )
+                    break
+                (
+                    spectrum_written,
+                    beat_written,
+                    waveform_written,
+                ) = await self._store_analysis_segment(
                     path,
-                    len(bundle.beat.frames),
+                    bundle,
+                    segment_start_ms=segment_start_ms,
+                    spectrum=spectrum_missing,
+                    beat=beat_missing,
+                    waveform_proxy=waveform_missing,
                 )
+                if segment_start_ms > 0:
+                    # Too little audio remained to analyze: the track ended.
+                    await self._complete_analysis_segments(
+                        path,
+                        spectrum=spectrum_missing and not spectrum_written,
+                        beat=beat_missing and not beat_written,
+                        waveform_proxy=waveform_missing and not waveform_written,
+                    )
+                else:
+                    self._mark_analysis_failed(
+                        path,
+                        spectrum=spectrum_missing and not spectrum_written,
+                        beat=beat_missing and not beat_written,
+                        waveform_proxy=waveform_missing and not waveform_written,
+                    )
+                if spectrum_peak is None and bundle.spectrum is not None:
+                    spectrum_peak = bundle.spectrum.peak or None
+                if beat_peak is None and bundle.beat is not None:
+                    beat_peak = bundle.beat.peak or None
+                spectrum_missing = spectrum_written
+                beat_missing = beat_written
+                waveform_missing = waveform_written
+                written = spectrum_written or beat_written or waveform_written
+                if written and self.player_service is not None:
+                    await self.player_service.prime_analysis_memory_cache(
+                        str(path), segment_start_ms=segment_start_ms
+                    )
+            wrote_any = wrote_any or written
+            if bundle.segment_end_ms is None:
+                break
+            segment_start_ms = bundle.segment_end_ms
+            # Renew between segments so waiters never see a live lease as stale.
             if (
-                waveform_missing
-                and self.waveform_proxy_store is not None
-                and bundle.waveform_proxy is not None
-                and bundle.waveform_proxy.frames
+                lease_key is not None
+                and self.analysis_leases is not None
+                and not await self.analysis_leases.acquire(lease_key)
             ):
-                await self.waveform_proxy_store.upsert_waveform_proxy(
+                logger.info(
+                    "Analysis lease on %s was taken over; handing off",
                     path,
-                    duration_ms=max(1, bundle.waveform_proxy.duration_ms),
-                    params=self._waveform_proxy_params,
-                    frames=bundle.waveform_proxy.frames,
+                    extra={"event": "analysis_lease_lost", "track": str(path)},
                 )
-                wrote_any = True
-                logger.info(
-                    "Waveform proxy analyzed for %s (%d frames)",
+                lease_held = False
+                break
+        if wrote_any:
+            self._schedule_analysis_cache_prune(reason="post_write", delay_s=0.0)
+        return lease_held
+
+    async def _complete_analysis_segments(
+        self,
+        path: Path,
+        *,
+        spectrum: bool,
+        beat: bool,
+        waveform_proxy: bool,
+    ) -> None:
+        """Finish partial entries whose track ended on a segment boundary."""
+        availability = self.analysis_availability
+        if spectrum and self.spectrum_store is not None:
+            await self.spectrum_store.complete_spectrum(
+                path, params=self._spectrum_params
+            )
+            availability.mark_ready(
+                path, SqliteSpectrumStore.ANALYSIS_TYPE, self._spectrum_params
+            )
+        if beat and self.beat_store is not None:
+            await self.beat_store.complete_beats(path, params=self._beat_params)
+            availability.mark_ready(
+                path, SqliteBeatStore.ANALYSIS_TYPE, self._beat_params
+            )
+        if waveform_proxy and self.waveform_proxy_store is not None:
+            await self.waveform_proxy_store.complete_waveform_proxy(
+                path, params=self._waveform_proxy_params
+            )
+            availability.mark_ready(
+                path,
+                SqliteWaveformProxyStore.ANALYSIS_TYPE,
+                self._waveform_proxy_params,
+            )
+
+    async def _store_analysis_segment(
+        self,
+        path: Path,
+        bundle: AnalysisBundleResult,
+        *,
+        segment_start_ms: int,
+        spectrum: bool,
+        beat: bool,
+        waveform_proxy: bool,
+    ) -> tuple[bool, bool, bool]:
+        """Persist one analyzed segment; returns which kinds were written."""
+        covered_ms = bundle.segment_end_ms
+        # Whole-track results keep the plain upsert call; segments append.
+        segment_kwargs: dict[str, Any] = (
+            {}
+            if segment_start_ms == 0 and covered_ms is None
+            else {"segment_start_ms": segment_start_ms, "covered_ms": covered_ms}
+        )
+        availability = self.analysis_availability
+        spectrum_written = False
+        if (
+            spectrum
+            and self.spectrum_store is not None
+            and bundle.spectrum is not None
+            and bundle.spectrum.frames
+        ):
+            await self.spectrum_store.upsert_spectrum(
+                path,
+                duration_ms=max(1, bundle.spectrum.duration_ms),
+                params=self._spectrum_params,
+                frames=bundle.spectrum.frames,
+                **segment_kwargs,
+                **_first_segment_peak(segment_kwargs, bundle.spectrum.peak),
+            )
+            spectrum_written = True
+            if covered_ms is None:
+                availability.mark_ready(
+                    path, SqliteSpectrumStore.ANALYSIS_TYPE, self._spectrum_params
+                )
+            logger.info(
+                "Spectrum analyzed for %s (%d frames from %d ms)",
+                path,
+                len(bundle.spectrum.frames),
+                segment_start_ms,
+            )
+        beat_written = False
+        if (
+            beat
+            and self.beat_store is not None
+            and bundle.beat is not None
+            and bundle.beat.frames
+        ):
+            await self.beat_store.upsert_beats(
+                path,
+                duration_ms=max(1, bundle.beat.duration_ms),
+                params=self._beat_params,
+                bpm=bundle.beat.bpm,
+                frames=bundle.beat.frames,
+                **segment_kwargs,
+                **_first_segment_peak(segment_kwargs, bundle.beat.peak),
+            )
+            beat_written = True
+            if covered_ms is None:
+                availability.mark_ready(
+                    path, SqliteBeatStore.ANALYSIS_TYPE, self._beat_params
+                )
+            logger.info(
+                "Beat analysis completed for %s (%d frames from %d ms)",
+                path,
+                len(bundle.beat.frames),
+                segment_start_ms,
+            )
+        waveform_written = False
+        if (
+            waveform_proxy
+            and self.waveform_proxy_store is not None
+            and bundle.waveform_proxy is not None
+            and bundle.waveform_proxy.frames
+        ):
+            await self.waveform_proxy_store.upsert_waveform_proxy(
+                path,
+                duration_ms=max(1, bundle.waveform_proxy.duration_ms),
+                params=self._waveform_proxy_params,
+                frames=bundle.waveform_proxy.frames,
+                **segment_kwargs,
+            )
+            waveform_written = True
+            if covered_ms is None:
+                availability.mark_ready(
                     path,
-                    len(bundle.waveform_proxy.frames),
+                    SqliteWaveformProxyStore.ANALYSIS_TYPE,
+                    self._waveform_proxy_params,
                 )
-            if wrote_any and self.player_service is not None:
-                await self.player_service.prime_analysis_memory_cache(str(path))
-            if wrote_any:
-                self._schedule_analysis_cache_prune(reason="post_write", delay_s=0.0)
+            logger.info(
+                "Waveform proxy analyzed for %s (%d frames from %d ms)",
+                path,
+                len(bundle.waveform_proxy.frames),
+                segment_start_ms,
+            )
+        return spectrum_written, beat_written, waveform_written
+
+    async def _analysis_ready(
+        self, path: Path, analysis_type: str, params: Any
+    ) -> bool:
+        """Return whether analysis for the whole track is stored."""
+        return await self._analysis_resume_ms(path, analysis_type, params) is None
+
+    async def _analysis_resume_ms(
+        self, path: Path, analysis_type: str, params: Any
+    ) -> int | None:
+        """Return where analysis should resume, or ``None`` when nothing is left.
+
+        The availability index answers for complete tracks; otherwise the store
+        is asked whether an entry exists and how far a partial one reaches.
+        """
+        if self.analysis_availability.is_ready(path, analysis_type, params):
+            return None
+        covered_ms: int | None
+        if analysis_type == SqliteSpectrumStore.ANALYSIS_TYPE:
+            if self.spectrum_store is None:
+                return None
+            if not await self.spectrum_store.has_spectrum(path, params=params):
+                return 0
+            covered_ms = await self.spectrum_store.spectrum_resume_ms(
+                path, params=params
+            )
+        elif analysis_type == SqliteBeatStore.ANALYSIS_TYPE:
+            if self.beat_store is None:
+                return None
+            if not await self.beat_store.has_beats(path, params=params):
+                return 0
+            covered_ms = await self.beat_store.beat_resume_ms(path, params=params)
+        else:
+            if self.waveform_proxy_store is None:
+                return None
+            if not await self.waveform_proxy_store.has_waveform_proxy(
+                path, params=params
+            ):
+                return 0
+            covered_ms = await self.waveform_proxy_store.waveform_proxy_resume_ms(
+                path, params=params
+            )
+        if covered_ms is None:
+            self.analysis_availability.mark_ready(path, analysis_type, params)
+        return covered_ms
+
+    def _mark_analysis_failed(
+        self, path: Path, *, spectrum: bool, beat: bool, waveform_proxy: bool
+    ) -> None:
+        availability = self.analysis_availability
+        if spectrum:
+            availability.mark_failed(
+                path, SqliteSpectrumStore.ANALYSIS_TYPE, self._spectrum_params
+            )
+        if beat:
+            availability.mark_failed(
+                path, SqliteBeatStore.ANALYSIS_TYPE, self._beat_params
+            )
+        if waveform_proxy:
+            availability.mark_failed(
+                path,
+                SqliteWaveformProxyStore.ANALYSIS_TYPE,
+                self._waveform_proxy_params,
+            )
+
+    def _make_analysis_task_cleanup(
+        self,
+        tasks: dict[str, asyncio.Task[None]],
+        key: str,
+        track_path: str,
+        analysis_type: str,
+        params: Any,
+    ) -> Callable[[asyncio.Task[None]], None]:
+        def _cleanup(_task: asyncio.Task[None]) -> None:
+            tasks.pop(key, None)
+            # Tasks skipped by caps or dedupe leave no verdict; let sampling retry.
+            self.analysis_availability.clear_pending(track_path, analysis_type, params)
+
+        return _cleanup
 
     def _schedule_analysis_cache_prune(
         self,
@@ -1200,13 +1634,14 @@ class TzPlayerApp(App):
             and not self._analysis_cache_prune_task.done()
         ):
             return
-        self._analysis_cache_prune_task = asyncio.create_task(
-            self._run_analysis_cache_prune(
-                reason=reason,
-                delay_s=max(0.0, float(delay_s)),
-                force=force,
+        with executor_lane("background"):
+            self._analysis_cache_prune_task = asyncio.create_task(
+                self._run_analysis_cache_prune(
+                    reason=reason,
+                    delay_s=max(0.0, float(delay_s)),
+                    force=force,
+                )
             )
-        )
         self._analysis_cache_prune_task.add_done_callback(
             lambda _task: setattr(self, "_analysis_cache_prune_task", None)
         )
@@ -1245,6 +1680,8 @@ class TzPlayerApp(App):
                 "bytes_reclaimed": result.bytes_reclaimed,
             },
         )
+        if result.entries_pruned > 0:
+            self.analysis_availability.clear_ready()
 
     def _schedule_next_track_prewarm(self, *, force: bool = False) -> None:
         """Prewarm envelope data for the predicted next track while playing.
@@ -1277,9 +1714,10 @@ class TzPlayerApp(App):
             return
         self._cancel_next_track_prewarm()
         self._next_prewarm_context = context
-        self._next_prewarm_task = asyncio.create_task(
-            self._run_next_track_prewarm(context)
-        )
+        with executor_lane("background"):
+            self._next_prewarm_task = asyncio.create_task(
+                self._run_next_track_prewarm(context)
+            )
 
     def _cancel_next_track_prewarm(self) -> None:
         if self._next_prewarm_task is not None:
@@ -1382,35 +1820,35 @@ class TzPlayerApp(App):
     def _ensure_envelope_analysis_semaphore(self) -> asyncio.Semaphore:
         semaphore = self._envelope_analysis_semaphore
         if semaphore is None:
-            semaphore = asyncio.Semaphore(ANALYSIS_MAX_CONCURRENT_PER_TYPE)
+            semaphore = asyncio.Semaphore(self.state.analysis_concurrency)
             self._envelope_analysis_semaphore = semaphore
         return semaphore
 
     def _ensure_spectrum_analysis_semaphore(self) -> asyncio.Semaphore:
         semaphore = self._spectrum_analysis_semaphore
         if semaphore is None:
-            semaphore = asyncio.Semaphore(ANALYSIS_MAX_CONCURRENT_PER_TYPE)
+            semaphore = asyncio.Semaphore(self.state.analysis_concurrency)
             self._spectrum_analysis_semaphore = semaphore
         return semaphore
 
     def _ensure_beat_analysis_semaphore(self) -> asyncio.Semaphore:
         semaphore = self._beat_analysis_semaphore
         if semaphore is None:
-            semaphore = asyncio.Semaphore(ANALYSIS_MAX_CONCURRENT_PER_TYPE)
+            semaphore = asyncio.Semaphore(self.state.analysis_concurrency)
             self._beat_analysis_semaphore = semaphore
         return semaphore
 
     def _ensure_waveform_proxy_analysis_semaphore(self) -> asyncio.Semaphore:
         semaphore = self._waveform_proxy_analysis_semaphore
         if semaphore is None:
-            semaphore = asyncio.Semaphore(ANALYSIS_MAX_CONCURRENT_PER_TYPE)
+            semaphore = asyncio.Semaphore(self.state.analysis_concurrency)
             self._waveform_proxy_analysis_semaphore = semaphore
         return semaphore
 
     def _ensure_analysis_bundle_semaphore(self) -> asyncio.Semaphore:
         semaphore = self._analysis_bundle_semaphore
         if semaphore is None:
-            semaphore = asyncio.Semaphore(ANALYSIS_MAX_CONCURRENT_PER_TYPE)
+            semaphore = asyncio.Semaphore(self.state.analysis_concurrency)
             self._analysis_bundle_semaphore = semaphore
         return semaphore
 
@@ -1515,13 +1953,13 @@ class TzPlayerApp(App):
     async def _playlist_item_ids_provider(self, playlist_id: int) -> list[int]:
         return await self.store.list_item_ids(playlist_id)
 
-    def _update_status_pane(self) -> None:
+    def _update_status_pane(self, changed: frozenset[str] | None = None) -> None:
         try:
             pane = self.query_one(StatusPane)
         except NoMatches:
             return
         pane.set_runtime_notice(self._effective_runtime_notice())
-        pane.update_state(self.player_state)
+        pane.update_state(self.player_state, changed)
 
     def _update_current_track_pane(self) -> None:
         try:
@@ -1621,6 +2059,7 @@ class TzPlayerApp(App):
     def _schedule_visualizer_frame(self) -> None:
         if self.visualizer_host is None:
             return
+        self.tick_scheduler.record_wakeup("visualizer")
         if self._visualizer_render_task is not None:
             if not self._visualizer_render_task.done():
                 self._visualizer_render_pending = True
@@ -1664,47 +2103,14 @@ class TzPlayerApp(App):
             ansi_enabled=self.state.ansi_enabled,
             unicode_enabled=True,
         )
-        frame = VisualizerFrameInput(
+        frame = self._visualizer_frame_builder.build(
             frame_index=self.visualizer_host.frame_index,
             monotonic_s=time.monotonic(),
             width=max(1, pane.size.width),
             height=max(1, pane.size.height),
-            status=self.player_state.status,
-            position_s=max(0.0, self.player_state.position_ms / 1000.0),
-            duration_s=self.player_state.duration_ms / 1000.0
-            if self.player_state.duration_ms > 0
-            else None,
-            volume=float(self.player_state.volume),
-            speed=self.player_state.speed,
-            repeat_mode=self.player_state.repeat_mode,
-            shuffle=self.player_state.shuffle,
-            track_id=None,
-            track_path=self.current_track.path
-            if self.current_track is not None
-            else None,
-            title=self.current_track.title if self.current_track is not None else None,
-            artist=self.current_track.artist
-            if self.current_track is not None
-            else None,
-            album=self.current_track.album if self.current_track is not None else None,
-            level_left=self.player_state.level_left,
-            level_right=self.player_state.level_right,
-            level_source=self.player_state.level_source,
-            level_status=self.player_state.level_status,
-            spectrum_bands=self.player_state.spectrum_bands,
-            spectrum_source=self.player_state.spectrum_source,
-            spectrum_status=self.player_state.spectrum_status,
-            waveform_min_left=self.player_state.waveform_min_left,
-            waveform_max_left=self.player_state.waveform_max_left,
-            waveform_min_right=self.player_state.waveform_min_right,
-            waveform_max_right=self.player_state.waveform_max_right,
-            waveform_source=self.player_state.waveform_source,
-            waveform_status=self.player_state.waveform_status,
-            beat_strength=self.player_state.beat_strength,
-            beat_is_onset=self.player_state.beat_is_onset,
-            beat_bpm=self.player_state.beat_bpm,
-            beat_source=self.player_state.beat_source,
-            beat_status=self.player_state.beat_status,
+            state=self.player_state,
+            track=self.current_track,
+            spectrum_at=self._visualizer_spectrum_lookup(),
         )
         try:
             output = self.visualizer_host.render_frame(frame, context)
@@ -1744,6 +2150,15 @@ class TzPlayerApp(App):
             )
         self._adapt_visualizer_runtime_fps(elapsed_s=elapsed)
 
+    def _visualizer_spectrum_lookup(self) -> Callable[[int], bytes | None] | None:
+        service = self.spectrum_service
+        track = self.current_track
+        if service is None or track is None:
+            return None
+        if not self._active_visualizer_requests_spectrum():
+            return None
+        return partial(service.bands_at, track.path, params=self._spectrum_params)
+
     def _reset_visualizer_runtime_fps(self) -> None:
         self._visualizer_runtime_fps = max(2, min(30, int(self.state.visualizer_fps)))
         self._visualizer_overrun_streak = 0
@@ -1760,9 +2175,23 @@ class TzPlayerApp(App):
             self._visualizer_timer.stop()
             self._visualizer_timer = None
         self._visualizer_timer = self.set_interval(
-            1.0 / normalized, self._schedule_visualizer_frame
+            1.0 / self.tick_scheduler.render_fps(normalized),
+            self._schedule_visualizer_frame,
         )
 
+    def _on_tick_mode_changed(self) -> None:
+        # Re-arm the render timer at the rate the new idle/focus mode allows.
+        if self._visualizer_timer is not None:
+            self._apply_visualizer_timer_fps(self._visualizer_runtime_fps)
+
+    def on_app_blur(self, event: events.AppBlur) -> None:
+        del event
+        self.tick_scheduler.set_focused(False)
+
+    def on_app_focus(self, event: events.AppFocus) -> None:
+        del event
+        self.tick_scheduler.set_focused(True)
+
     def _adapt_visualizer_runtime_fps(self, *, elapsed_s: float) -> None:
         host = self.visualizer_host
         if host is None:
@@ -1996,6 +2425,13 @@ class TzPlayerApp(App):
         )
 
 
+def _first_segment_peak(segment_kwargs: dict[str, Any], peak: float) -> dict[str, Any]:
+    # Only a segmented first pass records the scale its continuations reuse.
+    if not segment_kwargs or segment_kwargs["segment_start_ms"] > 0 or peak <= 0.0:
+        return {}
+    return {"norm_peak": peak}
+
+
 def _format_time(position_ms: int) -> str:
     if position_ms <= 0:
         return "--:--"
@@ -2181,6 +2617,24 @@ def build_parser() -> argparse.ArgumentParser:
         choices=("in-process", "isolated"),
         help="Local plugin runtime mode.",
     )
+    parser.add_argument(
+        "--perf",
+        action="store_true",
+        help="With `doctor`: run a short performance self-check and recommend "
+        "a responsiveness profile, FPS and analysis concurrency.",
+    )
+    parser.add_argument(
+        "--profile-sample",
+        action="store_true",
+        help="Sample all thread stacks while running; writes collapsed stacks "
+        "for flamegraph tools under .local/perf_profiles/.",
+    )
+    parser.add_argument(
+        "--profile-sample-hz",
+        type=int,
+        default=DEFAULT_SAMPLE_HZ,
+        help=f"Stack sampling rate for --profile-sample (default {DEFAULT_SAMPLE_HZ}).",
+    )
     return parser
 
 
@@ -2198,7 +2652,9 @@ def main() -> int:
         )
         command = getattr(args, "command", "run")
         if command == "doctor":
-            report = run_doctor(args.backend or "vlc")
+            report = run_doctor(
+                args.backend or "vlc", perf=bool(getattr(args, "perf", False))
+            )
             print(render_report(report))
             return report.exit_code
         if command == "setup":
@@ -2227,7 +2683,20 @@ def main() -> int:
                 visualizer_plugin_runtime
             )
         app = TzPlayerApp(**cast(dict[str, Any], app_kwargs))
-        app.run()
+        sampler: StackSampler | None = None
+        if getattr(args, "profile_sample", False):
+            sampler = StackSampler(label="session", hz=args.profile_sample_hz)
+            sampler.start()
+        try:
+            app.run()
+        finally:
+            if sampler is not None:
+                artifact = sampler.stop()
+                print(
+                    f"Wrote {artifact.samples} stack samples to "
+                    f"{artifact.collapsed_path}",
+                    file=sys.stderr,
+                )
         return 1 if getattr(app, "startup_failed", False) else 0
     except Exception as exc:  # pragma: no cover - top-level safety net
         logging.getLogger(__name__).exception("Fatal startup error: %s", exc)
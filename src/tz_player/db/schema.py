@@ -10,7 +10,7 @@ import hashlib
 import json
 import sqlite3
 
-SCHEMA_VERSION = 7
+SCHEMA_VERSION = 8
 _SCALAR_DEFAULT_PARAMS_JSON = json.dumps(
     {"bucket_ms": 50}, sort_keys=True, separators=(",", ":")
 )
@@ -107,6 +107,10 @@ def create_schema(conn: sqlite3.Connection) -> None:
         version = 6
     if version == 6:
         _migrate_v6_to_v7(conn)
+        conn.execute("PRAGMA user_version = 7")
+        version = 7
+    if version == 7:
+        _migrate_v7_to_v8(conn)
         conn.execute(f"PRAGMA user_version = {SCHEMA_VERSION}")
 
 
@@ -150,44 +154,19 @@ def _migrate_v1_to_v2(conn: sqlite3.Connection) -> None:
 
 
 def _migrate_v2_to_v3(conn: sqlite3.Connection) -> None:
-    """Add envelope-analysis cache tables used by audio level services."""
-    _begin_immediate(conn)
-    conn.execute(
-        """
-        CREATE TABLE IF NOT EXISTS audio_envelopes (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            path_norm TEXT NOT NULL UNIQUE,
-            mtime_ns INTEGER,
-            size_bytes INTEGER,
-            duration_ms INTEGER NOT NULL,
-            analysis_version INTEGER NOT NULL,
-            computed_at INTEGER NOT NULL DEFAULT (strftime('%s','now'))
-        )
-        """
-    )
-    conn.execute(
-        """
-        CREATE TABLE IF NOT EXISTS audio_envelope_points (
-            envelope_id INTEGER NOT NULL,
-            position_ms INTEGER NOT NULL,
-            level_left REAL NOT NULL,
-            level_right REAL NOT NULL,
-            PRIMARY KEY (envelope_id, position_ms),
-            FOREIGN KEY(envelope_id) REFERENCES audio_envelopes(id) ON DELETE CASCADE
-        )
-        """
-    )
-    conn.execute(
-        "CREATE INDEX IF NOT EXISTS idx_audio_envelopes_path_norm ON audio_envelopes(path_norm)"
-    )
-    conn.execute(
-        "CREATE INDEX IF NOT EXISTS idx_audio_points_envelope_pos ON audio_envelope_points(envelope_id, position_ms)"
-    )
+    """Former envelope-cache step; analysis tables now live in the cache DB.
+
+    Kept as a no-op so version numbering stays sequential. Libraries that already
+    created these tables are migrated below and emptied into the cache DB by
+    `import_legacy_analysis_cache`.
+    """
 
 
 def _migrate_v3_to_v4(conn: sqlite3.Connection) -> None:
     """Add generic analysis cache and FFT spectrum frame storage tables."""
     _begin_immediate(conn)
+    if not _table_exists(conn, "audio_envelopes"):
+        return
     conn.execute(
         """
         CREATE TABLE IF NOT EXISTS analysis_cache_entries (
@@ -329,6 +308,8 @@ def _migrate_v4_to_v5(conn: sqlite3.Connection) -> None:
 def _migrate_v5_to_v6(conn: sqlite3.Connection) -> None:
     """Add beat-analysis cache table for lazy beat/onset reads."""
     _begin_immediate(conn)
+    if not _table_exists(conn, "analysis_cache_entries"):
+        return
     conn.execute(
         """
         CREATE TABLE IF NOT EXISTS analysis_beat_frames (
@@ -351,6 +332,8 @@ def _migrate_v5_to_v6(conn: sqlite3.Connection) -> None:
 def _migrate_v6_to_v7(conn: sqlite3.Connection) -> None:
     """Add waveform-proxy cache table for PCM-like min/max envelope frames."""
     _begin_immediate(conn)
+    if not _table_exists(conn, "analysis_cache_entries"):
+        return
     conn.execute(
         """
         CREATE TABLE IF NOT EXISTS analysis_waveform_proxy_frames (
@@ -371,6 +354,45 @@ def _migrate_v6_to_v7(conn: sqlite3.Connection) -> None:
     )
 
 
+def _migrate_v7_to_v8(conn: sqlite3.Connection) -> None:
+    """Add content keys so analysis entries survive relocation and duplicates."""
+    _begin_immediate(conn)
+    if not _table_exists(conn, "analysis_cache_entries"):
+        return
+    if not _column_exists(conn, "analysis_cache_entries", "content_key"):
+        conn.execute("ALTER TABLE analysis_cache_entries ADD COLUMN content_key TEXT")
+    conn.execute(
+        "CREATE INDEX IF NOT EXISTS idx_analysis_cache_content ON analysis_cache_entries(analysis_type, content_key, analysis_version, params_hash)"
+    )
+
+
+_PLAYLIST_SEARCH_TRIGGERS = (
+    "trg_playlist_search_item_insert",
+    "trg_playlist_search_item_update",
+    "trg_playlist_search_item_delete",
+    "trg_playlist_search_track_path_update",
+    "trg_playlist_search_track_meta_insert",
+    "trg_playlist_search_track_meta_update",
+    "trg_playlist_search_track_meta_delete",
+)
+
+
+def drop_playlist_search(conn: sqlite3.Connection) -> None:
+    """Drop the FTS search table and its maintenance triggers.
+
+    Bulk deletes drop the index first so rows are not removed from FTS one
+    trigger at a time; `rebuild_playlist_search` restores it afterwards.
+    """
+    for trigger in _PLAYLIST_SEARCH_TRIGGERS:
+        conn.execute(f"DROP TRIGGER IF EXISTS {trigger}")
+    conn.execute("DROP TABLE IF EXISTS playlist_search")
+
+
+def rebuild_playlist_search(conn: sqlite3.Connection) -> bool:
+    """Recreate and backfill FTS search from current playlist rows."""
+    return _create_playlist_search_fts(conn)
+
+
 def _create_playlist_search_fts(conn: sqlite3.Connection) -> bool:
     """Create and backfill FTS playlist search structures when FTS5 is available."""
     if not _table_exists(conn, "tracks") or not _table_exists(conn, "playlist_items"):
@@ -707,3 +729,8 @@ def _table_exists(conn: sqlite3.Connection, table_name: str) -> bool:
         (table_name,),
     ).fetchone()
     return row is not None
+
+
+def _column_exists(conn: sqlite3.Connection, table_name: str, column_name: str) -> bool:
+    rows = conn.execute(f"PRAGMA table_info({table_name})").fetchall()
+    return any(str(row[1]) == column_name for row in rows)
@@ -1,18 +1,62 @@
-"""Runtime diagnostics for external tooling and backend readiness."""
+"""Runtime diagnostics for external tooling and backend readiness.
+
+`run_doctor(..., perf=True)` adds a short performance self-check: it times
+analysis of a synthetic track (native helper when configured), SQLite reads
+and commits next to the library database, and frames of the slowest built-in
+visualizer, then recommends a responsiveness profile, FPS and analysis
+concurrency for this machine.
+"""
 
 from __future__ import annotations
 
+import contextlib
 import importlib
+import logging
+import math
 import os
 import shutil
+import sqlite3
+import statistics
 import subprocess
-from dataclasses import dataclass
+import tempfile
+import time
+import wave
+from collections.abc import Iterator
+from dataclasses import dataclass, field
+from pathlib import Path
 from typing import Literal
 
+from .runtime_config import profile_default_visualizer_fps
+
+logger = logging.getLogger(__name__)
+
 DoctorStatus = Literal["ok", "missing", "error"]
 
 MEDIA_SETUP_URL = "docs/media-setup.md"
 
+PERF_SYNTHETIC_TRACK_S = 20.0
+PERF_SQLITE_ITERATIONS = 20
+PERF_VISUALIZER_FRAMES = 8
+PERF_VISUALIZER_PANE = (120, 36)
+# A visualizer frame may use this share of the frame interval; the rest is
+# left for Textual layout, polling and the playback backend.
+PERF_FRAME_BUDGET_SHARE = 0.5
+# Upper bounds (analysis ms per second of audio, SQLite read p95 ms, SQLite
+# commit p95 ms) a machine must meet for each profile beyond "safe".
+PERF_PROFILE_LIMITS: dict[str, tuple[float, float, float]] = {
+    "aggressive": (25.0, 10.0, 25.0),
+    "balanced": (250.0, 40.0, 100.0),
+}
+_PLAYLIST_PAGE_SQL = """
+    SELECT t.id, t.path, m.title, m.artist, m.duration_ms
+    FROM playlist_items AS pi
+    JOIN tracks AS t ON t.id = pi.track_id
+    LEFT JOIN track_meta AS m ON m.track_id = t.id
+    WHERE pi.playlist_id = (SELECT MIN(id) FROM playlists)
+    ORDER BY pi.pos_key
+    LIMIT 100
+"""
+
 
 @dataclass(frozen=True)
 class DoctorCheck:
@@ -25,12 +69,44 @@ class DoctorCheck:
     hint: str | None = None
 
 
+@dataclass(frozen=True)
+class PerfProbe:
+    """One timed performance probe; ``values`` are milliseconds."""
+
+    name: str
+    status: DoctorStatus
+    detail: str
+    values: dict[str, float] = field(default_factory=dict)
+
+
+@dataclass(frozen=True)
+class PerfRecommendation:
+    """Settings suggested from perf probe results."""
+
+    profile: str
+    visualizer_fps: int
+    analysis_concurrency: int
+    reasons: list[str]
+
+
+@dataclass(frozen=True)
+class PerfSelfCheck:
+    """Perf probe results plus derived recommendation."""
+
+    probes: list[PerfProbe]
+    recommendation: PerfRecommendation
+
+
 @dataclass(frozen=True)
 class DoctorReport:
-    """Collection of doctor checks and derived process exit contract."""
+    """Collection of doctor checks and derived process exit contract.
+
+    Perf results are advisory and never affect ``exit_code``.
+    """
 
     backend: str
     checks: list[DoctorCheck]
+    perf: PerfSelfCheck | None = None
 
     @property
     def exit_code(self) -> int:
@@ -41,14 +117,15 @@ class DoctorReport:
         return 0
 
 
-def run_doctor(backend: str) -> DoctorReport:
+def run_doctor(backend: str, *, perf: bool = False) -> DoctorReport:
     """Run configured diagnostics for selected backend mode."""
     checks = [
         probe_tinytag(),
         probe_vlc(required=backend == "vlc"),
         probe_ffmpeg(required=False),
     ]
-    return DoctorReport(backend=backend, checks=checks)
+    perf_check = run_perf_self_check() if perf else None
+    return DoctorReport(backend=backend, checks=checks, perf=perf_check)
 
 
 def render_report(report: DoctorReport) -> str:
@@ -60,6 +137,9 @@ def render_report(report: DoctorReport) -> str:
         lines.append(f"{state} {check.name:<11} [{req}] {check.detail}")
         if check.hint:
             lines.append(f"      hint: {check.hint}")
+    if report.perf is not None:
+        lines.append("")
+        lines.extend(_render_perf_lines(report.perf))
     lines.append("")
     if report.exit_code == 0:
         lines.append("Result: OK")
@@ -183,6 +263,374 @@ def probe_ffmpeg(*, required: bool) -> DoctorCheck:
     return DoctorCheck(name="ffmpeg", status="ok", required=required, detail=detail)
 
 
+def run_perf_self_check(
+    *,
+    db_file: Path | None = None,
+    state_file: Path | None = None,
+    cpu_count: int | None = None,
+    track_seconds: float = PERF_SYNTHETIC_TRACK_S,
+) -> PerfSelfCheck:
+    """Run perf probes and derive a profile/FPS/concurrency recommendation."""
+    from .state_store import load_state
+
+    if db_file is None:
+        from .paths import db_path
+
+        db_file = db_path()
+    if state_file is None:
+        from .paths import state_path
+
+        state_file = state_path()
+    state = load_state(state_file)
+    with tempfile.TemporaryDirectory(prefix="tz-player-doctor-") as tmp:
+        analysis = probe_analysis_perf(
+            Path(tmp),
+            track_seconds=track_seconds,
+            helper_enabled=state.native_helper_enabled,
+            helper_timeout_s=state.native_helper_timeout_s,
+        )
+    probes = [
+        analysis,
+        probe_sqlite_perf(db_file),
+        probe_visualizer_perf(),
+    ]
+    values = {key: value for probe in probes for key, value in probe.values.items()}
+    recommendation = recommend_perf_settings(
+        analysis_ms_per_audio_s=values.get("analysis_ms_per_audio_s"),
+        db_read_p95_ms=values.get("read_p95_ms"),
+        db_write_p95_ms=values.get("commit_p95_ms"),
+        visualizer_p95_ms=values.get("render_p95_ms"),
+        cpu_count=os.cpu_count() if cpu_count is None else cpu_count,
+    )
+    logger.info(
+        "Doctor perf self-check finished",
+        extra={
+            "event": "doctor_perf_self_check",
+            "probes": {probe.name: probe.values for probe in probes},
+            "recommended_profile": recommendation.profile,
+            "recommended_visualizer_fps": recommendation.visualizer_fps,
+            "recommended_analysis_concurrency": recommendation.analysis_concurrency,
+        },
+    )
+    return PerfSelfCheck(probes=probes, recommendation=recommendation)
+
+
+def probe_analysis_perf(
+    work_dir: Path,
+    *,
+    track_seconds: float = PERF_SYNTHETIC_TRACK_S,
+    helper_enabled: bool = True,
+    helper_timeout_s: float = 30.0,
+) -> PerfProbe:
+    """Time a full analysis bundle of a synthetic WAV track.
+
+    Applies the native helper settings the app would (saved state, unless env
+    vars override them) for the duration of the probe only, so the timing
+    reflects the backend this machine actually uses.
+    """
+    from .services.audio_analysis_bundle import analyze_track_analysis_bundle
+
+    track = work_dir / "doctor-synthetic.wav"
+    _write_synthetic_wav(track, seconds=track_seconds)
+    started = time.perf_counter()
+    try:
+        with _native_helper_env(enabled=helper_enabled, timeout_s=helper_timeout_s):
+            bundle = analyze_track_analysis_bundle(
+                track,
+                spectrum_band_count=48,
+                spectrum_hop_ms=32,
+                beat_hop_ms=32,
+                waveform_hop_ms=20,
+            )
+    except Exception as exc:
+        return PerfProbe(
+            name="analysis",
+            status="error",
+            detail=f"analysis failed ({exc.__class__.__name__})",
+        )
+    elapsed_ms = (time.perf_counter() - started) * 1000.0
+    if bundle is None:
+        return PerfProbe(
+            name="analysis", status="error", detail="analysis produced no output"
+        )
+    info = bundle.backend_info
+    backend = info.analysis_backend if info is not None else "unknown"
+    detail = f"{elapsed_ms:.0f} ms for {track_seconds:g}s of audio ({backend})"
+    if info is not None and info.fallback_reason:
+        detail += f"; helper fallback: {info.fallback_reason}"
+    return PerfProbe(
+        name="analysis",
+        status="ok",
+        detail=detail,
+        values={
+            "analysis_total_ms": round(elapsed_ms, 3),
+            "analysis_ms_per_audio_s": round(elapsed_ms / track_seconds, 3),
+        },
+    )
+
+
+@contextlib.contextmanager
+def _native_helper_env(*, enabled: bool, timeout_s: float) -> Iterator[None]:
+    """Apply helper settings to ``os.environ`` and restore it afterwards."""
+    from .services.audio_spectrum_native_cli import (
+        NATIVE_SPECTRUM_HELPER_TIMEOUT_ENV,
+        NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV,
+        apply_native_helper_env,
+    )
+
+    keys = (NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV, NATIVE_SPECTRUM_HELPER_TIMEOUT_ENV)
+    saved = {key: os.environ.get(key) for key in keys}
+    apply_native_helper_env(enabled=enabled, timeout_s=timeout_s)
+    try:
+        yield
+    finally:
+        for key, value in saved.items():
+            if value is None:
+                os.environ.pop(key, None)
+            else:
+                os.environ[key] = value
+
+
+def probe_sqlite_perf(
+    db_file: Path, *, iterations: int = PERF_SQLITE_ITERATIONS
+) -> PerfProbe:
+    """Time playlist page reads on the library DB and commits beside it.
+
+    The library database is opened read-only; commits go to a scratch file in
+    the same directory (same filesystem and pragmas) that is removed again.
+    """
+    read_ms: list[float] = []
+    commit_ms: list[float] = []
+    scratch = db_file.parent / f".tz-player-doctor-{os.getpid()}.sqlite"
+    try:
+        db_file.parent.mkdir(parents=True, exist_ok=True)
+        with sqlite3.connect(scratch, timeout=10) as conn:
+            conn.execute("PRAGMA journal_mode=WAL")
+            conn.execute("PRAGMA synchronous=NORMAL")
+            conn.execute("CREATE TABLE probe (id INTEGER PRIMARY KEY, payload TEXT)")
+            for idx in range(iterations):
+                started = time.perf_counter()
+                conn.execute("INSERT INTO probe (payload) VALUES (?)", (f"{idx:08d}",))
+                conn.commit()
+                commit_ms.append((time.perf_counter() - started) * 1000.0)
+            if not db_file.exists():
+                for _ in range(iterations):
+                    started = time.perf_counter()
+                    conn.execute("SELECT * FROM probe ORDER BY id LIMIT 100").fetchall()
+                    read_ms.append((time.perf_counter() - started) * 1000.0)
+        if db_file.exists():
+            uri = f"{db_file.resolve().as_uri()}?mode=ro"
+            with sqlite3.connect(uri, uri=True, timeout=10) as conn:
+                for _ in range(iterations):
+                    started = time.perf_counter()
+                    conn.execute(_PLAYLIST_PAGE_SQL).fetchall()
+                    read_ms.append((time.perf_counter() - started) * 1000.0)
+    except sqlite3.Error as exc:
+        return PerfProbe(
+            name="sqlite",
+            status="error",
+            detail=f"{db_file.parent}: {exc.__class__.__name__}: {exc}",
+        )
+    finally:
+        for suffix in ("", "-wal", "-shm", "-journal"):
+            Path(f"{scratch}{suffix}").unlink(missing_ok=True)
+    values = {
+        "read_median_ms": round(statistics.median(read_ms), 3),
+        "read_p95_ms": round(_p95(read_ms), 3),
+        "commit_median_ms": round(statistics.median(commit_ms), 3),
+        "commit_p95_ms": round(_p95(commit_ms), 3),
+    }
+    source = "library" if db_file.exists() else "scratch DB, no library yet"
+    return PerfProbe(
+        name="sqlite",
+        status="ok",
+        detail=(
+            f"read p95 {values['read_p95_ms']:.2f} ms ({source}), "
+            f"commit p95 {values['commit_p95_ms']:.2f} ms in {db_file.parent}"
+        ),
+        values=values,
+    )
+
+
+def probe_visualizer_perf(*, frames: int = PERF_VISUALIZER_FRAMES) -> PerfProbe:
+    """Render every built-in visualizer and report the slowest one."""
+    from .visualizers.base import VisualizerContext, VisualizerFrameInput
+    from .visualizers.registry import VisualizerRegistry
+
+    registry = VisualizerRegistry.built_in()
+    context = VisualizerContext(ansi_enabled=True, unicode_enabled=True)
+    width, height = PERF_VISUALIZER_PANE
+    spectrum = bytes((idx * 37) % 256 for idx in range(48))
+    slowest: tuple[float, float, str] | None = None
+    for plugin_id in registry.plugin_ids():
+        plugin = registry.create(plugin_id)
+        if plugin is None:
+            continue
+        samples: list[float] = []
+        try:
+            plugin.on_activate(context)
+            # Two warm-up frames let plugins build caches before timing.
+            for frame_idx in range(frames + 2):
+                frame = VisualizerFrameInput(
+                    frame_index=frame_idx,
+                    monotonic_s=frame_idx / 14.0,
+                    width=width,
+                    height=height,
+                    status="playing",
+                    position_s=frame_idx * 0.07,
+                    duration_s=240.0,
+                    volume=70.0,
+                    speed=1.0,
+                    repeat_mode="OFF",
+                    shuffle=False,
+                    track_id=1,
+                    track_path=None,
+                    title="Doctor",
+                    artist="tz-player",
+                    album=None,
+                    level_left=0.6,
+                    level_right=0.55,
+                    spectrum_bands=spectrum,
+                    spectrum_source="cache",
+                    spectrum_status="ready",
+                    waveform_min_left=-0.5,
+                    waveform_max_left=0.5,
+                    waveform_min_right=-0.45,
+                    waveform_max_right=0.45,
+                    waveform_source="cache",
+                    waveform_status="ready",
+                    beat_strength=0.8 if frame_idx % 4 == 0 else 0.2,
+                    beat_is_onset=frame_idx % 4 == 0,
+                    beat_bpm=124.0,
+                    beat_source="cache",
+                    beat_status="ready",
+                )
+                started = time.perf_counter()
+                plugin.render(frame)
+                if frame_idx >= 2:
+                    samples.append((time.perf_counter() - started) * 1000.0)
+        except Exception:
+            logger.debug("Doctor skipped visualizer %s", plugin_id, exc_info=True)
+            continue
+        finally:
+            with contextlib.suppress(Exception):
+                plugin.on_deactivate()
+        p95 = _p95(samples)
+        if slowest is None or p95 > slowest[0]:
+            slowest = (p95, statistics.median(samples), plugin_id)
+    if slowest is None:
+        return PerfProbe(
+            name="visualizer", status="error", detail="no visualizer rendered"
+        )
+    p95, median, plugin_id = slowest
+    return PerfProbe(
+        name="visualizer",
+        status="ok",
+        detail=(
+            f"slowest {plugin_id}: median {median:.2f} ms, p95 {p95:.2f} ms "
+            f"at {width}x{height}"
+        ),
+        values={"render_median_ms": round(median, 3), "render_p95_ms": round(p95, 3)},
+    )
+
+
+def recommend_perf_settings(
+    *,
+    analysis_ms_per_audio_s: float | None,
+    db_read_p95_ms: float | None,
+    db_write_p95_ms: float | None,
+    visualizer_p95_ms: float | None,
+    cpu_count: int | None,
+) -> PerfRecommendation:
+    """Pick the most responsive profile whose budgets the probes fit.
+
+    Failed probes (``None``) count as not meeting any budget.
+    """
+    reasons: list[str] = []
+    profile = "safe"
+    for candidate in ("aggressive", "balanced"):
+        analysis_max, read_max, write_max = PERF_PROFILE_LIMITS[candidate]
+        frame_max = (
+            1000.0 / profile_default_visualizer_fps(candidate) * PERF_FRAME_BUDGET_SHARE
+        )
+        misses = [
+            label
+            for label, value, limit in (
+                ("analysis", analysis_ms_per_audio_s, analysis_max),
+                ("sqlite read", db_read_p95_ms, read_max),
+                ("sqlite commit", db_write_p95_ms, write_max),
+                ("visualizer frame", visualizer_p95_ms, frame_max),
+            )
+            if value is None or value > limit
+        ]
+        if not misses:
+            profile = candidate
+            break
+        reasons.append(f"not {candidate}: {', '.join(misses)} over budget")
+    fps = profile_default_visualizer_fps(profile)
+    if visualizer_p95_ms is not None and visualizer_p95_ms > 0:
+        fitting_fps = math.floor(1000.0 * PERF_FRAME_BUDGET_SHARE / visualizer_p95_ms)
+        if fitting_fps < fps:
+            fps = max(2, fitting_fps)
+            reasons.append(f"fps capped at {fps} by slowest visualizer")
+    # Leave cores for the UI thread and playback; slow analysis per job means
+    # parallel jobs only add contention.
+    cores = max(1, cpu_count or 2)
+    concurrency = max(1, min(4, cores // 2))
+    if profile == "safe":
+        concurrency = 1
+    elif profile == "balanced":
+        concurrency = min(concurrency, 2)
+    return PerfRecommendation(
+        profile=profile,
+        visualizer_fps=fps,
+        analysis_concurrency=concurrency,
+        reasons=reasons,
+    )
+
+
+def _render_perf_lines(perf: PerfSelfCheck) -> list[str]:
+    lines = ["Performance self-check"]
+    for probe in perf.probes:
+        lines.append(f"{_status_token(probe.status)} {probe.name:<11} {probe.detail}")
+    rec = perf.recommendation
+    lines.append(
+        f"Recommended: --visualizer-responsiveness {rec.profile} "
+        f"--visualizer-fps {rec.visualizer_fps}; "
+        f"analysis_concurrency={rec.analysis_concurrency} in state.json"
+    )
+    for reason in rec.reasons:
+        lines.append(f"      note: {reason}")
+    return lines
+
+
+def _p95(samples: list[float]) -> float:
+    ordered = sorted(samples)
+    return ordered[min(len(ordered) - 1, math.ceil(0.95 * len(ordered)) - 1)]
+
+
+def _write_synthetic_wav(path: Path, *, seconds: float, rate: int = 44_100) -> None:
+    """Write a stereo 16-bit tone with periodic clicks for beat detection."""
+    frame_count = int(seconds * rate)
+    samples = bytearray()
+    for idx in range(frame_count):
+        t = idx / rate
+        value = 0.3 * math.sin(2 * math.pi * 220.0 * t) + 0.2 * math.sin(
+            2 * math.pi * 1760.0 * t
+        )
+        if idx % (rate // 2) < 200:
+            value += 0.4
+        sample = int(max(-1.0, min(1.0, value)) * 32767).to_bytes(
+            2, "little", signed=True
+        )
+        samples += sample + sample
+    with wave.open(str(path), "wb") as handle:
+        handle.setnchannels(2)
+        handle.setsampwidth(2)
+        handle.setframerate(rate)
+        handle.writeframes(bytes(samples))
+
+
 def _status_token(status: DoctorStatus) -> str:
     """Map doctor status to compact display token."""
     if status == "ok":
@@ -17,9 +17,19 @@ if TYPE_CHECKING:
 
 @dataclass(frozen=True)
 class PlayerStateChanged:
-    """Service event emitted when the effective player state changes."""
+    """Service event emitted when the effective player state changes.
+
+    ``changed`` names the `PlayerState` fields that differ from the previously
+    emitted state; ``None`` means unknown, so subscribers treat every field as
+    changed.
+    """
 
     state: PlayerState
+    changed: frozenset[str] | None = None
+
+    def touches(self, fields: frozenset[str]) -> bool:
+        """Return whether any of ``fields`` changed in this event."""
+        return self.changed is None or not self.changed.isdisjoint(fields)
 
 
 @dataclass(frozen=True)
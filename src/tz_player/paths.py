@@ -46,6 +46,11 @@ def db_path(app_name: str = DEFAULT_APP_NAME) -> Path:
     return data_dir(app_name) / "tz-player.sqlite"
 
 
+def analysis_cache_db_path(app_name: str = DEFAULT_APP_NAME) -> Path:
+    """Return the SQLite database path for rebuildable analysis cache data."""
+    return data_dir(app_name) / "tz-player-analysis.sqlite"
+
+
 def state_path(app_name: str = DEFAULT_APP_NAME) -> Path:
     """Return the JSON state file path."""
     return config_dir(app_name) / "state.json"
@@ -2,6 +2,9 @@
 
 This module defines a stable, JSON-serializable contract for opt-in benchmark
 results so future perf scenarios can be compared across commits/branches.
+`compare_perf_run_payloads` diffs one run against another; with repeated
+runs per side, `compare_perf_run_groups` tests each metric's per-run medians
+for significance so run-to-run jitter is reported as "within noise".
 """
 
 from __future__ import annotations
@@ -9,10 +12,12 @@ from __future__ import annotations
 import json
 import math
 import os
+import random
 import statistics
 from collections.abc import Mapping
 from dataclasses import asdict, dataclass, field
 from datetime import datetime, timezone
+from fnmatch import fnmatchcase
 from importlib import import_module
 from pathlib import Path
 
@@ -23,6 +28,9 @@ PERF_MEDIA_DIR_ENV = "TZ_PLAYER_PERF_MEDIA_DIR"
 PERF_RESULTS_DIR_ENV = "TZ_PLAYER_PERF_RESULTS_DIR"
 DEFAULT_LOCAL_PERF_MEDIA_DIR = Path(".local/perf_media")
 DEFAULT_LOCAL_PERF_RESULTS_DIR = Path(".local/perf_results")
+PERF_SUITE_SUMMARY_SCHEMA = "tz_player.perf_run_suite_summary.v1"
+SIGNIFICANCE_ALPHA = 0.05
+BOOTSTRAP_ITERATIONS = 2000
 PERF_MEDIA_AUDIO_SUFFIXES = frozenset(
     {".mp3", ".flac", ".wav", ".ogg", ".m4a", ".aac", ".opus", ".wma"}
 )
@@ -429,6 +437,286 @@ def compare_perf_run_payloads(
     )
 
 
+VERDICT_REGRESSED = "regressed"
+VERDICT_IMPROVED = "improved"
+VERDICT_WITHIN_NOISE = "within_noise"
+VERDICT_INSUFFICIENT_DATA = "insufficient_data"
+
+
+@dataclass(frozen=True)
+class PerfMetricSignificance:
+    """Repeated-run comparison of one metric.
+
+    Observations are per-run medians. ``pct_median`` compares the median of
+    those observations; the CI bounds are a bootstrap 95% interval for that
+    percentage, and ``p_value`` is a two-sided Mann-Whitney U test.
+    """
+
+    scenario_id: str
+    metric_name: str
+    unit: str
+    baseline_values: tuple[float, ...]
+    candidate_values: tuple[float, ...]
+    baseline_median: float
+    candidate_median: float
+    pct_median: float | None
+    ci_low_pct: float | None
+    ci_high_pct: float | None
+    p_value: float | None
+    regression_pct_threshold: float
+    verdict: str
+
+
+@dataclass(frozen=True)
+class PerfSignificanceResult:
+    """Per-metric verdicts for repeated baseline vs candidate runs."""
+
+    baseline_run_ids: list[str]
+    candidate_run_ids: list[str]
+    alpha: float
+    metrics: list[PerfMetricSignificance]
+    missing_in_candidate: list[str]
+    new_in_candidate: list[str]
+
+    def with_verdict(self, verdict: str) -> list[PerfMetricSignificance]:
+        return [metric for metric in self.metrics if metric.verdict == verdict]
+
+    @property
+    def regressed_metrics(self) -> list[PerfMetricSignificance]:
+        return self.with_verdict(VERDICT_REGRESSED)
+
+    @property
+    def improved_metrics(self) -> list[PerfMetricSignificance]:
+        return self.with_verdict(VERDICT_IMPROVED)
+
+
+def mann_whitney_u_p_value(x: list[float], y: list[float]) -> float:
+    """Return the two-sided Mann-Whitney U p-value for samples ``x`` and ``y``.
+
+    Uses the exact U distribution for small tie-free samples and the
+    tie-corrected normal approximation otherwise.
+    """
+    n1 = len(x)
+    n2 = len(y)
+    if n1 == 0 or n2 == 0:
+        raise ValueError("samples must not be empty")
+    combined = sorted(
+        (value, side) for side, values in enumerate((x, y)) for value in values
+    )
+    ranks: list[float] = [0.0] * len(combined)
+    tie_term = 0.0
+    idx = 0
+    while idx < len(combined):
+        end = idx
+        while end + 1 < len(combined) and combined[end + 1][0] == combined[idx][0]:
+            end += 1
+        for pos in range(idx, end + 1):
+            ranks[pos] = (idx + end) / 2.0 + 1.0
+        tied = end - idx + 1
+        tie_term += tied**3 - tied
+        idx = end + 1
+    rank_sum_x = sum(rank for rank, (_, side) in zip(ranks, combined) if side == 0)
+    u_x = rank_sum_x - n1 * (n1 + 1) / 2.0
+    u_small = min(u_x, n1 * n2 - u_x)
+    if tie_term == 0.0 and n1 * n2 <= 400:
+        counts = _mann_whitney_u_counts(n1, n2)
+        total = sum(counts)
+        tail = sum(counts[: int(math.floor(u_small)) + 1])
+        return min(1.0, 2.0 * tail / total)
+    n = n1 + n2
+    mean_u = n1 * n2 / 2.0
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+    z = (mean_u - u_small - 0.5) / math.sqrt(var_u)
+    return min(1.0, math.erfc(max(0.0, z) / math.sqrt(2.0)))
+
+
+def mann_whitney_min_p_value(n1: int, n2: int) -> float:
+    """Return the smallest two-sided p-value reachable with ``n1`` vs ``n2`` runs.
+
+    Complete separation of tie-free samples is one ordering out of
+    ``C(n1 + n2, n1)`` per side, so few runs can never reach a small alpha.
+    """
+    if n1 <= 0 or n2 <= 0:
+        return 1.0
+    return min(1.0, 2.0 / math.comb(n1 + n2, n1))
+
+
+def mann_whitney_min_runs(alpha: float) -> int:
+    """Return the runs per side needed before a p-value can reach ``alpha``."""
+    runs = 1
+    while mann_whitney_min_p_value(runs, runs) > alpha and runs < 1000:
+        runs += 1
+    return runs
+
+
+def _mann_whitney_u_counts(n1: int, n2: int) -> list[int]:
+    """Return how many rank orderings produce each U value (0..n1*n2)."""
+    # table[j] holds the U distribution for (i, j); rows are built for i=0..n1.
+    table = [[1] for _ in range(n2 + 1)]
+    for i in range(1, n1 + 1):
+        row = [[1]]
+        for j in range(1, n2 + 1):
+            size = i * j + 1
+            counts = [0] * size
+            # Largest remaining value comes from x (adds j to U) or from y.
+            for u, count in enumerate(row[j - 1]):
+                counts[u] += count
+            for u, count in enumerate(table[j]):
+                counts[u + j] += count
+            row.append(counts)
+        table = row
+    return table[n2]
+
+
+def bootstrap_median_pct_ci(
+    baseline: list[float],
+    candidate: list[float],
+    *,
+    iterations: int = BOOTSTRAP_ITERATIONS,
+    confidence: float = 0.95,
+    seed: int = 0,
+) -> tuple[float, float] | None:
+    """Return a bootstrap CI for the percent change in median, if defined."""
+    if not baseline or not candidate:
+        return None
+    rng = random.Random(seed)
+    estimates: list[float] = []
+    for _ in range(max(1, iterations)):
+        base = statistics.median(rng.choices(baseline, k=len(baseline)))
+        cand = statistics.median(rng.choices(candidate, k=len(candidate)))
+        if base == 0:
+            continue
+        estimates.append((cand - base) / base * 100.0)
+    if not estimates:
+        return None
+    estimates.sort()
+    tail = (1.0 - confidence) / 2.0
+    return (_percentile(estimates, tail), _percentile(estimates, 1.0 - tail))
+
+
+def _metric_threshold(
+    key: str, metric_thresholds: Mapping[str, float] | None
+) -> float | None:
+    for pattern, threshold in (metric_thresholds or {}).items():
+        if fnmatchcase(key, pattern):
+            return abs(float(threshold))
+    return None
+
+
+def parse_metric_thresholds(specs: list[str]) -> dict[str, float]:
+    """Parse ``PATTERN=PCT`` CLI specs into an ordered threshold mapping."""
+    thresholds: dict[str, float] = {}
+    for spec in specs:
+        pattern, sep, raw_pct = spec.rpartition("=")
+        if not sep or not pattern:
+            raise ValueError(f"expected PATTERN=PCT, got: {spec!r}")
+        try:
+            thresholds[pattern] = abs(float(raw_pct))
+        except ValueError as exc:
+            raise ValueError(f"invalid threshold percent in {spec!r}") from exc
+    return thresholds
+
+
+def compare_perf_run_groups(
+    baselines: list[dict[str, JsonValue]],
+    candidates: list[dict[str, JsonValue]],
+    *,
+    regression_pct_threshold: float = 5.0,
+    improvement_pct_threshold: float = -5.0,
+    metric_thresholds: Mapping[str, float] | None = None,
+    alpha: float = SIGNIFICANCE_ALPHA,
+    bootstrap_iterations: int = BOOTSTRAP_ITERATIONS,
+) -> PerfSignificanceResult:
+    """Compare repeated runs per metric with significance testing.
+
+    A metric is "regressed" or "improved" only when the Mann-Whitney p-value
+    is at most ``alpha`` and the median change crosses its threshold;
+    otherwise it is "within noise". ``metric_thresholds`` maps fnmatch
+    patterns over ``scenario.metric`` keys to a symmetric percent threshold;
+    the first match wins. Run counts whose smallest achievable p-value is
+    above ``alpha`` (fewer than 4 per side at 0.05) yield "insufficient_data".
+    Values are treated as lower-is-better.
+    """
+    base_values = _collect_metric_medians(baselines)
+    cand_values = _collect_metric_medians(candidates)
+    shared_keys = sorted(set(base_values) & set(cand_values))
+    metrics: list[PerfMetricSignificance] = []
+    for key in shared_keys:
+        base_unit, base = base_values[key]
+        cand_unit, cand = cand_values[key]
+        if base_unit != cand_unit:
+            continue
+        scenario_id, metric_name = key.split(".", 1)
+        override = _metric_threshold(key, metric_thresholds)
+        if override is None:
+            reg_threshold = abs(regression_pct_threshold)
+            imp_threshold = improvement_pct_threshold
+        else:
+            reg_threshold = override
+            imp_threshold = -override
+        base_median = statistics.median(base)
+        cand_median = statistics.median(cand)
+        pct = _safe_pct(cand_median - base_median, base_median)
+        ci: tuple[float, float] | None = None
+        p_value: float | None = None
+        if mann_whitney_min_p_value(len(base), len(cand)) > alpha:
+            verdict = VERDICT_INSUFFICIENT_DATA
+        else:
+            p_value = mann_whitney_u_p_value(base, cand)
+            ci = bootstrap_median_pct_ci(base, cand, iterations=bootstrap_iterations)
+            significant = p_value <= alpha
+            if significant and pct is not None and pct >= reg_threshold:
+                verdict = VERDICT_REGRESSED
+            elif significant and pct is not None and pct <= imp_threshold:
+                verdict = VERDICT_IMPROVED
+            else:
+                verdict = VERDICT_WITHIN_NOISE
+        metrics.append(
+            PerfMetricSignificance(
+                scenario_id=scenario_id,
+                metric_name=metric_name,
+                unit=base_unit,
+                baseline_values=tuple(base),
+                candidate_values=tuple(cand),
+                baseline_median=base_median,
+                candidate_median=cand_median,
+                pct_median=pct,
+                ci_low_pct=None if ci is None else ci[0],
+                ci_high_pct=None if ci is None else ci[1],
+                p_value=p_value,
+                regression_pct_threshold=reg_threshold,
+                verdict=verdict,
+            )
+        )
+    metrics.sort(key=lambda m: float("-inf") if m.pct_median is None else -m.pct_median)
+    return PerfSignificanceResult(
+        baseline_run_ids=[str(p.get("run_id") or "baseline") for p in baselines],
+        candidate_run_ids=[str(p.get("run_id") or "candidate") for p in candidates],
+        alpha=alpha,
+        metrics=metrics,
+        missing_in_candidate=sorted(set(base_values) - set(cand_values)),
+        new_in_candidate=sorted(set(cand_values) - set(base_values)),
+    )
+
+
+def _collect_metric_medians(
+    payloads: list[dict[str, JsonValue]],
+) -> dict[str, tuple[str, list[float]]]:
+    collected: dict[str, tuple[str, list[float]]] = {}
+    for payload in payloads:
+        for key, metric in _flatten_run_metrics(payload).items():
+            unit = metric.get("unit")
+            median = metric.get("median_value")
+            if not isinstance(unit, str) or not isinstance(median, (int, float)):
+                continue
+            entry = collected.setdefault(key, (unit, []))
+            if entry[0] == unit:
+                entry[1].append(float(median))
+    return collected
+
+
 def write_perf_run_artifact(
     run: PerfRunResult,
     *,
@@ -461,6 +749,33 @@ def load_perf_run_payload(path: Path) -> dict[str, JsonValue]:
     return payload
 
 
+def load_perf_run_payloads(path: Path) -> list[dict[str, JsonValue]]:
+    """Load run payloads from an artifact, a suite summary, or a directory.
+
+    Suite summaries expand to their listed artifacts; directories load every
+    artifact JSON in them, skipping suite summaries.
+    """
+    if path.is_dir():
+        payloads: list[dict[str, JsonValue]] = []
+        for child in sorted(path.glob("*.json")):
+            raw = json.loads(child.read_text(encoding="utf-8"))
+            if isinstance(raw, dict) and raw.get("schema") == PERF_SUITE_SUMMARY_SCHEMA:
+                continue
+            payloads.append(load_perf_run_payload(child))
+        return payloads
+    raw = json.loads(path.read_text(encoding="utf-8"))
+    if isinstance(raw, dict) and raw.get("schema") == PERF_SUITE_SUMMARY_SCHEMA:
+        artifacts = raw.get("artifacts")
+        if not isinstance(artifacts, list):
+            raise ValueError(f"suite summary missing artifacts list: {path}")
+        return [
+            load_perf_run_payload(Path(item).expanduser())
+            for item in artifacts
+            if isinstance(item, str)
+        ]
+    return [load_perf_run_payload(path)]
+
+
 def render_perf_comparison_text(
     comparison: PerfComparisonResult, *, max_rows_per_section: int = 10
 ) -> str:
@@ -500,6 +815,57 @@ def render_perf_comparison_text(
     return "\n".join(lines)
 
 
+def render_perf_significance_text(
+    result: PerfSignificanceResult, *, max_rows_per_section: int = 10
+) -> str:
+    """Render human-readable repeated-run significance summary."""
+    counts = {
+        verdict: len(result.with_verdict(verdict))
+        for verdict in (
+            VERDICT_REGRESSED,
+            VERDICT_IMPROVED,
+            VERDICT_WITHIN_NOISE,
+            VERDICT_INSUFFICIENT_DATA,
+        )
+    }
+    lines = [
+        "Perf significance comparison",
+        f"baseline_runs={len(result.baseline_run_ids)}",
+        f"candidate_runs={len(result.candidate_run_ids)}",
+        f"alpha={result.alpha:g}",
+        " ".join(f"{verdict}={count}" for verdict, count in counts.items()),
+    ]
+
+    def _fmt_pct(value: float | None) -> str:
+        return "n/a" if value is None else f"{value:+.1f}%"
+
+    def _append_section(title: str, rows: list[PerfMetricSignificance]) -> None:
+        lines.append(f"{title}:")
+        if not rows:
+            lines.append("  none")
+            return
+        for row in rows[:max_rows_per_section]:
+            p_text = "n/a" if row.p_value is None else f"{row.p_value:.3f}"
+            lines.append(
+                "  "
+                f"{row.scenario_id}.{row.metric_name} "
+                f"median {row.baseline_median:.3f}->{row.candidate_median:.3f} {row.unit} "
+                f"({_fmt_pct(row.pct_median)}, "
+                f"95% CI {_fmt_pct(row.ci_low_pct)}..{_fmt_pct(row.ci_high_pct)}, "
+                f"p={p_text}, threshold {row.regression_pct_threshold:g}%)"
+            )
+
+    _append_section("Regressions", result.regressed_metrics)
+    _append_section("Improvements", result.improved_metrics)
+    if counts[VERDICT_INSUFFICIENT_DATA]:
+        lines.append(
+            f"Too few runs to reach alpha={result.alpha:g} for "
+            f"{counts[VERDICT_INSUFFICIENT_DATA]} metric(s); re-run with "
+            f"--repeat {mann_whitney_min_runs(result.alpha)} or more per side."
+        )
+    return "\n".join(lines)
+
+
 def validate_perf_run_payload(payload: dict[str, JsonValue]) -> list[str]:
     """Return schema validation errors for a benchmark payload.
 
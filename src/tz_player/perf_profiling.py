@@ -2,24 +2,36 @@
 
 These utilities are intentionally separate from the standard opt-in benchmark
 suite so profiling overhead does not distort regular benchmark comparisons.
+`run_cprofile_callable` instruments one callable deterministically;
+`StackSampler` watches a whole session by sampling every thread's stack and
+writes collapsed stacks (`frame;frame;frame count`) for flamegraph tools.
 """
 
 from __future__ import annotations
 
 import cProfile
 import io
+import logging
 import os
 import pstats
 import sys
 import threading
 import time
+from collections import Counter
 from collections.abc import Mapping
 from dataclasses import dataclass
 from datetime import datetime, timezone
 from pathlib import Path
+from types import CodeType, FrameType
+
+logger = logging.getLogger(__name__)
 
 PERF_PROFILE_DIR_ENV = "TZ_PLAYER_PERF_PROFILE_DIR"
 DEFAULT_LOCAL_PERF_PROFILE_DIR = Path(".local/perf_profiles")
+DEFAULT_SAMPLE_HZ = 100
+# Sampling backs off so time spent walking stacks stays under this share of
+# wall time.
+MAX_SAMPLE_OVERHEAD = 0.02
 
 
 def resolve_perf_profile_dir(
@@ -157,3 +169,118 @@ def run_cprofile_callable(
         top_n=max(1, int(top_n)),
     )
     return result, artifact
+
+
+@dataclass(frozen=True)
+class StackSampleArtifact:
+    """Result of a sampling session and its collapsed-stack export."""
+
+    label: str
+    elapsed_s: float
+    samples: int
+    collapsed_path: Path
+    overhead_ratio: float
+
+
+class StackSampler:
+    """Background thread sampling all Python thread stacks at a fixed rate.
+
+    Stacks are aggregated in memory and written on `stop()` as one
+    ``<thread>;<outer frame>;...;<leaf frame> <count>`` line per unique stack,
+    the collapsed format read by flamegraph.pl, speedscope, and inferno.
+    """
+
+    def __init__(
+        self,
+        *,
+        label: str,
+        hz: int = DEFAULT_SAMPLE_HZ,
+        profile_dir: Path | None = None,
+        cwd: Path | None = None,
+        env: Mapping[str, str] | None = None,
+    ) -> None:
+        self.label = label
+        self._interval_s = 1.0 / max(1, min(1000, int(hz)))
+        self._profile_dir = profile_dir or resolve_perf_profile_dir(cwd=cwd, env=env)
+        self._stacks: Counter[str] = Counter()
+        self._frame_labels: dict[CodeType, str] = {}
+        self._samples = 0
+        self._sample_cost_s = 0.0
+        self._started_s = 0.0
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+    def start(self) -> None:
+        if self._thread is not None:
+            raise RuntimeError("StackSampler already started")
+        self._started_s = time.perf_counter()
+        self._thread = threading.Thread(
+            target=self._run, name="tz-player-stack-sampler", daemon=True
+        )
+        self._thread.start()
+
+    def stop(self) -> StackSampleArtifact:
+        """Stop sampling and write the collapsed-stack file."""
+        if self._thread is None:
+            raise RuntimeError("StackSampler was not started")
+        self._stop.set()
+        self._thread.join()
+        elapsed = time.perf_counter() - self._started_s
+        self._profile_dir.mkdir(parents=True, exist_ok=True)
+        slug = f"{profile_timestamp_slug()}_{sanitize_profile_label(self.label)}"
+        collapsed_path = self._profile_dir / f"{slug}.collapsed"
+        with collapsed_path.open("w", encoding="utf-8") as handle:
+            for stack, count in self._stacks.most_common():
+                handle.write(f"{stack} {count}\n")
+        artifact = StackSampleArtifact(
+            label=self.label,
+            elapsed_s=elapsed,
+            samples=self._samples,
+            collapsed_path=collapsed_path,
+            overhead_ratio=self._sample_cost_s / elapsed if elapsed > 0 else 0.0,
+        )
+        logger.info(
+            "Wrote %d stack samples to %s",
+            artifact.samples,
+            collapsed_path,
+            extra={
+                "event": "profile_sample_written",
+                "samples": artifact.samples,
+                "elapsed_s": round(elapsed, 3),
+                "overhead_ratio": round(artifact.overhead_ratio, 5),
+            },
+        )
+        return artifact
+
+    def _run(self) -> None:
+        own_id = threading.get_ident()
+        interval_s = self._interval_s
+        while not self._stop.wait(interval_s):
+            started = time.perf_counter()
+            names = {thread.ident: thread.name for thread in threading.enumerate()}
+            for thread_id, frame in sys._current_frames().items():
+                if thread_id == own_id:
+                    continue
+                thread_name = names.get(thread_id, f"thread-{thread_id}")
+                self._stacks[self._collapse(thread_name, frame)] += 1
+            self._samples += 1
+            cost = time.perf_counter() - started
+            self._sample_cost_s += cost
+            interval_s = max(self._interval_s, cost / MAX_SAMPLE_OVERHEAD)
+
+    def _collapse(self, thread_name: str, frame: FrameType | None) -> str:
+        parts: list[str] = []
+        while frame is not None:
+            code = frame.f_code
+            frame_label = self._frame_labels.get(code)
+            if frame_label is None:
+                frame_label = (
+                    f"{code.co_name} ({Path(code.co_filename).name}:"
+                    f"{code.co_firstlineno})"
+                ).replace(";", ":")
+                self._frame_labels[code] = frame_label
+            parts.append(frame_label)
+            frame = frame.f_back
+        parts.append(thread_name.replace(";", ":").replace(" ", "_"))
+        parts.reverse()
+        return ";".join(parts)
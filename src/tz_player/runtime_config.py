@@ -11,11 +11,18 @@ _VISUALIZER_PROFILE_DEFAULT_FPS = {
     "balanced": 14,
     "aggressive": 22,
 }
+# Spectrum frames are interpolated at render time, so "safe" can analyze and
+# store a coarser hop without visible stepping.
 _VISUALIZER_PROFILE_SPECTRUM_HOP_MS = {
-    "safe": 40,
+    "safe": 60,
     "balanced": 32,
     "aggressive": 24,
 }
+_VISUALIZER_PROFILE_SPECTRUM_INTERPOLATION = {
+    "safe": "envelope",
+    "balanced": "linear",
+    "aggressive": "linear",
+}
 _VISUALIZER_PROFILE_BEAT_HOP_MS = {
     "safe": 40,
     "balanced": 32,
@@ -60,6 +67,12 @@ def profile_default_spectrum_hop_ms(profile: str) -> int:
     return _VISUALIZER_PROFILE_SPECTRUM_HOP_MS[normalized]
 
 
+def profile_default_spectrum_interpolation(profile: str) -> str:
+    """Return render-time spectrum interpolation mode for a profile."""
+    normalized = normalize_visualizer_responsiveness_profile(profile)
+    return _VISUALIZER_PROFILE_SPECTRUM_INTERPOLATION[normalized]
+
+
 def profile_default_beat_hop_ms(profile: str) -> int:
     """Return default beat hop interval for a responsiveness profile."""
     normalized = normalize_visualizer_responsiveness_profile(profile)
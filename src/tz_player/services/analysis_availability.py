@@ -0,0 +1,165 @@
+"""In-process availability index for persisted analysis.
+
+While analysis for a track is queued or has just failed, samplers would
+otherwise query SQLite (and ``stat`` the file) on every poll tick only to learn
+nothing changed. This index records ``(track path, analysis type, params)`` →
+ready/pending/failed so those ticks cost one dict lookup. Ready entries carry the
+file fingerprint they were computed for and are seeded from the cache database
+at startup; pending/failed entries are maintained by the analysis scheduler.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+import time
+from collections.abc import Callable, Hashable, Iterable, Mapping
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Literal
+
+AnalysisAvailability = Literal["ready", "pending", "failed"]
+# Failed analyses are retried after this long (e.g. once ffmpeg is installed).
+FAILED_RETRY_S = 300.0
+
+
+@dataclass(frozen=True)
+class _Entry:
+    state: AnalysisAvailability
+    mtime_ns: int | None = None
+    size_bytes: int | None = None
+    updated_s: float = 0.0
+
+
+class AnalysisAvailabilityIndex:
+    """Track analysis state per ``(path, analysis type, params)`` key."""
+
+    def __init__(
+        self,
+        *,
+        failed_retry_s: float = FAILED_RETRY_S,
+        clock: Callable[[], float] = time.monotonic,
+    ) -> None:
+        self._entries: dict[tuple[str, str, Hashable], _Entry] = {}
+        self._failed_retry_s = max(0.0, float(failed_retry_s))
+        self._clock = clock
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def state(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> AnalysisAvailability | None:
+        """Return the known state without touching disk; ``None`` if unknown."""
+        key = (_normalize_path(track_path), analysis_type, params)
+        entry = self._entries.get(key)
+        if entry is None:
+            return None
+        if (
+            entry.state == "failed"
+            and self._clock() - entry.updated_s >= self._failed_retry_s
+        ):
+            del self._entries[key]
+            return None
+        return entry.state
+
+    def is_ready(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> bool:
+        """Return whether a ready entry matches the file's current fingerprint."""
+        key = (_normalize_path(track_path), analysis_type, params)
+        entry = self._entries.get(key)
+        if entry is None or entry.state != "ready":
+            return False
+        return _stat_path(Path(track_path)) == (entry.mtime_ns, entry.size_bytes)
+
+    def mark_pending(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> None:
+        self._set(track_path, analysis_type, params, _Entry("pending"))
+
+    def mark_failed(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> None:
+        self._set(
+            track_path, analysis_type, params, _Entry("failed", updated_s=self._clock())
+        )
+
+    def mark_ready(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> None:
+        mtime_ns, size_bytes = _stat_path(Path(track_path))
+        self._set(
+            track_path, analysis_type, params, _Entry("ready", mtime_ns, size_bytes)
+        )
+
+    def clear_pending(
+        self, track_path: str | Path, analysis_type: str, params: Hashable
+    ) -> None:
+        """Drop a pending marker left behind by a task that wrote nothing."""
+        key = (_normalize_path(track_path), analysis_type, params)
+        entry = self._entries.get(key)
+        if entry is not None and entry.state == "pending":
+            del self._entries[key]
+
+    def load_ready(
+        self,
+        rows: Iterable[tuple[str, int | None, int | None, str, int, str]],
+        params_types: Mapping[str, Callable[..., Hashable]],
+        *,
+        analysis_versions: Mapping[str, int] | None = None,
+    ) -> int:
+        """Seed ready entries from cache-entry rows.
+
+        Rows are ``(path_norm, mtime_ns, size_bytes, analysis_type,
+        analysis_version, params_json)``; types without a params factory, rows
+        from another analyzer version (default 1), and params that no longer
+        parse are skipped. Returns entries loaded.
+        """
+        versions = analysis_versions or {}
+        loaded = 0
+        for path_norm, mtime_ns, size_bytes, analysis_type, version, raw in rows:
+            factory = params_types.get(analysis_type)
+            if factory is None or int(version) != versions.get(analysis_type, 1):
+                continue
+            try:
+                params = factory(**json.loads(raw))
+            except (TypeError, ValueError):
+                continue
+            self._entries[(path_norm, analysis_type, params)] = _Entry(
+                "ready", mtime_ns, size_bytes
+            )
+            loaded += 1
+        return loaded
+
+    def clear_ready(self) -> None:
+        """Forget ready entries, e.g. after a prune removed some of them."""
+        self._entries = {
+            key: entry for key, entry in self._entries.items() if entry.state != "ready"
+        }
+
+    def _set(
+        self,
+        track_path: str | Path,
+        analysis_type: str,
+        params: Hashable,
+        entry: _Entry,
+    ) -> None:
+        self._entries[(_normalize_path(track_path), analysis_type, params)] = entry
+
+
+def _normalize_path(path: str | Path) -> str:
+    # Must match the stores' ``path_norm`` so seeded rows line up; they always
+    # see a ``Path``, so string callers go through the same conversion.
+    raw = str(Path(path))
+    if os.name == "nt":
+        return raw.lower()
+    return raw
+
+
+def _stat_path(path: Path) -> tuple[int | None, int | None]:
+    try:
+        stats = path.stat()
+    except OSError:
+        return None, None
+    return int(stats.st_mtime_ns), int(stats.st_size)
@@ -0,0 +1,292 @@
+"""Connection setup for the dedicated analysis-cache SQLite database.
+
+Analysis frames live in their own database file so bulk ingests never hold the
+writer lock that playlist edits need, and so the cache can run with settings
+suited to rebuildable data: WAL with ``synchronous=NORMAL`` (a crash may drop the
+last few commits, which are simply recomputed), larger pages for blob-heavy
+frame tables, and incremental auto-vacuum so prunes can hand space back.
+"""
+
+from __future__ import annotations
+
+import logging
+import sqlite3
+from pathlib import Path
+
+logger = logging.getLogger(__name__)
+
+ANALYSIS_CACHE_PAGE_SIZE = 16_384
+_ANALYSIS_TABLES = (
+    "analysis_cache_entries",
+    "analysis_scalar_frames",
+    "analysis_spectrum_frames",
+    "analysis_beat_frames",
+    "analysis_waveform_proxy_frames",
+)
+# Pre-cache envelope tables that older library schemas created.
+_LEGACY_ENVELOPE_TABLES = ("audio_envelope_points", "audio_envelopes")
+# Pages released per prune; bounded so one vacuum step stays short.
+_INCREMENTAL_VACUUM_PAGES = 4096
+
+
+def connect_analysis_cache(db_path: Path, *, timeout: float = 30) -> sqlite3.Connection:
+    """Open an analysis-cache connection with cache-appropriate pragmas."""
+    conn = sqlite3.connect(db_path, timeout=timeout)
+    conn.row_factory = sqlite3.Row
+    conn.execute("PRAGMA foreign_keys=ON")
+    conn.execute("PRAGMA synchronous=NORMAL")
+    return conn
+
+
+def prepare_analysis_cache_db(conn: sqlite3.Connection) -> None:
+    """Apply file-level settings; page size and auto-vacuum only take on new files."""
+    has_tables = (
+        conn.execute(
+            "SELECT 1 FROM sqlite_master WHERE type = 'table' LIMIT 1"
+        ).fetchone()
+        is not None
+    )
+    if not has_tables:
+        conn.execute(f"PRAGMA page_size={ANALYSIS_CACHE_PAGE_SIZE}")
+        conn.execute("PRAGMA auto_vacuum=INCREMENTAL")
+    conn.execute("PRAGMA journal_mode=WAL")
+
+
+def incremental_vacuum(conn: sqlite3.Connection) -> None:
+    """Release free pages after deletes when incremental auto-vacuum is on."""
+    if conn.in_transaction:
+        conn.commit()
+    if int(conn.execute("PRAGMA auto_vacuum").fetchone()[0]) != 2:
+        return
+    conn.execute(f"PRAGMA incremental_vacuum({_INCREMENTAL_VACUUM_PAGES})").fetchall()
+
+
+def ensure_segment_schema(conn: sqlite3.Connection) -> None:
+    """Add segment columns to ``analysis_cache_entries``.
+
+    ``covered_ms`` is NULL for whole-track entries, else the analyzed prefix;
+    ``norm_peak`` is the full-scale level the first segment chose, so resumed
+    segments quantize on the same scale.
+    """
+    columns = _table_columns(conn, "main", "analysis_cache_entries")
+    if "covered_ms" not in columns:
+        conn.execute("ALTER TABLE analysis_cache_entries ADD COLUMN covered_ms INTEGER")
+    if "norm_peak" not in columns:
+        conn.execute("ALTER TABLE analysis_cache_entries ADD COLUMN norm_peak REAL")
+
+
+def begin_segment_write(
+    conn: sqlite3.Connection,
+    frames_table: str,
+    entry_id: int,
+    segment_start_ms: int,
+) -> int:
+    """Drop frames the segment replaces and return the next ``frame_idx``."""
+    if segment_start_ms <= 0:
+        conn.execute(f"DELETE FROM {frames_table} WHERE entry_id = ?", (entry_id,))
+        return 0
+    conn.execute(
+        f"DELETE FROM {frames_table} WHERE entry_id = ? AND position_ms >= ?",
+        (entry_id, segment_start_ms),
+    )
+    row = conn.execute(
+        f"SELECT COALESCE(MAX(frame_idx) + 1, 0) FROM {frames_table} WHERE entry_id = ?",
+        (entry_id,),
+    ).fetchone()
+    return int(row[0])
+
+
+def extend_segment_entry(
+    conn: sqlite3.Connection, entry_id: int, duration_ms: int
+) -> None:
+    """Refresh an entry's timestamps and duration before appending a segment."""
+    conn.execute(
+        """
+        UPDATE analysis_cache_entries
+        SET duration_ms = MAX(duration_ms, ?),
+            computed_at = strftime('%s','now'),
+            last_accessed_at = strftime('%s','now')
+        WHERE id = ?
+        """,
+        (max(1, int(duration_ms)), entry_id),
+    )
+
+
+def finish_segment_write(
+    conn: sqlite3.Connection,
+    frames_table: str,
+    entry_id: int,
+    *,
+    segment_start_ms: int,
+    covered_ms: int | None,
+    byte_size_sql: str,
+    norm_peak: float | None = None,
+) -> None:
+    """Record coverage and, for appended segments, refresh entry totals."""
+    if segment_start_ms <= 0:
+        conn.execute(
+            "UPDATE analysis_cache_entries SET covered_ms = ?, norm_peak = ? WHERE id = ?",
+            (covered_ms, norm_peak, entry_id),
+        )
+        return
+    conn.execute(
+        f"""
+        UPDATE analysis_cache_entries
+        SET covered_ms = ?,
+            frame_count = (SELECT COUNT(*) FROM {frames_table} WHERE entry_id = ?),
+            byte_size = (
+                SELECT COALESCE({byte_size_sql}, 0) FROM {frames_table} WHERE entry_id = ?
+            )
+        WHERE id = ?
+        """,
+        (covered_ms, entry_id, entry_id, entry_id),
+    )
+
+
+def entry_covered_ms(conn: sqlite3.Connection, entry_id: int) -> int | None:
+    """Return the analyzed prefix of a partial entry, ``None`` when complete."""
+    row = conn.execute(
+        "SELECT covered_ms FROM analysis_cache_entries WHERE id = ?", (entry_id,)
+    ).fetchone()
+    if row is None or row[0] is None:
+        return None
+    return int(row[0])
+
+
+def entry_norm_peak(conn: sqlite3.Connection, entry_id: int) -> float | None:
+    """Return the full-scale level recorded by an entry's first segment."""
+    row = conn.execute(
+        "SELECT norm_peak FROM analysis_cache_entries WHERE id = ?", (entry_id,)
+    ).fetchone()
+    if row is None or row[0] is None:
+        return None
+    return float(row[0])
+
+
+def complete_segment_entry(conn: sqlite3.Connection, entry_id: int) -> None:
+    """Mark a partial entry whole once no audio follows its last segment."""
+    conn.execute(
+        "UPDATE analysis_cache_entries SET covered_ms = NULL WHERE id = ?",
+        (entry_id,),
+    )
+
+
+def import_legacy_analysis_cache(cache_db_path: Path, legacy_db_path: Path) -> int:
+    """Move analysis rows from the library DB into the cache DB, then drop them.
+
+    Earlier builds stored analysis tables alongside playlists. The legacy file is
+    attached only for this step; rows move table by table with their ids intact
+    when the cache DB is still empty. The legacy tables are then dropped and the
+    library file vacuumed once to hand the space back. Returns entries moved.
+    """
+    if not legacy_db_path.exists() or cache_db_path == legacy_db_path:
+        return 0
+    moved = 0
+    with connect_analysis_cache(cache_db_path) as conn:
+        conn.execute("ATTACH DATABASE ? AS legacy", (str(legacy_db_path),))
+        try:
+            legacy_tables = [
+                table
+                for table in (*_ANALYSIS_TABLES, *_LEGACY_ENVELOPE_TABLES)
+                if _table_columns(conn, "legacy", table)
+            ]
+            if not legacy_tables:
+                return 0
+            conn.execute("BEGIN IMMEDIATE")
+            if _has_rows(conn, "legacy", "analysis_cache_entries") and not _has_rows(
+                conn, "main", "analysis_cache_entries"
+            ):
+                moved = _copy_legacy_rows(conn)
+            # Children first so foreign-key checks never see orphaned rows.
+            for table in reversed(legacy_tables):
+                conn.execute(f"DROP TABLE legacy.{table}")
+            conn.commit()
+        finally:
+            if conn.in_transaction:
+                conn.rollback()
+            conn.execute("DETACH DATABASE legacy")
+    _vacuum(legacy_db_path)
+    logger.info(
+        "Moved analysis cache into dedicated database",
+        extra={
+            "event": "analysis_cache_legacy_import",
+            "entries": moved,
+            "dropped_tables": len(legacy_tables),
+        },
+    )
+    return moved
+
+
+def list_analysis_entries(
+    cache_db_path: Path,
+) -> list[tuple[str, int | None, int | None, str, int, str]]:
+    """Return identity columns for every cache entry, for availability seeding."""
+    if not cache_db_path.exists():
+        return []
+    with connect_analysis_cache(cache_db_path) as conn:
+        columns = _table_columns(conn, "main", "analysis_cache_entries")
+        if not columns:
+            return []
+        # Partially analyzed tracks still need their remaining segments.
+        where = "WHERE covered_ms IS NULL" if "covered_ms" in columns else ""
+        rows = conn.execute(
+            f"""
+            SELECT path_norm, mtime_ns, size_bytes, analysis_type,
+                   analysis_version, params_json
+            FROM analysis_cache_entries
+            {where}
+            """
+        ).fetchall()
+    return [
+        (
+            str(row[0]),
+            None if row[1] is None else int(row[1]),
+            None if row[2] is None else int(row[2]),
+            str(row[3]),
+            int(row[4]),
+            str(row[5]),
+        )
+        for row in rows
+    ]
+
+
+def _copy_legacy_rows(conn: sqlite3.Connection) -> int:
+    moved = 0
+    for table in _ANALYSIS_TABLES:
+        columns = _shared_columns(conn, table)
+        if not columns:
+            continue
+        column_sql = ", ".join(columns)
+        cursor = conn.execute(
+            f"INSERT INTO main.{table} ({column_sql}) "
+            f"SELECT {column_sql} FROM legacy.{table}"
+        )
+        if table == "analysis_cache_entries":
+            moved = max(0, cursor.rowcount)
+    return moved
+
+
+def _vacuum(db_path: Path) -> None:
+    conn = sqlite3.connect(db_path, timeout=30)
+    try:
+        conn.execute("VACUUM")
+    finally:
+        conn.close()
+
+
+def _has_rows(conn: sqlite3.Connection, schema: str, table: str) -> bool:
+    if not _table_columns(conn, schema, table):
+        return False
+    return (
+        conn.execute(f"SELECT 1 FROM {schema}.{table} LIMIT 1").fetchone() is not None
+    )
+
+
+def _shared_columns(conn: sqlite3.Connection, table: str) -> list[str]:
+    legacy = set(_table_columns(conn, "legacy", table))
+    return [name for name in _table_columns(conn, "main", table) if name in legacy]
+
+
+def _table_columns(conn: sqlite3.Connection, schema: str, table: str) -> list[str]:
+    rows = conn.execute(f"PRAGMA {schema}.table_info({table})").fetchall()
+    return [str(row[1]) for row in rows]
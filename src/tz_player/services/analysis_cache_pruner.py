@@ -6,8 +6,12 @@ import sqlite3
 from dataclasses import dataclass
 from pathlib import Path
 
+from tz_player.services.analysis_cache_db import (
+    connect_analysis_cache,
+    incremental_vacuum,
+)
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 
 @dataclass(frozen=True)
@@ -30,7 +34,7 @@ class SqliteAnalysisCachePruner:
         self._db_path = Path(db_path)
 
     async def total_cache_bytes(self) -> int:
-        return await run_blocking(self._total_cache_bytes_sync)
+        return await run_db(self._total_cache_bytes_sync)
 
     async def exceeds_threshold(
         self, *, max_cache_bytes: int, threshold: float
@@ -49,7 +53,7 @@ class SqliteAnalysisCachePruner:
         max_age_days: int,
         min_recent_tracks_protected: int,
     ) -> AnalysisCachePruneResult:
-        return await run_blocking(
+        return await run_db(
             self._prune_sync,
             max_cache_bytes,
             max_age_days,
@@ -57,10 +61,7 @@ class SqliteAnalysisCachePruner:
         )
 
     def _connect(self) -> sqlite3.Connection:
-        conn = sqlite3.connect(self._db_path, timeout=30)
-        conn.row_factory = sqlite3.Row
-        conn.execute("PRAGMA foreign_keys=ON")
-        return conn
+        return connect_analysis_cache(self._db_path)
 
     def _total_cache_bytes_sync(self) -> int:
         with self._connect() as conn:
@@ -145,7 +146,11 @@ class SqliteAnalysisCachePruner:
                     bytes_after=bytes_after,
                 )
 
-        return run_with_sqlite_lock_retry(_op, op_name="analysis_cache.prune")
+        result = run_with_sqlite_lock_retry(_op, op_name="analysis_cache.prune")
+        if result.entries_pruned > 0:
+            with self._connect() as conn:
+                incremental_vacuum(conn)
+        return result
 
 
 def _sum_bytes(conn: sqlite3.Connection) -> int:
@@ -0,0 +1,188 @@
+"""Content-addressed identity for analysis cache entries.
+
+Analysis cache rows are keyed by normalized path plus ``mtime_ns``/``size_bytes``,
+so moving a library root, re-tagging files, or storing the same audio in several
+albums would otherwise force re-analysis. Each row also records a content key: a
+fast hash of the audio payload with leading/trailing tag blocks (ID3v2, ID3v1,
+APEv2, FLAC metadata) skipped. Lookups that miss on path fall back to the content
+key, so relocated or duplicated files reuse existing analysis.
+
+Set ``TZ_PLAYER_DISABLE_ANALYSIS_CONTENT_KEY=1`` to restore path-only identity.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import os
+import sqlite3
+from dataclasses import dataclass
+from functools import lru_cache
+from pathlib import Path
+
+CONTENT_KEY_DISABLE_ENV = "TZ_PLAYER_DISABLE_ANALYSIS_CONTENT_KEY"
+CONTENT_KEY_VERSION = "c1"
+# Three windows (head/middle/tail of the payload) plus its length identify audio
+# reliably without reading whole files during cache lookups.
+_WINDOW_BYTES = 64 * 1024
+_ID3V1_BYTES = 128
+_APE_FOOTER_BYTES = 32
+_FLAC_MAX_METADATA_BLOCKS = 128
+
+
+@dataclass(frozen=True)
+class AnalysisEntryKey:
+    """Identity of one analysis cache entry for a concrete track file."""
+
+    analysis_type: str
+    track_path: Path
+    path_norm: str
+    mtime_ns: int | None
+    size_bytes: int | None
+    analysis_version: int
+    params_hash: str
+
+    @property
+    def content_key(self) -> str | None:
+        return content_key_for_path(self.track_path, self.mtime_ns, self.size_bytes)
+
+
+def content_key_for_path(
+    track_path: Path, mtime_ns: int | None, size_bytes: int | None
+) -> str | None:
+    """Return the payload content key for a file version, or ``None``."""
+    if mtime_ns is None or size_bytes is None:
+        return None
+    if os.environ.get(CONTENT_KEY_DISABLE_ENV, "").strip().lower() in {
+        "1",
+        "true",
+        "yes",
+        "on",
+    }:
+        return None
+    return _content_key_cached(str(track_path), mtime_ns, size_bytes)
+
+
+def ensure_content_key_schema(conn: sqlite3.Connection) -> None:
+    """Add the ``content_key`` column and index to ``analysis_cache_entries``."""
+    columns = {
+        str(row[1])
+        for row in conn.execute("PRAGMA table_info(analysis_cache_entries)").fetchall()
+    }
+    if "content_key" not in columns:
+        conn.execute("ALTER TABLE analysis_cache_entries ADD COLUMN content_key TEXT")
+    conn.execute(
+        "CREATE INDEX IF NOT EXISTS idx_analysis_cache_content ON analysis_cache_entries(analysis_type, content_key, analysis_version, params_hash)"
+    )
+
+
+def find_entry_id(conn: sqlite3.Connection, key: AnalysisEntryKey) -> int | None:
+    """Resolve an entry by exact path fingerprint, then by content key."""
+    row = conn.execute(
+        """
+        SELECT id
+        FROM analysis_cache_entries
+        WHERE analysis_type = ?
+          AND path_norm = ?
+          AND analysis_version = ?
+          AND params_hash = ?
+          AND mtime_ns IS ?
+          AND size_bytes IS ?
+        LIMIT 1
+        """,
+        (
+            key.analysis_type,
+            key.path_norm,
+            key.analysis_version,
+            key.params_hash,
+            key.mtime_ns,
+            key.size_bytes,
+        ),
+    ).fetchone()
+    if row is not None:
+        return int(row[0])
+    content_key = key.content_key
+    if content_key is None:
+        return None
+    row = conn.execute(
+        """
+        SELECT id
+        FROM analysis_cache_entries
+        WHERE analysis_type = ?
+          AND content_key = ?
+          AND analysis_version = ?
+          AND params_hash = ?
+        ORDER BY last_accessed_at DESC
+        LIMIT 1
+        """,
+        (key.analysis_type, content_key, key.analysis_version, key.params_hash),
+    ).fetchone()
+    return int(row[0]) if row is not None else None
+
+
+@lru_cache(maxsize=4096)
+def _content_key_cached(path: str, mtime_ns: int, size_bytes: int) -> str | None:
+    # mtime/size are part of the cache key so edited files are re-hashed.
+    del mtime_ns
+    try:
+        with open(path, "rb") as handle:
+            start, end = _payload_bounds(handle, size_bytes)
+            if end <= start:
+                return None
+            digest = hashlib.blake2b(digest_size=16)
+            digest.update((end - start).to_bytes(8, "little"))
+            for offset in _window_offsets(start, end):
+                handle.seek(offset)
+                digest.update(handle.read(min(_WINDOW_BYTES, end - offset)))
+    except OSError:
+        return None
+    return f"{CONTENT_KEY_VERSION}:{digest.hexdigest()}"
+
+
+def _window_offsets(start: int, end: int) -> list[int]:
+    length = end - start
+    if length <= 3 * _WINDOW_BYTES:
+        return [start]
+    middle = start + (length - _WINDOW_BYTES) // 2
+    return [start, middle, end - _WINDOW_BYTES]
+
+
+def _payload_bounds(handle, size_bytes: int) -> tuple[int, int]:
+    """Return ``[start, end)`` of the audio payload with tag blocks excluded."""
+    start = 0
+    header = handle.read(10)
+    if len(header) == 10 and header[:3] == b"ID3":
+        tag_size = _syncsafe(header[6:10])
+        start = 10 + tag_size + (10 if header[5] & 0x10 else 0)
+        handle.seek(start)
+        header = handle.read(4)
+    if header[:4] == b"fLaC":
+        start = _flac_audio_offset(handle, start + 4)
+    end = size_bytes
+    if end - _ID3V1_BYTES >= start:
+        handle.seek(end - _ID3V1_BYTES)
+        if handle.read(3) == b"TAG":
+            end -= _ID3V1_BYTES
+    if end - _APE_FOOTER_BYTES >= start:
+        handle.seek(end - _APE_FOOTER_BYTES)
+        footer = handle.read(_APE_FOOTER_BYTES)
+        if footer[:8] == b"APETAGEX":
+            ape_size = int.from_bytes(footer[12:16], "little")
+            flags = int.from_bytes(footer[20:24], "little")
+            end -= ape_size + (_APE_FOOTER_BYTES if flags & 0x80000000 else 0)
+    return start, max(start, end)
+
+
+def _flac_audio_offset(handle, offset: int) -> int:
+    for _ in range(_FLAC_MAX_METADATA_BLOCKS):
+        handle.seek(offset)
+        block = handle.read(4)
+        if len(block) < 4:
+            return offset
+        offset += 4 + int.from_bytes(block[1:4], "big")
+        if block[0] & 0x80:
+            break
+    return offset
+
+
+def _syncsafe(raw: bytes) -> int:
+    return (raw[0] << 21) | (raw[1] << 14) | (raw[2] << 7) | raw[3]
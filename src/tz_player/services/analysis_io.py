@@ -0,0 +1,131 @@
+"""I/O scheduling for background analysis reads.
+
+Analysis decodes whole files, which competes with playback reads on slow disks
+and network shares. Reads done here are hinted as sequential (and dropped from
+the page cache afterwards, since analysis never rereads them), issued in large
+aligned chunks, and paced by a process-wide token bucket. The bucket shrinks to
+a fraction of its rate while playback is active so library-scale prewarming
+cannot starve the player.
+
+``TZ_PLAYER_ANALYSIS_IO_MBPS`` sets the budget in MiB/s (``0`` disables pacing).
+"""
+
+from __future__ import annotations
+
+import os
+import threading
+import time
+from collections.abc import Callable
+from functools import lru_cache
+from pathlib import Path
+
+ANALYSIS_IO_BUDGET_ENV = "TZ_PLAYER_ANALYSIS_IO_MBPS"
+DEFAULT_ANALYSIS_IO_MBPS = 32.0
+# Share of the budget left to analysis while playback is reading.
+PLAYBACK_ACTIVE_FACTOR = 0.25
+READ_CHUNK_BYTES = 1 << 20
+# Opaque decoders (ffmpeg, the native helper) read at their own pace; windows of
+# those reads are charged at a generous lossy bitrate (~384 kbit/s).
+_ESTIMATED_BYTES_PER_MS = 48
+
+
+class IoTokenBucket:
+    """Thread-safe byte budget; callers sleep off any debt they create."""
+
+    def __init__(
+        self,
+        rate_bytes_per_s: float,
+        *,
+        burst_bytes: float | None = None,
+        clock: Callable[[], float] = time.monotonic,
+        sleep: Callable[[float], None] = time.sleep,
+    ) -> None:
+        self._rate = max(0.0, float(rate_bytes_per_s))
+        self._burst = max(
+            float(READ_CHUNK_BYTES),
+            float(burst_bytes) if burst_bytes is not None else self._rate,
+        )
+        self._tokens = self._burst
+        self._clock = clock
+        self._sleep = sleep
+        self._updated = clock()
+        self._playback_active = False
+        self._lock = threading.Lock()
+
+    @property
+    def enabled(self) -> bool:
+        return self._rate > 0.0
+
+    def set_playback_active(self, active: bool) -> None:
+        with self._lock:
+            self._refill_locked()
+            self._playback_active = bool(active)
+
+    def consume(self, nbytes: int) -> float:
+        """Charge ``nbytes`` and block until the budget covers them.
+
+        Returns the seconds slept.
+        """
+        if not self.enabled or nbytes <= 0:
+            return 0.0
+        with self._lock:
+            self._refill_locked()
+            self._tokens -= float(nbytes)
+            wait_s = -self._tokens / self._effective_rate() if self._tokens < 0 else 0.0
+        if wait_s > 0.0:
+            self._sleep(wait_s)
+        return wait_s
+
+    def _effective_rate(self) -> float:
+        if self._playback_active:
+            return self._rate * PLAYBACK_ACTIVE_FACTOR
+        return self._rate
+
+    def _refill_locked(self) -> None:
+        now = self._clock()
+        elapsed = max(0.0, now - self._updated)
+        self._updated = now
+        self._tokens = min(self._burst, self._tokens + elapsed * self._effective_rate())
+
+
+@lru_cache(maxsize=1)
+def analysis_io_budget() -> IoTokenBucket:
+    """Return the process-wide analysis read budget."""
+    raw = os.environ.get(ANALYSIS_IO_BUDGET_ENV, "").strip()
+    try:
+        mbps = float(raw) if raw else DEFAULT_ANALYSIS_IO_MBPS
+    except ValueError:
+        mbps = DEFAULT_ANALYSIS_IO_MBPS
+    return IoTokenBucket(max(0.0, mbps) * 1024 * 1024)
+
+
+def charge_opaque_read(path: Path, *, max_duration_ms: int | None = None) -> float:
+    """Charge the budget for a read another process will perform."""
+    try:
+        size = int(path.stat().st_size)
+    except OSError:
+        return 0.0
+    if max_duration_ms is not None:
+        size = min(size, max_duration_ms * _ESTIMATED_BYTES_PER_MS)
+    return analysis_io_budget().consume(size)
+
+
+def advise_sequential(fd: int) -> None:
+    """Hint a front-to-back read so the kernel reads ahead aggressively."""
+    _fadvise(fd, "POSIX_FADV_SEQUENTIAL")
+
+
+def advise_dontneed(fd: int) -> None:
+    """Drop pages analysis has consumed so they do not evict playback data."""
+    _fadvise(fd, "POSIX_FADV_DONTNEED")
+
+
+def _fadvise(fd: int, advice_name: str) -> None:
+    fadvise = getattr(os, "posix_fadvise", None)
+    advice = getattr(os, advice_name, None)
+    if fadvise is None or advice is None:
+        return
+    try:
+        fadvise(fd, 0, 0, advice)
+    except OSError:
+        return
@@ -0,0 +1,152 @@
+"""Cross-process single-flight leases for analysis work.
+
+Several tz-player sessions (or an offline analysis run) can share one analysis
+cache. Before analyzing a track, a process claims a lease row keyed by the
+track's content key (or path fingerprint when content keys are off) and the
+analysis params; other processes wait for the result to land in the cache
+instead of decoding the same audio again. Leases carry an expiry the holder
+renews between segments, so a crashed holder's lease is taken over once it goes
+stale, or immediately when the owning PID on this host is gone.
+"""
+
+from __future__ import annotations
+
+import os
+import socket
+import sqlite3
+import time
+import uuid
+from collections.abc import Callable
+from pathlib import Path
+
+from tz_player.services.analysis_cache_db import connect_analysis_cache
+from tz_player.services.analysis_content_key import content_key_for_path
+from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
+from tz_player.utils.async_utils import run_db
+
+# Holders renew well inside this window; one analysis segment takes seconds.
+LEASE_TTL_S = 90.0
+# Waiters give up and analyze themselves after this long without a result.
+LEASE_WAIT_TIMEOUT_S = 300.0
+LEASE_POLL_S = 1.0
+
+
+def analysis_lease_key(track_path: Path | str, params_token: str) -> str:
+    """Return the lease key for one track version and analysis configuration."""
+    path = Path(track_path)
+    try:
+        stats = path.stat()
+        mtime_ns: int | None = int(stats.st_mtime_ns)
+        size_bytes: int | None = int(stats.st_size)
+    except OSError:
+        mtime_ns = size_bytes = None
+    content_key = content_key_for_path(path, mtime_ns, size_bytes)
+    if content_key is not None:
+        return f"content:{content_key}|{params_token}"
+    return f"path:{path}|{mtime_ns}|{size_bytes}|{params_token}"
+
+
+class SqliteAnalysisLeaseStore:
+    """Claims, renews, and releases analysis leases in the cache database."""
+
+    def __init__(
+        self,
+        db_path: Path,
+        *,
+        ttl_s: float = LEASE_TTL_S,
+        owner: str | None = None,
+        clock: Callable[[], float] = time.time,
+    ) -> None:
+        self._db_path = Path(db_path)
+        self._ttl_s = max(1.0, float(ttl_s))
+        self._host = socket.gethostname()
+        self._owner = owner or f"{self._host}:{os.getpid()}:{uuid.uuid4().hex[:8]}"
+        self._clock = clock
+
+    @property
+    def owner(self) -> str:
+        return self._owner
+
+    async def initialize(self) -> None:
+        await run_db(self._initialize_sync)
+
+    async def acquire(self, lease_key: str) -> bool:
+        """Claim or renew ``lease_key``; ``False`` while another owner holds it."""
+        return await run_db(self._acquire_sync, lease_key)
+
+    async def release(self, lease_key: str) -> None:
+        await run_db(self._release_sync, lease_key)
+
+    def _connect(self) -> sqlite3.Connection:
+        return connect_analysis_cache(self._db_path)
+
+    def _initialize_sync(self) -> None:
+        with self._connect() as conn:
+            conn.execute(
+                """
+                CREATE TABLE IF NOT EXISTS analysis_leases (
+                    lease_key TEXT PRIMARY KEY,
+                    owner TEXT NOT NULL,
+                    expires_at REAL NOT NULL
+                )
+                """
+            )
+
+    def _acquire_sync(self, lease_key: str) -> bool:
+        def _op() -> bool:
+            now = self._clock()
+            with self._connect() as conn:
+                conn.execute("BEGIN IMMEDIATE")
+                row = conn.execute(
+                    "SELECT owner, expires_at FROM analysis_leases WHERE lease_key = ?",
+                    (lease_key,),
+                ).fetchone()
+                if row is not None:
+                    holder = str(row["owner"])
+                    live = float(row["expires_at"]) > now and self._owner_alive(holder)
+                    if holder != self._owner and live:
+                        return False
+                conn.execute(
+                    """
+                    INSERT INTO analysis_leases (lease_key, owner, expires_at)
+                    VALUES (?, ?, ?)
+                    ON CONFLICT(lease_key) DO UPDATE SET
+                        owner = excluded.owner,
+                        expires_at = excluded.expires_at
+                    """,
+                    (lease_key, self._owner, now + self._ttl_s),
+                )
+                # Expired rows from any owner are only bookkeeping; drop them.
+                conn.execute(
+                    "DELETE FROM analysis_leases WHERE expires_at <= ?", (now,)
+                )
+                return True
+
+        return run_with_sqlite_lock_retry(_op, op_name="analysis_lease.acquire")
+
+    def _release_sync(self, lease_key: str) -> None:
+        def _op() -> None:
+            with self._connect() as conn:
+                conn.execute(
+                    "DELETE FROM analysis_leases WHERE lease_key = ? AND owner = ?",
+                    (lease_key, self._owner),
+                )
+
+        run_with_sqlite_lock_retry(_op, op_name="analysis_lease.release")
+
+    def _owner_alive(self, owner: str) -> bool:
+        """Return ``False`` only for a same-host owner whose PID has exited."""
+        host, _sep, rest = owner.rpartition(":")[0].rpartition(":")
+        if os.name == "nt" or host != self._host:
+            return True
+        try:
+            pid = int(rest)
+        except ValueError:
+            return True
+        try:
+            os.kill(pid, 0)
+        except ProcessLookupError:
+            return False
+        except OSError:
+            return True
+        return True
@@ -3,9 +3,10 @@
 from __future__ import annotations
 
 import time
-from dataclasses import dataclass
+from dataclasses import dataclass, replace
 from pathlib import Path
 
+from .analysis_io import charge_opaque_read
 from .audio_beat_analysis import BeatAnalysisResult, analyze_beats_from_decoded
 from .audio_decode import decode_track_for_analysis
 from .audio_spectrum_analysis import (
@@ -13,6 +14,7 @@ from .audio_spectrum_analysis import (
     analyze_spectrum_from_decoded,
 )
 from .audio_spectrum_native_cli import (
+    NativeHelperCounters,
     analyze_track_spectrum_via_native_cli_attempt,
     get_native_spectrum_helper_config,
 )
@@ -20,6 +22,24 @@ from .audio_waveform_proxy_analysis import (
     WaveformProxyAnalysisResult,
     analyze_waveform_proxy_from_decoded,
 )
+from .native_dsp import (
+    beats_from_mono,
+    spectrum_from_mono,
+    waveform_proxy_from_stereo,
+)
+
+# Backend label for kernels run in-process from the native DSP library over
+# PCM already decoded by Python.
+_NATIVE_LIB_BACKEND = "native_lib"
+
+# Per-request frame caps. Long tracks are analyzed in segments short enough
+# that every kind fits its cap, so the caps bound memory, not coverage.
+MAX_SPECTRUM_FRAMES = 12_000
+MAX_BEAT_FRAMES = 12_000
+MAX_WAVEFORM_FRAMES = 30_000
+ANALYSIS_SEGMENT_MS = 240_000
+# A decoded window this much shorter than requested means the track ended.
+_SEGMENT_END_TOLERANCE_MS = 50
 
 
 @dataclass(frozen=True)
@@ -31,6 +51,8 @@ class AnalysisBundleResult:
     waveform_proxy: WaveformProxyAnalysisResult | None
     timings: AnalysisBundleTimings | None = None
     backend_info: AnalysisBundleBackendInfo | None = None
+    # Where the next segment starts; ``None`` once the track end was reached.
+    segment_end_ms: int | None = None
 
 
 @dataclass(frozen=True)
@@ -45,6 +67,7 @@ class AnalysisBundleTimings:
     python_decode_ms: float = 0.0
     native_helper_decode_ms: float = 0.0
     native_helper_total_ms: float = 0.0
+    native_helper_counters: NativeHelperCounters | None = None
 
 
 @dataclass(frozen=True)
@@ -67,16 +90,38 @@ def analyze_track_analysis_bundle(
     spectrum_hop_ms: int,
     beat_hop_ms: int,
     waveform_hop_ms: int,
-    max_spectrum_frames: int = 12_000,
-    max_beat_frames: int = 12_000,
-    max_waveform_frames: int = 30_000,
+    max_spectrum_frames: int = MAX_SPECTRUM_FRAMES,
+    max_beat_frames: int = MAX_BEAT_FRAMES,
+    max_waveform_frames: int = MAX_WAVEFORM_FRAMES,
     include_spectrum: bool = True,
     include_beat: bool = True,
     include_waveform_proxy: bool = True,
+    segment_start_ms: int = 0,
+    segment_ms: int | None = None,
+    spectrum_peak: float | None = None,
+    beat_peak: float | None = None,
 ) -> AnalysisBundleResult | None:
-    """Compute requested analysis outputs from one decoded track pass."""
+    """Compute requested analysis outputs from one decoded track pass.
+
+    With ``segment_ms`` only ``[segment_start_ms, segment_start_ms + segment_ms)``
+    is decoded and analyzed; frame positions stay track-relative and
+    ``segment_end_ms`` tells the caller where to continue. Later segments pass
+    the first segment's ``peak`` values back in so levels share one scale.
+    """
     if not include_spectrum and not include_beat and not include_waveform_proxy:
         return None
+    if segment_ms is not None:
+        segment_ms = max(1, int(segment_ms))
+        segment_start_ms = max(0, int(segment_start_ms))
+        max_spectrum_frames = min(
+            max_spectrum_frames, _frames_for(segment_ms, spectrum_hop_ms)
+        )
+        max_beat_frames = min(max_beat_frames, _frames_for(segment_ms, beat_hop_ms))
+        max_waveform_frames = min(
+            max_waveform_frames, _frames_for(segment_ms, waveform_hop_ms)
+        )
+    else:
+        segment_start_ms = 0
 
     bundle_start = time.perf_counter()
     native_helper_requested = False
@@ -86,14 +131,19 @@ def analyze_track_analysis_bundle(
     helper_beat_ms = 0.0
     helper_waveform_ms = 0.0
     helper_version: str | None = None
+    helper_counters: NativeHelperCounters | None = None
     used_native_spectrum = False
     helper_attempt = None
     helper_beat: BeatAnalysisResult | None = None
     helper_waveform: WaveformProxyAnalysisResult | None = None
 
     spectrum: SpectrumAnalysisResult | None = None
-    if include_spectrum:
+    # The helper always decodes from the start of the file, so it can only
+    # serve the first segment.
+    if include_spectrum and segment_start_ms == 0:
         native_helper_requested = get_native_spectrum_helper_config() is not None
+        if native_helper_requested:
+            charge_opaque_read(Path(track_path))
         helper_attempt = analyze_track_spectrum_via_native_cli_attempt(
             track_path,
             band_count=spectrum_band_count,
@@ -116,6 +166,7 @@ def analyze_track_analysis_bundle(
                 helper_waveform_ms = max(
                     0.0, helper_result.timings.waveform_proxy_ms or 0.0
                 )
+                helper_counters = helper_result.timings.counters
             helper_beat = helper_result.beat if include_beat else None
             helper_waveform = (
                 helper_result.waveform_proxy if include_waveform_proxy else None
@@ -147,6 +198,7 @@ def analyze_track_analysis_bundle(
                         if helper_result.timings is not None
                         and helper_result.timings.total_ms is not None
                         else total_ms,
+                        native_helper_counters=helper_counters,
                     ),
                     backend_info=AnalysisBundleBackendInfo(
                         analysis_backend="native_helper",
@@ -163,6 +215,7 @@ def analyze_track_analysis_bundle(
                         ),
                         native_helper_version=helper_version,
                     ),
+                    segment_end_ms=_helper_segment_end_ms(spectrum, segment_ms),
                 )
         else:
             helper_beat = None
@@ -190,7 +243,9 @@ def analyze_track_analysis_bundle(
         )
 
     decode_start = bundle_start
-    decoded = decode_track_for_analysis(Path(track_path))
+    decoded = decode_track_for_analysis(
+        Path(track_path), start_ms=segment_start_ms, max_duration_ms=segment_ms
+    )
     python_decode_ms = (time.perf_counter() - decode_start) * 1000.0
     if decoded is None:
         return None
@@ -198,33 +253,49 @@ def analyze_track_analysis_bundle(
     spectrum_ms = helper_spectrum_ms
     beat_ms = 0.0
     waveform_ms = 0.0
+    spectrum_backend: str | None = "native_helper" if used_native_spectrum else None
+    beat_backend: str | None = None
+    waveform_proxy_backend: str | None = None
     if include_spectrum and not used_native_spectrum:
-        spectrum, spectrum_ms = _timed_spectrum(
+        spectrum, spectrum_ms, spectrum_backend = _timed_spectrum(
             decoded,
             band_count=spectrum_band_count,
             hop_ms=spectrum_hop_ms,
             max_frames=max_spectrum_frames,
+            reference_peak=spectrum_peak,
         )
     beat: BeatAnalysisResult | None = None
     if include_beat and helper_beat is not None:
         beat = helper_beat
         beat_ms = helper_beat_ms
+        beat_backend = "native_helper"
     elif include_beat:
-        beat, beat_ms = _timed_beat(
+        beat, beat_ms, beat_backend = _timed_beat(
             decoded,
             hop_ms=beat_hop_ms,
             max_frames=max_beat_frames,
+            reference_peak=beat_peak,
         )
     waveform_proxy: WaveformProxyAnalysisResult | None = None
     if include_waveform_proxy and helper_waveform is not None:
         waveform_proxy = helper_waveform
         waveform_ms = helper_waveform_ms
+        waveform_proxy_backend = "native_helper"
     elif include_waveform_proxy:
-        waveform_proxy, waveform_ms = _timed_waveform_proxy(
+        waveform_proxy, waveform_ms, waveform_proxy_backend = _timed_waveform_proxy(
             decoded,
             hop_ms=waveform_hop_ms,
             max_frames=max_waveform_frames,
         )
+    segment_end_ms: int | None = None
+    if segment_ms is not None:
+        # A short window means this segment reached the end of the track.
+        if decoded.duration_ms + _SEGMENT_END_TOLERANCE_MS >= segment_ms:
+            segment_end_ms = segment_start_ms + segment_ms
+        if segment_start_ms > 0:
+            spectrum = _offset_spectrum(spectrum, segment_start_ms)
+            beat = _offset_beat(beat, segment_start_ms)
+            waveform_proxy = _offset_waveform_proxy(waveform_proxy, segment_start_ms)
     total_ms = (time.perf_counter() - bundle_start) * 1000.0
     python_work_after_helper = (include_beat and helper_beat is None) or (
         include_waveform_proxy and helper_waveform is None
@@ -237,23 +308,14 @@ def analyze_track_analysis_bundle(
         analysis_backend = "hybrid_native_spectrum_python_rest"
     elif used_native_spectrum:
         analysis_backend = "native_helper"
+    elif _NATIVE_LIB_BACKEND in (
+        spectrum_backend,
+        beat_backend,
+        waveform_proxy_backend,
+    ):
+        analysis_backend = "python_decode_native_lib"
     else:
         analysis_backend = "python"
-    spectrum_backend = (
-        "native_helper"
-        if used_native_spectrum
-        else ("python" if include_spectrum else None)
-    )
-    beat_backend = (
-        "native_helper"
-        if include_beat and helper_beat is not None
-        else ("python" if include_beat else None)
-    )
-    waveform_proxy_backend = (
-        "native_helper"
-        if include_waveform_proxy and helper_waveform is not None
-        else ("python" if include_waveform_proxy else None)
-    )
 
     return AnalysisBundleResult(
         spectrum=spectrum,
@@ -272,6 +334,7 @@ def analyze_track_analysis_bundle(
                 if used_native_spectrum
                 else 0.0
             ),
+            native_helper_counters=helper_counters if used_native_spectrum else None,
         ),
         backend_info=AnalysisBundleBackendInfo(
             analysis_backend=analysis_backend,
@@ -282,6 +345,81 @@ def analyze_track_analysis_bundle(
             native_helper_version=helper_version,
             duplicate_decode_for_mixed_bundle=duplicate_decode_for_mixed_bundle,
         ),
+        segment_end_ms=segment_end_ms,
+    )
+
+
+def analysis_segment_ms(
+    *,
+    spectrum_hop_ms: int,
+    beat_hop_ms: int,
+    waveform_hop_ms: int,
+) -> int:
+    """Return the longest segment whose frames fit every per-request cap."""
+    return max(
+        1_000,
+        min(
+            ANALYSIS_SEGMENT_MS,
+            max(10, int(spectrum_hop_ms)) * MAX_SPECTRUM_FRAMES,
+            max(10, int(beat_hop_ms)) * MAX_BEAT_FRAMES,
+            max(10, int(waveform_hop_ms)) * MAX_WAVEFORM_FRAMES,
+        ),
+    )
+
+
+def _helper_segment_end_ms(
+    spectrum: SpectrumAnalysisResult | None, segment_ms: int | None
+) -> int | None:
+    # The helper decodes the whole file, so its duration is the track length.
+    if segment_ms is None or spectrum is None or spectrum.duration_ms <= segment_ms:
+        return None
+    return segment_ms
+
+
+def _frames_for(segment_ms: int, hop_ms: int) -> int:
+    hop = max(10, int(hop_ms))
+    return max(1, -(-segment_ms // hop))
+
+
+def _offset_spectrum(
+    result: SpectrumAnalysisResult | None, offset_ms: int
+) -> SpectrumAnalysisResult | None:
+    if result is None:
+        return None
+    return replace(
+        result,
+        duration_ms=result.duration_ms + offset_ms,
+        frames=[(pos + offset_ms, bands) for pos, bands in result.frames],
+    )
+
+
+def _offset_beat(
+    result: BeatAnalysisResult | None, offset_ms: int
+) -> BeatAnalysisResult | None:
+    if result is None:
+        return None
+    return replace(
+        result,
+        duration_ms=result.duration_ms + offset_ms,
+        frames=[
+            (pos + offset_ms, strength, is_beat)
+            for pos, strength, is_beat in result.frames
+        ],
+    )
+
+
+def _offset_waveform_proxy(
+    result: WaveformProxyAnalysisResult | None, offset_ms: int
+) -> WaveformProxyAnalysisResult | None:
+    if result is None:
+        return None
+    return replace(
+        result,
+        duration_ms=result.duration_ms + offset_ms,
+        frames=[
+            (pos + offset_ms, min_l, max_l, min_r, max_r)
+            for pos, min_l, max_l, min_r, max_r in result.frames
+        ],
     )
 
 
@@ -291,15 +429,27 @@ def _timed_spectrum(
     band_count: int,
     hop_ms: int,
     max_frames: int,
-) -> tuple[SpectrumAnalysisResult | None, float]:
+    reference_peak: float | None,
+) -> tuple[SpectrumAnalysisResult | None, float, str]:
     start = time.perf_counter()
+    native = spectrum_from_mono(
+        decoded.mono_rate,
+        decoded.mono_samples,
+        band_count=band_count,
+        hop_ms=hop_ms,
+        max_frames=max_frames,
+        reference_peak=reference_peak,
+    )
+    if native is not None:
+        return native, _elapsed_ms(start), _NATIVE_LIB_BACKEND
     result = analyze_spectrum_from_decoded(
         decoded,
         band_count=band_count,
         hop_ms=hop_ms,
         max_frames=max_frames,
+        reference_peak=reference_peak,
     )
-    return result, (time.perf_counter() - start) * 1000.0
+    return result, _elapsed_ms(start), "python"
 
 
 def _timed_beat(
@@ -307,14 +457,25 @@ def _timed_beat(
     *,
     hop_ms: int,
     max_frames: int,
-) -> tuple[BeatAnalysisResult | None, float]:
+    reference_peak: float | None,
+) -> tuple[BeatAnalysisResult | None, float, str]:
     start = time.perf_counter()
+    native = beats_from_mono(
+        decoded.mono_rate,
+        decoded.mono_samples,
+        hop_ms=hop_ms,
+        max_frames=max_frames,
+        reference_peak=reference_peak,
+    )
+    if native is not None:
+        return native, _elapsed_ms(start), _NATIVE_LIB_BACKEND
     result = analyze_beats_from_decoded(
         decoded,
         hop_ms=hop_ms,
         max_frames=max_frames,
+        reference_peak=reference_peak,
     )
-    return result, (time.perf_counter() - start) * 1000.0
+    return result, _elapsed_ms(start), "python"
 
 
 def _timed_waveform_proxy(
@@ -322,11 +483,24 @@ def _timed_waveform_proxy(
     *,
     hop_ms: int,
     max_frames: int,
-) -> tuple[WaveformProxyAnalysisResult | None, float]:
+) -> tuple[WaveformProxyAnalysisResult | None, float, str]:
     start = time.perf_counter()
+    native = waveform_proxy_from_stereo(
+        decoded.stereo_rate,
+        decoded.left_samples,
+        decoded.right_samples,
+        hop_ms=hop_ms,
+        max_frames=max_frames,
+    )
+    if native is not None:
+        return native, _elapsed_ms(start), _NATIVE_LIB_BACKEND
     result = analyze_waveform_proxy_from_decoded(
         decoded,
         hop_ms=hop_ms,
         max_frames=max_frames,
     )
-    return result, (time.perf_counter() - start) * 1000.0
+    return result, _elapsed_ms(start), "python"
+
+
+def _elapsed_ms(start: float) -> float:
+    return (time.perf_counter() - start) * 1000.0
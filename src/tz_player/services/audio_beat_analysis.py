@@ -16,6 +16,8 @@ class BeatAnalysisResult:
     duration_ms: int
     bpm: float
     frames: list[tuple[int, int, bool]]
+    # Onset strength that maps to full scale; reused by later segments.
+    peak: float = 0.0
 
 
 def analyze_track_beats(
@@ -41,6 +43,7 @@ def analyze_beats_from_decoded(
     *,
     hop_ms: int = 40,
     max_frames: int = 12_000,
+    reference_peak: float | None = None,
 ) -> BeatAnalysisResult | None:
     """Compute beat timeline from decoded mono samples."""
     return analyze_beats_from_mono(
@@ -48,6 +51,7 @@ def analyze_beats_from_decoded(
         decoded.mono_samples,
         hop_ms=hop_ms,
         max_frames=max_frames,
+        reference_peak=reference_peak,
     )
 
 
@@ -57,8 +61,13 @@ def analyze_beats_from_mono(
     *,
     hop_ms: int = 40,
     max_frames: int = 12_000,
+    reference_peak: float | None = None,
 ) -> BeatAnalysisResult | None:
-    """Compute beat timeline from mono samples."""
+    """Compute beat timeline from mono samples.
+
+    Strengths are scaled by the strongest onset unless ``reference_peak``
+    supplies the scale of an earlier segment.
+    """
     if sample_rate <= 0 or not mono_samples:
         return None
     hop_ms = max(10, int(hop_ms))
@@ -77,7 +86,10 @@ def analyze_beats_from_mono(
         return None
 
     onsets = _onset_envelope(energies)
-    max_onset = max(onsets) if onsets else 0.0
+    if reference_peak is not None and reference_peak > 0.0:
+        max_onset = float(reference_peak)
+    else:
+        max_onset = max(onsets) if onsets else 0.0
     if max_onset <= 0.0:
         strengths = [0.0 for _ in onsets]
     else:
@@ -97,7 +109,9 @@ def analyze_beats_from_mono(
     duration_ms = int((len(mono_samples) * 1000) / sample_rate)
     if not frames:
         return None
-    return BeatAnalysisResult(duration_ms=max(1, duration_ms), bpm=bpm, frames=frames)
+    return BeatAnalysisResult(
+        duration_ms=max(1, duration_ms), bpm=bpm, frames=frames, peak=max_onset
+    )
 
 
 def _rms_energy(values: list[float]) -> float:
@@ -8,6 +8,15 @@ import subprocess
 import wave
 from dataclasses import dataclass
 from pathlib import Path
+from typing import BinaryIO
+
+from .analysis_io import (
+    READ_CHUNK_BYTES,
+    advise_dontneed,
+    advise_sequential,
+    analysis_io_budget,
+    charge_opaque_read,
+)
 
 _MONO_TARGET_RATE = 11_025
 _STEREO_TARGET_RATE = 44_100
@@ -26,17 +35,29 @@ class DecodedAnalysisAudio:
     right_samples: list[float]
 
 
-def decode_track_for_analysis(track_path: Path | str) -> DecodedAnalysisAudio | None:
-    """Decode media into mono (11.025k) and stereo (44.1k-ish) analysis streams."""
+def decode_track_for_analysis(
+    track_path: Path | str,
+    *,
+    start_ms: int = 0,
+    max_duration_ms: int | None = None,
+) -> DecodedAnalysisAudio | None:
+    """Decode media into mono (11.025k) and stereo (44.1k-ish) analysis streams.
+
+    ``start_ms``/``max_duration_ms`` bound the decode to one window of the track
+    so long files can be analyzed segment by segment.
+    """
     path = Path(track_path)
     if not path.exists() or not path.is_file():
         return None
+    start_ms = max(0, int(start_ms))
+    if max_duration_ms is not None:
+        max_duration_ms = max(1, int(max_duration_ms))
 
-    decoded = _decode_wave(path)
+    decoded = _decode_wave(path, start_ms, max_duration_ms)
     if decoded is None:
         if path.suffix.lower() in _WAVE_SUFFIXES:
             return None
-        decoded = _decode_ffmpeg(path)
+        decoded = _decode_ffmpeg(path, start_ms, max_duration_ms)
     if decoded is None:
         return None
 
@@ -74,15 +95,38 @@ def decode_track_for_analysis(track_path: Path | str) -> DecodedAnalysisAudio |
     )
 
 
-def _decode_wave(path: Path) -> tuple[int, list[float], list[float]] | None:
+def _decode_wave(
+    path: Path, start_ms: int = 0, max_duration_ms: int | None = None
+) -> tuple[int, list[float], list[float]] | None:
     try:
-        with wave.open(str(path), "rb") as handle:
+        with open(path, "rb", buffering=READ_CHUNK_BYTES) as raw_file:
+            advise_sequential(raw_file.fileno())
+            try:
+                return _read_wave(raw_file, start_ms, max_duration_ms)
+            finally:
+                advise_dontneed(raw_file.fileno())
+    except OSError:
+        return None
+
+
+def _read_wave(
+    raw_file: BinaryIO, start_ms: int, max_duration_ms: int | None
+) -> tuple[int, list[float], list[float]] | None:
+    try:
+        with wave.open(raw_file, "rb") as handle:
             channels = int(handle.getnchannels())
             frame_rate = int(handle.getframerate())
             sample_width = int(handle.getsampwidth())
             if channels <= 0 or frame_rate <= 0 or sample_width <= 0:
                 return None
-            raw = handle.readframes(handle.getnframes())
+            total_frames = int(handle.getnframes())
+            start_frame = min(total_frames, (start_ms * frame_rate) // 1000)
+            frame_count = total_frames - start_frame
+            if max_duration_ms is not None:
+                frame_count = min(frame_count, (max_duration_ms * frame_rate) // 1000)
+            if start_frame > 0:
+                handle.setpos(start_frame)
+            raw = _read_frames_budgeted(handle, frame_count, channels * sample_width)
             left, right = _pcm_to_stereo(
                 raw,
                 channels=channels,
@@ -95,16 +139,42 @@ def _decode_wave(path: Path) -> tuple[int, list[float], list[float]] | None:
         return None
 
 
-def _decode_ffmpeg(path: Path) -> tuple[int, list[float], list[float]] | None:
+def _read_frames_budgeted(
+    handle: wave.Wave_read, frame_count: int, frame_bytes: int
+) -> bytes:
+    """Read frames in large chunks, pacing each against the analysis budget."""
+    budget = analysis_io_budget()
+    chunk_frames = max(1, READ_CHUNK_BYTES // max(1, frame_bytes))
+    chunks: list[bytes] = []
+    remaining = frame_count
+    while remaining > 0:
+        chunk = handle.readframes(min(chunk_frames, remaining))
+        if not chunk:
+            break
+        budget.consume(len(chunk))
+        chunks.append(chunk)
+        remaining -= len(chunk) // max(1, frame_bytes)
+    return b"".join(chunks)
+
+
+def _decode_ffmpeg(
+    path: Path, start_ms: int = 0, max_duration_ms: int | None = None
+) -> tuple[int, list[float], list[float]] | None:
     ffmpeg_bin = shutil.which("ffmpeg")
     if ffmpeg_bin is None:
         return None
+    # Input-side -ss seeks before decoding, so late segments skip the prefix.
+    seek = ["-ss", f"{start_ms / 1000.0:.3f}"] if start_ms > 0 else []
+    limit = ["-t", f"{max_duration_ms / 1000.0:.3f}"] if max_duration_ms else []
+    charge_opaque_read(path, max_duration_ms=max_duration_ms)
     cmd = [
         ffmpeg_bin,
         "-v",
         "error",
+        *seek,
         "-i",
         str(path),
+        *limit,
         "-vn",
         "-sn",
         "-dn",
@@ -11,6 +11,8 @@ from dataclasses import dataclass
 from functools import lru_cache
 from pathlib import Path
 
+from .native_dsp import EnvelopeAccumulator
+
 logger = logging.getLogger(__name__)
 
 _FFMPEG_SAMPLE_RATE = 44_100
@@ -139,6 +141,10 @@ def _analyze_ffmpeg(path: Path, *, bucket_ms: int) -> EnvelopeAnalysisResult | N
         )
         if proc.stdout is None:
             return None
+        native = EnvelopeAccumulator(
+            channels=_FFMPEG_CHANNELS, bucket_frames=bucket_frames
+        )
+        use_native = native.available()
         points: list[tuple[int, float, float]] = []
         buffer = bytearray()
         left_sum = 0.0
@@ -156,6 +162,19 @@ def _analyze_ffmpeg(path: Path, *, bucket_ms: int) -> EnvelopeAnalysisResult | N
                 continue
             frame_chunk = bytes(buffer[:aligned_bytes])
             del buffer[:aligned_bytes]
+            native_levels = native.feed(frame_chunk) if use_native else None
+            if native_levels is not None:
+                for left_level, right_level in native_levels:
+                    points.append(
+                        (
+                            int((bucket_start * 1000) / _FFMPEG_SAMPLE_RATE),
+                            left_level,
+                            right_level,
+                        )
+                    )
+                    bucket_start += bucket_frames
+                total_frames += aligned_bytes // frame_bytes
+                continue
             for left_raw, right_raw in struct.iter_unpack("<hh", frame_chunk):
                 left_sum += abs(left_raw) / 32768.0
                 right_sum += abs(right_raw) / 32768.0
@@ -173,6 +192,11 @@ def _analyze_ffmpeg(path: Path, *, bucket_ms: int) -> EnvelopeAnalysisResult | N
                     left_sum = 0.0
                     right_sum = 0.0
                     bucket_count = 0
+        tail = native.flush() if use_native else None
+        if tail is not None:
+            points.append(
+                (int((bucket_start * 1000) / _FFMPEG_SAMPLE_RATE), tail[0], tail[1])
+            )
         if bucket_count > 0:
             points.append(
                 (
@@ -202,6 +226,12 @@ def _levels_from_pcm(
     frames = len(raw) // bytes_per_frame
     if frames <= 0:
         return (0.0, 0.0), 0
+    if sample_width == 2:
+        native_levels = EnvelopeAccumulator(
+            channels=channels, bucket_frames=frames
+        ).feed(raw[: frames * bytes_per_frame])
+        if native_levels:
+            return native_levels[0], frames
     left_sum = 0.0
     right_sum = 0.0
     max_value = _sample_max(sample_width)
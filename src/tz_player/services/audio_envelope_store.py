@@ -9,10 +9,19 @@ import os
 import sqlite3
 from pathlib import Path
 
+from tz_player.services.analysis_cache_db import (
+    connect_analysis_cache,
+    prepare_analysis_cache_db,
+)
+from tz_player.services.analysis_content_key import (
+    AnalysisEntryKey,
+    ensure_content_key_schema,
+    find_entry_id,
+)
 from tz_player.services.audio_level_service import EnvelopeLevelProvider
 from tz_player.services.playback_backend import LevelSample
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 
 class SqliteEnvelopeStore(EnvelopeLevelProvider):
@@ -32,7 +41,7 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
         self._bucket_ms = max(10, int(bucket_ms))
 
     async def initialize(self) -> None:
-        await run_blocking(self._initialize_sync)
+        await run_db(self._initialize_sync)
 
     async def upsert_envelope(
         self,
@@ -41,39 +50,45 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
         *,
         duration_ms: int,
     ) -> None:
-        await run_blocking(
-            self._upsert_envelope_sync, Path(track_path), points, duration_ms
-        )
+        await run_db(self._upsert_envelope_sync, Path(track_path), points, duration_ms)
 
     async def get_level_at(
         self, track_path: str, position_ms: int
     ) -> LevelSample | None:
-        return await run_blocking(
-            self._get_level_at_sync, Path(track_path), position_ms
-        )
+        return await run_db(self._get_level_at_sync, Path(track_path), position_ms)
 
     async def list_levels(
         self, track_path: Path | str
     ) -> list[tuple[int, float, float]]:
-        return await run_blocking(self._list_levels_sync, Path(track_path))
+        return await run_db(self._list_levels_sync, Path(track_path))
 
     async def has_envelope(self, track_path: Path | str) -> bool:
-        return await run_blocking(self._has_envelope_sync, Path(track_path))
+        return await run_db(self._has_envelope_sync, Path(track_path))
 
     async def touch_envelope_access(self, track_path: Path | str) -> None:
-        await run_blocking(self._touch_envelope_access_sync, Path(track_path))
+        await run_db(self._touch_envelope_access_sync, Path(track_path))
 
     def _connect(self) -> sqlite3.Connection:
         """Create SQLite connection configured for envelope lookups/writes."""
-        conn = sqlite3.connect(self._db_path, timeout=30)
-        conn.row_factory = sqlite3.Row
-        conn.execute("PRAGMA foreign_keys=ON")
-        return conn
+        return connect_analysis_cache(self._db_path)
+
+    def _entry_key(self, track_path: Path) -> AnalysisEntryKey:
+        mtime_ns, size_bytes = _stat_path(track_path)
+        return AnalysisEntryKey(
+            analysis_type=self.ANALYSIS_TYPE,
+            track_path=track_path,
+            path_norm=_normalize_path(track_path),
+            mtime_ns=mtime_ns,
+            size_bytes=size_bytes,
+            analysis_version=self._analysis_version,
+            params_hash=_params_hash(_params_json(self._bucket_ms)),
+        )
 
     def _initialize_sync(self) -> None:
         """Create scalar-analysis cache tables/indexes when missing."""
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
         with self._connect() as conn:
+            prepare_analysis_cache_db(conn)
             conn.execute(
                 """
                 CREATE TABLE IF NOT EXISTS analysis_cache_entries (
@@ -109,6 +124,7 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_cache_lookup ON analysis_cache_entries(analysis_type, path_norm, analysis_version, params_hash)"
             )
+            ensure_content_key_schema(conn)
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_scalar_pos ON analysis_scalar_frames(entry_id, position_ms)"
             )
@@ -122,10 +138,8 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
         """Replace cached envelope and points for track fingerprint."""
         if not points:
             return
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
+        key = self._entry_key(track_path)
         params_json = _params_json(self._bucket_ms)
-        params_hash = _params_hash(params_json)
         normalized_points = [
             (
                 max(0, int(position_ms)),
@@ -145,6 +159,7 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
                     path_norm,
                     mtime_ns,
                     size_bytes,
+                    content_key,
                     analysis_version,
                     params_hash,
                     params_json,
@@ -153,9 +168,10 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
                     byte_size,
                     computed_at,
                     last_accessed_at
-                ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
+                ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
                 ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
                 DO UPDATE SET
+                    content_key = excluded.content_key,
                     params_json = excluded.params_json,
                     duration_ms = excluded.duration_ms,
                     frame_count = excluded.frame_count,
@@ -164,42 +180,22 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
                     last_accessed_at = excluded.last_accessed_at
                 """,
                     (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        mtime_ns,
-                        size_bytes,
-                        self._analysis_version,
-                        params_hash,
+                        key.analysis_type,
+                        key.path_norm,
+                        key.mtime_ns,
+                        key.size_bytes,
+                        key.content_key,
+                        key.analysis_version,
+                        key.params_hash,
                         params_json,
                         max(1, int(duration_ms)),
                         len(normalized_points),
                         len(normalized_points) * 24,
                     ),
                 )
-                row = conn.execute(
-                    """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                    (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        self._analysis_version,
-                        params_hash,
-                        mtime_ns,
-                        size_bytes,
-                    ),
-                ).fetchone()
-                if row is None:
+                entry_id = find_entry_id(conn, key)
+                if entry_id is None:
                     return
-                entry_id = int(row["id"])
                 conn.execute(
                     "DELETE FROM analysis_scalar_frames WHERE entry_id = ?",
                     (entry_id,),
@@ -225,34 +221,11 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
         self, track_path: Path, position_ms: int
     ) -> LevelSample | None:
         """Lookup and interpolate envelope level at requested playback position."""
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(self._bucket_ms))
+        key = self._entry_key(track_path)
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return None
-            entry_id = int(row["id"])
             pos = max(0, int(position_ms))
             prev_row = conn.execute(
                 """
@@ -301,60 +274,26 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
             )
 
     def _touch_envelope_access_sync(self, track_path: Path) -> None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(self._bucket_ms))
+        key = self._entry_key(track_path)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return
             conn.execute(
                 """
                 UPDATE analysis_cache_entries
                 SET last_accessed_at = strftime('%s','now')
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
+                WHERE id = ?
                 """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                (entry_id,),
             )
 
     def _list_levels_sync(self, track_path: Path) -> list[tuple[int, float, float]]:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(self._bucket_ms))
+        key = self._entry_key(track_path)
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return []
-            entry_id = int(row["id"])
             points = conn.execute(
                 """
                 SELECT position_ms, level_left, level_right
@@ -375,35 +314,14 @@ class SqliteEnvelopeStore(EnvelopeLevelProvider):
 
     def _has_envelope_sync(self, track_path: Path) -> bool:
         """Return whether valid envelope cache exists for current file fingerprint."""
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(self._bucket_ms))
+        key = self._entry_key(track_path)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return False
             row = conn.execute(
-                """
-                SELECT 1
-                FROM analysis_cache_entries AS e
-                WHERE e.analysis_type = ?
-                  AND e.path_norm = ?
-                  AND e.analysis_version = ?
-                  AND e.params_hash = ?
-                  AND e.mtime_ns IS ?
-                  AND e.size_bytes IS ?
-                  AND EXISTS (
-                      SELECT 1
-                      FROM analysis_scalar_frames AS p
-                      WHERE p.entry_id = e.id
-                  )
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                "SELECT 1 FROM analysis_scalar_frames WHERE entry_id = ? LIMIT 1",
+                (entry_id,),
             ).fetchone()
             return row is not None
 
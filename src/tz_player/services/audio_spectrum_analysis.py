@@ -10,6 +10,13 @@ from .audio_decode import DecodedAnalysisAudio, decode_track_for_analysis
 
 _MIN_FREQ_HZ = 40.0
 _MAX_FREQ_HZ = 5_000.0
+# Octave decimation: each level halves the sample rate. A band moves down a
+# level only while it stays below this fraction of that level's rate, clear of
+# the half-band filter's transition region.
+_MAX_OCTAVE_DEPTH = 6
+_OCTAVE_BAND_LIMIT = 0.35
+_MIN_OCTAVE_WINDOW = 32
+_HALF_BAND_HALF_LENGTH = 7
 
 
 @dataclass(frozen=True)
@@ -18,6 +25,9 @@ class SpectrumAnalysisResult:
 
     duration_ms: int
     frames: list[tuple[int, bytes]]
+    # Magnitude that maps to full scale; later segments reuse it so levels
+    # stay continuous across segment seams.
+    peak: float = 0.0
 
 
 def analyze_track_spectrum(
@@ -46,6 +56,7 @@ def analyze_spectrum_from_decoded(
     band_count: int = 48,
     hop_ms: int = 40,
     max_frames: int = 12_000,
+    reference_peak: float | None = None,
 ) -> SpectrumAnalysisResult | None:
     """Compute quantized log-spaced spectrum frames from decoded mono samples."""
     return analyze_spectrum_from_mono(
@@ -54,6 +65,7 @@ def analyze_spectrum_from_decoded(
         band_count=band_count,
         hop_ms=hop_ms,
         max_frames=max_frames,
+        reference_peak=reference_peak,
     )
 
 
@@ -64,8 +76,13 @@ def analyze_spectrum_from_mono(
     band_count: int = 48,
     hop_ms: int = 40,
     max_frames: int = 12_000,
+    reference_peak: float | None = None,
 ) -> SpectrumAnalysisResult | None:
-    """Compute quantized log-spaced spectrum frames from mono samples."""
+    """Compute quantized log-spaced spectrum frames from mono samples.
+
+    Levels are scaled by the loudest magnitude analyzed unless
+    ``reference_peak`` supplies the scale of an earlier segment.
+    """
     if sample_rate <= 0 or not mono_samples:
         return None
     band_count = max(8, int(band_count))
@@ -74,34 +91,50 @@ def analyze_spectrum_from_mono(
     hop_samples = max(1, int(sample_rate * (hop_ms / 1000.0)))
     window_size = _window_size(hop_samples)
     freqs = _log_frequencies(band_count, sample_rate)
-    hann_weights = _hann_weights(window_size)
-    goertzel_coeffs = _goertzel_coeffs(sample_rate, freqs, window_size)
+    levels = _octave_levels(sample_rate, freqs, hop_samples, window_size)
+    signals = [mono_samples]
+    while len(signals) <= levels[-1].depth:
+        signals.append(_half_band_decimate(signals[-1]))
 
     magnitudes: list[list[float]] = []
     frame_positions: list[int] = []
-    window_buffer = [0.0] * window_size
-    windowed_buffer = [0.0] * window_size
+    window_buffers = [[0.0] * level.window_size for level in levels]
+    windowed_buffers = [[0.0] * level.window_size for level in levels]
     total_samples = len(mono_samples)
     for frame_count, start in enumerate(range(0, total_samples, hop_samples)):
         if frame_count >= max_frames:
             break
         frame_positions.append(int((start * 1000) / sample_rate))
-        _fill_window_buffer(
-            mono_samples,
-            start,
-            window_size,
-            total_samples,
-            window_buffer,
-        )
-        _apply_hann_window_inplace(window_buffer, hann_weights, windowed_buffer)
-        magnitudes.append(_frame_magnitudes(windowed_buffer, goertzel_coeffs))
+        # Every octave's window is centred on the full-rate window's centre.
+        center = start + (window_size // 2)
+        row = [0.0] * band_count
+        for level, window_buffer, windowed_buffer in zip(
+            levels, window_buffers, windowed_buffers
+        ):
+            signal = signals[level.depth]
+            _fill_window_buffer(
+                signal,
+                (center >> level.depth) - (level.window_size // 2),
+                level.window_size,
+                len(signal),
+                window_buffer,
+            )
+            _apply_hann_window_inplace(window_buffer, level.hann, windowed_buffer)
+            for band_idx, coeff in zip(level.band_indices, level.coeffs):
+                row[band_idx] = _goertzel_power_with_coeff(
+                    windowed_buffer, coeff, level.power_scale
+                )
+        magnitudes.append(row)
 
     if not magnitudes:
         return None
 
-    max_mag = max(max(row) for row in magnitudes)
-    if max_mag <= 0.0:
-        max_mag = 1.0
+    if reference_peak is not None and reference_peak > 0.0:
+        max_mag = float(reference_peak)
+    else:
+        max_mag = max(max(row) for row in magnitudes)
+        if max_mag <= 0.0:
+            max_mag = 1.0
 
     frames: list[tuple[int, bytes]] = []
     for idx, row in enumerate(magnitudes):
@@ -111,7 +144,109 @@ def analyze_spectrum_from_mono(
     duration_ms = int((len(mono_samples) * 1000) / sample_rate)
     if not frames:
         return None
-    return SpectrumAnalysisResult(duration_ms=max(1, duration_ms), frames=frames)
+    return SpectrumAnalysisResult(
+        duration_ms=max(1, duration_ms), frames=frames, peak=max_mag
+    )
+
+
+@dataclass(frozen=True)
+class _OctaveLevel:
+    """Bands analyzed at one decimation depth with a shared window."""
+
+    depth: int
+    window_size: int
+    band_indices: tuple[int, ...]
+    coeffs: tuple[float, ...]
+    hann: list[float]
+    power_scale: float
+
+
+def _octave_levels(
+    sample_rate: int,
+    freqs: list[float],
+    hop_samples: int,
+    base_window: int,
+) -> list[_OctaveLevel]:
+    """Assign bands to the lowest sample rate that still contains them.
+
+    Depth 0 keeps the full-rate window. Deeper levels size their window for
+    roughly one Goertzel bin per band (constant-Q) while still spanning the
+    hop, and their power is rescaled to the depth-0 window length so bands
+    stay comparable.
+    """
+    depths = [_band_depth(sample_rate, freq) for freq in freqs]
+    q = 1.0
+    if len(freqs) > 1 and freqs[1] > freqs[0]:
+        q = freqs[0] / (freqs[1] - freqs[0])
+    levels: list[_OctaveLevel] = []
+    for depth in sorted(set(depths)):
+        band_indices = tuple(idx for idx, d in enumerate(depths) if d == depth)
+        rate = sample_rate / (1 << depth)
+        if depth == 0:
+            window = base_window
+        else:
+            lowest = min(freqs[idx] for idx in band_indices)
+            needed = max(
+                math.ceil((2 * hop_samples) / (1 << depth)),
+                math.ceil((q * rate) / lowest),
+                _MIN_OCTAVE_WINDOW,
+            )
+            window = 1
+            while window < needed:
+                window <<= 1
+            window = min(base_window, window)
+        levels.append(
+            _OctaveLevel(
+                depth=depth,
+                window_size=window,
+                band_indices=band_indices,
+                coeffs=tuple(
+                    _goertzel_coeffs(
+                        int(rate), [freqs[idx] for idx in band_indices], window
+                    )
+                ),
+                hann=_hann_weights(window),
+                power_scale=(base_window / window) ** 2,
+            )
+        )
+    return levels
+
+
+def _band_depth(sample_rate: int, freq_hz: float) -> int:
+    depth = 0
+    while depth < _MAX_OCTAVE_DEPTH and freq_hz < _OCTAVE_BAND_LIMIT * sample_rate / (
+        1 << (depth + 1)
+    ):
+        depth += 1
+    return depth
+
+
+def _half_band_taps(half_length: int) -> tuple[float, list[tuple[int, float]]]:
+    """Hann-windowed sinc half-band low-pass: centre tap plus odd offsets."""
+    odd: list[tuple[int, float]] = []
+    for offset in range(1, half_length + 1, 2):
+        x = offset / 2.0
+        sinc = math.sin(math.pi * x) / (math.pi * x)
+        weight = 0.5 + 0.5 * math.cos(math.pi * offset / (half_length + 1))
+        odd.append((offset, 0.5 * sinc * weight))
+    gain = 0.5 + 2.0 * sum(tap for _offset, tap in odd)
+    return 0.5 / gain, [(offset, tap / gain) for offset, tap in odd]
+
+
+_HALF_BAND_CENTER, _HALF_BAND_ODD_TAPS = _half_band_taps(_HALF_BAND_HALF_LENGTH)
+
+
+def _half_band_decimate(samples: list[float]) -> list[float]:
+    """Low-pass below a quarter of the rate, then keep every other sample."""
+    pad = _HALF_BAND_HALF_LENGTH
+    padded = [0.0] * pad + samples + [0.0] * pad
+    out: list[float] = []
+    for idx in range(pad, pad + len(samples), 2):
+        acc = _HALF_BAND_CENTER * padded[idx]
+        for offset, tap in _HALF_BAND_ODD_TAPS:
+            acc += tap * (padded[idx - offset] + padded[idx + offset])
+        out.append(acc)
+    return out
 
 
 def _window_size(hop_samples: int) -> int:
@@ -161,8 +296,12 @@ def _fill_window_buffer(
     total_samples: int,
     out: list[float],
 ) -> None:
-    end = min(total_samples, start + window_size)
     copied = 0
+    while start < 0 and copied < window_size:
+        out[copied] = 0.0
+        copied += 1
+        start += 1
+    end = min(total_samples, start + window_size - copied)
     for sample_idx in range(start, end):
         out[copied] = source[sample_idx]
         copied += 1
@@ -171,13 +310,6 @@ def _fill_window_buffer(
         copied += 1
 
 
-def _frame_magnitudes(
-    window: list[float],
-    coeffs: list[float],
-) -> list[float]:
-    return [_goertzel_power_with_coeff(window, coeff) for coeff in coeffs]
-
-
 def _goertzel_coeffs(
     sample_rate: int, freqs: list[float], sample_count: int
 ) -> list[float]:
@@ -210,7 +342,9 @@ def _goertzel_power(samples: list[float], sample_rate: int, freq_hz: float) -> f
     return math.log1p(power)
 
 
-def _goertzel_power_with_coeff(samples: list[float], coeff: float) -> float:
+def _goertzel_power_with_coeff(
+    samples: list[float], coeff: float, scale: float = 1.0
+) -> float:
     if not samples:
         return 0.0
     s_prev = 0.0
@@ -222,7 +356,7 @@ def _goertzel_power_with_coeff(samples: list[float], coeff: float) -> float:
     power = (s_prev2 * s_prev2) + (s_prev * s_prev) - (coeff * s_prev * s_prev2)
     if power <= 0.0:
         return 0.0
-    return math.log1p(power)
+    return math.log1p(power * scale)
 
 
 def _quantize_level(normalized: float) -> int:
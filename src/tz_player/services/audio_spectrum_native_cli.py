@@ -13,6 +13,7 @@ from dataclasses import dataclass
 from pathlib import Path
 from typing import Any
 
+from ..utils.platform_utils import normalize_machine
 from .audio_beat_analysis import BeatAnalysisResult
 from .audio_spectrum_analysis import SpectrumAnalysisResult
 from .audio_waveform_proxy_analysis import WaveformProxyAnalysisResult
@@ -20,6 +21,15 @@ from .audio_waveform_proxy_analysis import WaveformProxyAnalysisResult
 NATIVE_SPECTRUM_HELPER_CMD_ENV = "TZ_PLAYER_NATIVE_SPECTRUM_HELPER_CMD"
 NATIVE_SPECTRUM_HELPER_TIMEOUT_ENV = "TZ_PLAYER_NATIVE_SPECTRUM_HELPER_TIMEOUT_S"
 NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV = "TZ_PLAYER_USE_BUNDLED_NATIVE_SPECTRUM_HELPER"
+NATIVE_HELPER_PERF_COUNTERS_ENV = "TZ_PLAYER_HELPER_PERF_COUNTERS"
+NATIVE_HELPER_COUNTER_NAMES = (
+    "cycles",
+    "instructions",
+    "ipc",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses",
+)
 _DEFAULT_HELPER_TIMEOUT_S = 8.0
 _MONO_TARGET_RATE_HZ = 11_025
 _REQUEST_SCHEMA = "tz_player.native_spectrum_helper_request.v1"
@@ -47,6 +57,20 @@ class NativeSpectrumHelperTimingBreakdown:
     beat_ms: float | None
     waveform_proxy_ms: float | None
     total_ms: float | None
+    counters: NativeHelperCounters | None = None
+
+
+@dataclass(frozen=True)
+class NativeHelperCounters:
+    """Helper-reported hardware counters per pipeline stage.
+
+    ``stages`` maps a stage name (decode, resample, spectrum, beat,
+    waveform_proxy, serialize) to ``ms`` plus `NATIVE_HELPER_COUNTER_NAMES`;
+    counters the host does not expose are ``None``.
+    """
+
+    available: bool
+    stages: dict[str, dict[str, float | None]]
 
 
 @dataclass(frozen=True)
@@ -141,7 +165,7 @@ def get_bundled_native_spectrum_helper_config(
 def _bundled_native_spectrum_helper_path() -> Path | None:
     """Resolve packaged helper path for current platform/architecture."""
     platform_name = sys.platform
-    machine = _normalize_machine(platform.machine())
+    machine = normalize_machine(platform.machine())
     rel = _PLATFORM_TO_NATIVE_HELPER.get((platform_name, machine))
     if rel is None:
         return None
@@ -151,13 +175,6 @@ def _bundled_native_spectrum_helper_path() -> Path | None:
     return candidate
 
 
-def _normalize_machine(machine: str) -> str:
-    normalized = machine.lower()
-    if normalized in {"x86_64", "amd64", "x64"}:
-        return "x86_64"
-    return normalized
-
-
 def analyze_track_spectrum_via_native_cli(
     track_path: Path | str,
     *,
@@ -227,6 +244,9 @@ def analyze_track_spectrum_via_native_cli_attempt(
         # Duplicate these with unique top-level keys for simple/naive helper parsers.
         request_payload["beat_timeline_hop_ms"] = int(beat_hop_ms)
         request_payload["beat_timeline_max_frames"] = int(max_beat_frames)
+    values = os.environ if env is None else env
+    if _parse_bool(values.get(NATIVE_HELPER_PERF_COUNTERS_ENV, "")):
+        request_payload["perf_counters"] = 1
     try:
         proc = subprocess.run(
             list(config.argv),
@@ -301,7 +321,11 @@ def _parse_helper_response(payload: object) -> NativeSpectrumHelperResult | None
         helper_version = None
 
     return NativeSpectrumHelperResult(
-        spectrum=SpectrumAnalysisResult(duration_ms=duration_ms, frames=frames),
+        spectrum=SpectrumAnalysisResult(
+            duration_ms=duration_ms,
+            frames=frames,
+            peak=_parse_peak(payload.get("peak")),
+        ),
         beat=_parse_beat(payload.get("beat")),
         waveform_proxy=_parse_waveform_proxy(payload.get("waveform_proxy")),
         timings=timings,
@@ -343,6 +367,25 @@ def _parse_timings(raw_timings: object) -> NativeSpectrumHelperTimingBreakdown |
         beat_ms=_coerce_optional_float(raw_timings.get("beat_ms")),
         waveform_proxy_ms=_coerce_optional_float(raw_timings.get("waveform_proxy_ms")),
         total_ms=_coerce_optional_float(raw_timings.get("total_ms")),
+        counters=_parse_counters(raw_timings.get("counters")),
+    )
+
+
+def _parse_counters(raw_counters: object) -> NativeHelperCounters | None:
+    if not isinstance(raw_counters, dict):
+        return None
+    raw_stages = raw_counters.get("stages")
+    stages: dict[str, dict[str, float | None]] = {}
+    if isinstance(raw_stages, dict):
+        for name, raw_stage in raw_stages.items():
+            if not isinstance(name, str) or not isinstance(raw_stage, dict):
+                continue
+            stages[name] = {
+                key: _coerce_optional_float(raw_stage.get(key))
+                for key in ("ms", *NATIVE_HELPER_COUNTER_NAMES)
+            }
+    return NativeHelperCounters(
+        available=raw_counters.get("available") is True, stages=stages
     )
 
 
@@ -375,7 +418,19 @@ def _parse_beat(raw_beat: object) -> BeatAnalysisResult | None:
         if strength_u8 < 0 or strength_u8 > 255:
             return None
         frames.append((pos_ms, strength_u8, is_beat))
-    return BeatAnalysisResult(duration_ms=duration_ms, bpm=float(bpm), frames=frames)
+    return BeatAnalysisResult(
+        duration_ms=duration_ms,
+        bpm=float(bpm),
+        frames=frames,
+        peak=_parse_peak(raw_beat.get("peak")),
+    )
+
+
+def _parse_peak(raw_peak: object) -> float:
+    # Older helpers omit the scale; 0.0 lets later segments derive their own.
+    if isinstance(raw_peak, bool) or not isinstance(raw_peak, (int, float)):
+        return 0.0
+    return max(0.0, float(raw_peak))
 
 
 def _parse_waveform_proxy(raw_waveform: object) -> WaveformProxyAnalysisResult | None:
@@ -9,12 +9,20 @@ from collections.abc import Awaitable, Callable
 from dataclasses import dataclass
 from typing import Literal, Protocol
 
-from .beat_store import BeatFrame, BeatParams
+from .analysis_availability import AnalysisAvailabilityIndex
+from .beat_store import BeatFrame, BeatParams, SqliteBeatStore
 
 BeatSource = Literal["cache", "fallback"]
 BeatStatus = Literal["ready", "loading", "missing", "error"]
 logger = logging.getLogger(__name__)
 
+# Upcoming onsets published per reading. Enough to cover a slow poll interval
+# at fast tempos without republishing the schedule on every tick.
+ONSET_SCHEDULE_SIZE = 8
+# Onsets this far behind the sampled position stay in the schedule so a render
+# frame that has not reached them yet can still fire them.
+ONSET_SCHEDULE_LOOKBEHIND_MS = 250
+
 
 class BeatProvider(Protocol):
     """Protocol for persisted beat frame lookup by track position."""
@@ -43,6 +51,7 @@ class BeatReading:
     bpm: float
     source: BeatSource
     status: BeatStatus
+    upcoming_onsets_ms: tuple[int, ...] = ()
 
 
 class BeatService:
@@ -53,12 +62,15 @@ class BeatService:
         *,
         cache_provider: BeatProvider,
         schedule_analysis: Callable[[str, BeatParams], Awaitable[None]] | None = None,
+        availability: AnalysisAvailabilityIndex | None = None,
     ) -> None:
         self._cache_provider = cache_provider
         self._schedule_analysis = schedule_analysis
+        self._availability = availability
         self._last_touch_s: dict[str, float] = {}
         self._touch_interval_s = 15.0
         self._frame_cache: dict[str, tuple[list[int], list[BeatFrame]]] = {}
+        self._onset_cache: dict[str, list[int]] = {}
         self._stats_memory_hits = 0
         self._stats_db_hits = 0
         self._stats_misses = 0
@@ -95,6 +107,35 @@ class BeatService:
                 bpm=max(0.0, cached.bpm),
                 source="cache",
                 status="ready",
+                upcoming_onsets_ms=self.upcoming_onsets(
+                    track_path, params=params, position_ms=position_ms
+                ),
+            )
+
+        known = (
+            self._availability.state(track_path, SqliteBeatStore.ANALYSIS_TYPE, params)
+            if self._availability is not None
+            else None
+        )
+        if known == "pending":
+            self._stats_loading += 1
+            self._maybe_log_stats()
+            return BeatReading(
+                strength=0.0,
+                is_beat=False,
+                bpm=0.0,
+                source="fallback",
+                status="loading",
+            )
+        if known == "failed":
+            self._stats_misses += 1
+            self._maybe_log_stats()
+            return BeatReading(
+                strength=0.0,
+                is_beat=False,
+                bpm=0.0,
+                source="fallback",
+                status="missing",
             )
 
         frame = await self._cache_provider.get_frame_at(
@@ -136,17 +177,27 @@ class BeatService:
             status="missing",
         )
 
-    async def preload_track(self, track_path: str, *, params: BeatParams) -> int:
+    async def preload_track(
+        self, track_path: str, *, params: BeatParams, start_ms: int = 0
+    ) -> int:
+        """Load frames into memory; ``start_ms`` splices in a newly stored segment."""
         if not track_path:
             return 0
         key = f"{track_path}|{params.hop_ms}"
-        if key in self._frame_cache:
-            return len(self._frame_cache[key][0])
+        cached = self._frame_cache.get(key)
+        if cached is not None and start_ms <= 0:
+            return len(cached[0])
         list_frames = getattr(self._cache_provider, "list_frames", None)
         if list_frames is None or not callable(list_frames):
             return 0
+        if start_ms > 0 and cached is None:
+            # Nothing in memory to extend; the next full preload picks it up.
+            return 0
         try:
-            frames = await list_frames(track_path, params=params)
+            if start_ms > 0:
+                frames = await list_frames(track_path, params=params, start_ms=start_ms)
+            else:
+                frames = await list_frames(track_path, params=params)
         except Exception:
             return 0
         if not frames:
@@ -160,20 +211,55 @@ class BeatService:
             )
             for frame in frames
         ]
+        if cached is not None and start_ms > 0:
+            keep = bisect_left(cached[0], start_ms)
+            del cached[0][keep:], cached[1][keep:]
+            cached[0].extend(frame.position_ms for frame in normalized)
+            cached[1].extend(normalized)
+            self._onset_cache[key] = [
+                frame.position_ms for frame in cached[1] if frame.is_beat
+            ]
+            return len(cached[0])
         self._frame_cache.clear()
         self._frame_cache[key] = (
             [frame.position_ms for frame in normalized],
             normalized,
         )
+        self._onset_cache.clear()
+        self._onset_cache[key] = [
+            frame.position_ms for frame in normalized if frame.is_beat
+        ]
         return len(normalized)
 
+    def upcoming_onsets(
+        self,
+        track_path: str,
+        *,
+        params: BeatParams,
+        position_ms: int,
+        limit: int = ONSET_SCHEDULE_SIZE,
+    ) -> tuple[int, ...]:
+        """Return the next preloaded onset timestamps at or after ``position_ms``.
+
+        Includes onsets up to ``ONSET_SCHEDULE_LOOKBEHIND_MS`` in the past so
+        render-side schedulers can still fire onsets the last poll skipped over.
+        """
+        onsets = self._onset_cache.get(f"{track_path}|{params.hop_ms}")
+        if not onsets or limit <= 0:
+            return ()
+        start = max(0, int(position_ms) - ONSET_SCHEDULE_LOOKBEHIND_MS)
+        idx = bisect_left(onsets, start)
+        return tuple(onsets[idx : idx + limit])
+
     def clear_track_cache(self, track_path: str | None = None) -> None:
         if track_path is None:
             self._frame_cache.clear()
+            self._onset_cache.clear()
             return
         stale = [key for key in self._frame_cache if key.startswith(f"{track_path}|")]
         for key in stale:
             self._frame_cache.pop(key, None)
+            self._onset_cache.pop(key, None)
 
     async def _touch_access_if_due(self, track_path: str, params: BeatParams) -> None:
         key = f"{track_path}|{params.hop_ms}"
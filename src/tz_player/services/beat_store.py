@@ -9,8 +9,24 @@ import sqlite3
 from dataclasses import dataclass
 from pathlib import Path
 
+from tz_player.services.analysis_cache_db import (
+    begin_segment_write,
+    complete_segment_entry,
+    connect_analysis_cache,
+    ensure_segment_schema,
+    entry_covered_ms,
+    entry_norm_peak,
+    extend_segment_entry,
+    finish_segment_write,
+    prepare_analysis_cache_db,
+)
+from tz_player.services.analysis_content_key import (
+    AnalysisEntryKey,
+    ensure_content_key_schema,
+    find_entry_id,
+)
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 
 @dataclass(frozen=True)
@@ -40,7 +56,7 @@ class SqliteBeatStore:
         self._analysis_version = analysis_version
 
     async def initialize(self) -> None:
-        await run_blocking(self._initialize_sync)
+        await run_db(self._initialize_sync)
 
     async def upsert_beats(
         self,
@@ -50,18 +66,42 @@ class SqliteBeatStore:
         params: BeatParams,
         bpm: float,
         frames: list[tuple[int, int, bool]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
+        norm_peak: float | None = None,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._upsert_beats_sync,
             Path(track_path),
             duration_ms,
             params,
             bpm,
             frames,
+            segment_start_ms,
+            covered_ms,
+            norm_peak,
         )
 
     async def has_beats(self, track_path: Path | str, *, params: BeatParams) -> bool:
-        return await run_blocking(self._has_beats_sync, Path(track_path), params)
+        return await run_db(self._has_beats_sync, Path(track_path), params)
+
+    async def beat_resume_ms(
+        self, track_path: Path | str, *, params: BeatParams
+    ) -> int | None:
+        """Return where a partially analyzed entry stops, ``None`` if complete."""
+        return await run_db(self._resume_ms_sync, Path(track_path), params)
+
+    async def complete_beats(
+        self, track_path: Path | str, *, params: BeatParams
+    ) -> None:
+        """Mark a partial entry complete when the track ended at its last segment."""
+        await run_db(self._complete_sync, Path(track_path), params)
+
+    async def beat_norm_peak(
+        self, track_path: Path | str, *, params: BeatParams
+    ) -> float | None:
+        """Return the full-scale level later segments of an entry must reuse."""
+        return await run_db(self._norm_peak_sync, Path(track_path), params)
 
     async def get_frame_at(
         self,
@@ -70,7 +110,7 @@ class SqliteBeatStore:
         position_ms: int,
         params: BeatParams,
     ) -> BeatFrame | None:
-        return await run_blocking(
+        return await run_db(
             self._get_frame_at_sync,
             Path(track_path),
             position_ms,
@@ -82,8 +122,9 @@ class SqliteBeatStore:
         track_path: Path | str,
         *,
         params: BeatParams,
+        start_ms: int = 0,
     ) -> list[BeatFrame]:
-        return await run_blocking(self._list_frames_sync, Path(track_path), params)
+        return await run_db(self._list_frames_sync, Path(track_path), params, start_ms)
 
     async def touch_beat_access(
         self,
@@ -91,21 +132,31 @@ class SqliteBeatStore:
         *,
         params: BeatParams,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._touch_beat_access_sync,
             Path(track_path),
             params,
         )
 
     def _connect(self) -> sqlite3.Connection:
-        conn = sqlite3.connect(self._db_path, timeout=30)
-        conn.row_factory = sqlite3.Row
-        conn.execute("PRAGMA foreign_keys=ON")
-        return conn
+        return connect_analysis_cache(self._db_path)
+
+    def _entry_key(self, track_path: Path, params: BeatParams) -> AnalysisEntryKey:
+        mtime_ns, size_bytes = _stat_path(track_path)
+        return AnalysisEntryKey(
+            analysis_type=self.ANALYSIS_TYPE,
+            track_path=track_path,
+            path_norm=_normalize_path(track_path),
+            mtime_ns=mtime_ns,
+            size_bytes=size_bytes,
+            analysis_version=self._analysis_version,
+            params_hash=_params_hash(_params_json(params)),
+        )
 
     def _initialize_sync(self) -> None:
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
         with self._connect() as conn:
+            prepare_analysis_cache_db(conn)
             conn.execute(
                 """
                 CREATE TABLE IF NOT EXISTS analysis_cache_entries (
@@ -143,6 +194,8 @@ class SqliteBeatStore:
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_cache_lookup ON analysis_cache_entries(analysis_type, path_norm, analysis_version, params_hash)"
             )
+            ensure_content_key_schema(conn)
+            ensure_segment_schema(conn)
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_beat_pos ON analysis_beat_frames(entry_id, position_ms)"
             )
@@ -154,6 +207,9 @@ class SqliteBeatStore:
         params: BeatParams,
         bpm: float,
         frames: list[tuple[int, int, bool]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
+        norm_peak: float | None = None,
     ) -> None:
         if not frames:
             return
@@ -161,80 +217,66 @@ class SqliteBeatStore:
             (max(0, int(position_ms)), _clamp_u8(strength_u8), int(bool(is_beat)))
             for position_ms, strength_u8, is_beat in frames
         ]
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
+        key = self._entry_key(track_path, params)
         params_json = _params_json(params)
-        params_hash = _params_hash(params_json)
         total_bytes = len(normalized_frames) * 24
         bpm_value = max(0.0, float(bpm))
 
         def _op() -> None:
             with self._connect() as conn:
                 conn.execute("BEGIN IMMEDIATE")
-                conn.execute(
-                    """
-                INSERT INTO analysis_cache_entries (
-                    analysis_type,
-                    path_norm,
-                    mtime_ns,
-                    size_bytes,
-                    analysis_version,
-                    params_hash,
-                    params_json,
-                    duration_ms,
-                    frame_count,
-                    byte_size,
-                    computed_at,
-                    last_accessed_at
-                ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
-                ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
-                DO UPDATE SET
-                    params_json = excluded.params_json,
-                    duration_ms = excluded.duration_ms,
-                    frame_count = excluded.frame_count,
-                    byte_size = excluded.byte_size,
-                    computed_at = excluded.computed_at,
-                    last_accessed_at = excluded.last_accessed_at
-                """,
-                    (
-                        self.ANALYSIS_TYPE,
+                # Later segments extend the entry earlier segments created, even
+                # when it was found through the content key.
+                entry_id = find_entry_id(conn, key) if segment_start_ms > 0 else None
+                if entry_id is not None:
+                    extend_segment_entry(conn, entry_id, duration_ms)
+                else:
+                    conn.execute(
+                        """
+                    INSERT INTO analysis_cache_entries (
+                        analysis_type,
                         path_norm,
                         mtime_ns,
                         size_bytes,
-                        self._analysis_version,
+                        content_key,
+                        analysis_version,
                         params_hash,
                         params_json,
-                        max(1, int(duration_ms)),
-                        len(normalized_frames),
-                        total_bytes,
-                    ),
-                )
-                row = conn.execute(
-                    """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                    (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        self._analysis_version,
-                        params_hash,
-                        mtime_ns,
-                        size_bytes,
-                    ),
-                ).fetchone()
-                if row is None:
-                    return
-                entry_id = int(row["id"])
-                conn.execute(
-                    "DELETE FROM analysis_beat_frames WHERE entry_id = ?", (entry_id,)
+                        duration_ms,
+                        frame_count,
+                        byte_size,
+                        computed_at,
+                        last_accessed_at
+                    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
+                    ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
+                    DO UPDATE SET
+                        content_key = excluded.content_key,
+                        params_json = excluded.params_json,
+                        duration_ms = excluded.duration_ms,
+                        frame_count = excluded.frame_count,
+                        byte_size = excluded.byte_size,
+                        computed_at = excluded.computed_at,
+                        last_accessed_at = excluded.last_accessed_at
+                    """,
+                        (
+                            key.analysis_type,
+                            key.path_norm,
+                            key.mtime_ns,
+                            key.size_bytes,
+                            key.content_key,
+                            key.analysis_version,
+                            key.params_hash,
+                            params_json,
+                            max(1, int(duration_ms)),
+                            len(normalized_frames),
+                            total_bytes,
+                        ),
+                    )
+                    entry_id = find_entry_id(conn, key)
+                    if entry_id is None:
+                        return
+                first_idx = begin_segment_write(
+                    conn, "analysis_beat_frames", entry_id, segment_start_ms
                 )
                 conn.executemany(
                     """
@@ -250,43 +292,58 @@ class SqliteBeatStore:
                     [
                         (entry_id, idx, position_ms, strength_u8, is_beat, bpm_value)
                         for idx, (position_ms, strength_u8, is_beat) in enumerate(
-                            normalized_frames
+                            normalized_frames, start=first_idx
                         )
                     ],
                 )
+                finish_segment_write(
+                    conn,
+                    "analysis_beat_frames",
+                    entry_id,
+                    segment_start_ms=segment_start_ms,
+                    covered_ms=covered_ms,
+                    norm_peak=norm_peak,
+                    byte_size_sql="COUNT(*) * 24",
+                )
 
         run_with_sqlite_lock_retry(_op, op_name="beat.upsert")
 
+    def _resume_ms_sync(self, track_path: Path, params: BeatParams) -> int | None:
+        key = self._entry_key(track_path, params)
+        with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            return entry_covered_ms(conn, entry_id)
+
+    def _complete_sync(self, track_path: Path, params: BeatParams) -> None:
+        key = self._entry_key(track_path, params)
+
+        def _op() -> None:
+            with self._connect() as conn:
+                entry_id = find_entry_id(conn, key)
+                if entry_id is not None:
+                    complete_segment_entry(conn, entry_id)
+
+        run_with_sqlite_lock_retry(_op, op_name="beat.complete")
+
+    def _norm_peak_sync(self, track_path: Path, params: BeatParams) -> float | None:
+        key = self._entry_key(track_path, params)
+        with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            return entry_norm_peak(conn, entry_id)
+
     def _has_beats_sync(self, track_path: Path, params: BeatParams) -> bool:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return False
             row = conn.execute(
-                """
-                SELECT 1
-                FROM analysis_cache_entries AS e
-                WHERE e.analysis_type = ?
-                  AND e.path_norm = ?
-                  AND e.analysis_version = ?
-                  AND e.params_hash = ?
-                  AND e.mtime_ns IS ?
-                  AND e.size_bytes IS ?
-                  AND EXISTS (
-                      SELECT 1
-                      FROM analysis_beat_frames AS f
-                      WHERE f.entry_id = e.id
-                  )
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                "SELECT 1 FROM analysis_beat_frames WHERE entry_id = ? LIMIT 1",
+                (entry_id,),
             ).fetchone()
             return row is not None
 
@@ -296,35 +353,12 @@ class SqliteBeatStore:
         position_ms: int,
         params: BeatParams,
     ) -> BeatFrame | None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         pos = max(0, int(position_ms))
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return None
-            entry_id = int(row["id"])
             prev_row = conn.execute(
                 """
                 SELECT position_ms, strength_u8, is_beat, bpm
@@ -356,44 +390,21 @@ class SqliteBeatStore:
             )
 
     def _list_frames_sync(
-        self, track_path: Path, params: BeatParams
+        self, track_path: Path, params: BeatParams, start_ms: int = 0
     ) -> list[BeatFrame]:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return []
-            entry_id = int(row["id"])
             rows = conn.execute(
                 """
                 SELECT position_ms, strength_u8, is_beat, bpm
                 FROM analysis_beat_frames
-                WHERE entry_id = ?
+                WHERE entry_id = ? AND position_ms >= ?
                 ORDER BY position_ms ASC
                 """,
-                (entry_id,),
+                (entry_id, max(0, int(start_ms))),
             ).fetchall()
             return [
                 BeatFrame(
@@ -410,29 +421,18 @@ class SqliteBeatStore:
         track_path: Path,
         params: BeatParams,
     ) -> None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return
             conn.execute(
                 """
                 UPDATE analysis_cache_entries
                 SET last_accessed_at = strftime('%s','now')
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
+                WHERE id = ?
                 """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                (entry_id,),
             )
 
 
@@ -48,6 +48,7 @@ class FakePlaybackBackend:
         self._lock = asyncio.Lock()
         self._stop_event = asyncio.Event()
         self._task: asyncio.Task[None] | None = None
+        self.preloaded_path: str | None = None
 
     def set_event_handler(
         self, handler: Callable[[BackendEvent], Awaitable[None]]
@@ -91,6 +92,9 @@ class FakePlaybackBackend:
         )
         await self._emit(StateChanged("playing"))
 
+    async def preload(self, track_path: str) -> None:
+        self.preloaded_path = track_path
+
     async def toggle_pause(self) -> None:
         async with self._lock:
             if self._state.status == "playing":
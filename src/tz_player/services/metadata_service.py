@@ -16,7 +16,7 @@ from tz_player.services.playlist_store import (
     TrackMetaSnapshot,
     TrackRecord,
 )
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import Lane, executor_lane, run_blocking
 
 logger = logging.getLogger(__name__)
 
@@ -30,7 +30,13 @@ class FileStat:
 
 
 class MetadataService:
-    """Loads track metadata on-demand with bounded concurrency."""
+    """Loads track metadata on-demand with bounded concurrency.
+
+    `hydrate` keeps a viewport-driven work queue: each call replaces the queued
+    track ids with a new priority order, so rows that scrolled away are dropped
+    before their reads start and newly visible rows go first. Visible rows read
+    on the interactive executor lane; look-ahead rows on the prefetch lane.
+    """
 
     def __init__(
         self,
@@ -45,6 +51,40 @@ class MetadataService:
         self._concurrency = concurrency
         self._semaphore: asyncio.Semaphore | None = None
         self._on_metadata_updated = on_metadata_updated
+        self._hydration_queue: list[int] = []
+        self._hydration_prefetch: set[int] = set()
+        self._hydration_inflight: set[int] = set()
+        self._hydration_workers: set[asyncio.Task[None]] = set()
+
+    def hydrate(
+        self, track_ids: list[int], *, prefetch_ids: list[int] | None = None
+    ) -> None:
+        """Replace queued hydration work with ``track_ids`` in priority order.
+
+        ``prefetch_ids`` (rows the user is scrolling toward) queue after
+        ``track_ids`` at prefetch priority. Queued ids missing from both are
+        cancelled; reads already in flight finish and persist since their cost
+        is already paid.
+        """
+        ordered = _unique_ids([*track_ids, *(prefetch_ids or [])])
+        visible = set(track_ids)
+        self._hydration_queue = [
+            track_id for track_id in ordered if track_id not in self._hydration_inflight
+        ]
+        self._hydration_prefetch = {
+            track_id for track_id in self._hydration_queue if track_id not in visible
+        }
+        while len(self._hydration_workers) < self._concurrency and len(
+            self._hydration_workers
+        ) < len(self._hydration_queue):
+            task = asyncio.create_task(self._hydration_worker())
+            self._hydration_workers.add(task)
+            task.add_done_callback(self._hydration_workers.discard)
+
+    @property
+    def pending_hydration(self) -> list[int]:
+        """Return queued (not yet started) hydration ids in priority order."""
+        return list(self._hydration_queue)
 
     async def ensure_metadata(self, track_ids: list[int]) -> None:
         """Ensure metadata is loaded for given tracks with bounded concurrency."""
@@ -69,6 +109,34 @@ class MetadataService:
         if updated_ids and self._on_metadata_updated is not None:
             await self._on_metadata_updated(updated_ids)
 
+    async def _hydration_worker(self) -> None:
+        while self._hydration_queue:
+            track_id = self._hydration_queue.pop(0)
+            lane: Lane = (
+                "prefetch" if track_id in self._hydration_prefetch else "interactive"
+            )
+            self._hydration_inflight.add(track_id)
+            try:
+                with executor_lane(lane):
+                    await self._hydrate_one(track_id)
+            except Exception as exc:  # pragma: no cover - safety net
+                logger.exception("Metadata hydration failed for %s: %s", track_id, exc)
+            finally:
+                self._hydration_inflight.discard(track_id)
+            # Report every finished id, not just valid reads: failures are
+            # persisted too, and the requester tracks outstanding ids by this.
+            if self._on_metadata_updated is not None:
+                await self._on_metadata_updated([track_id])
+
+    async def _hydrate_one(self, track_id: int) -> None:
+        tracks = await self._store.get_tracks_basic([track_id])
+        if not tracks:
+            return
+        snapshot = await self._store.get_track_meta_snapshot([track_id])
+        if _meta_is_fresh(snapshot.get(track_id)):
+            return
+        await self._load_one(tracks[0])
+
     async def invalidate_if_changed(self, track_id: int) -> bool:
         """Invalidate cached metadata if file fingerprint differs from stored state."""
         records = await self._store.get_tracks_basic([track_id])
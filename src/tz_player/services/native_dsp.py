@@ -0,0 +1,349 @@
+"""In-process native DSP kernels loaded from ``libtz_player_native`` via ctypes.
+
+The shared library is built from the same C source as the native helper CLI
+(``tools/tz_player_native_helper.c`` with ``-DTZ_PLAYER_NATIVE_LIBRARY``) and
+exports spectrum, beat, waveform-proxy, and envelope kernels over plain
+buffers. Analysis paths that already hold PCM (decoded by `audio_decode`, which
+also handles segment windows) call these directly instead of paying for a
+subprocess, JSON round-trip, and second decode. Every entry point
+returns ``None`` when the library is unavailable so callers keep their Python
+fallbacks.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import logging
+import os
+import platform
+import sys
+from array import array
+from collections.abc import Mapping, Sequence
+from functools import lru_cache
+from pathlib import Path
+
+from ..utils.platform_utils import normalize_machine
+from .audio_beat_analysis import BeatAnalysisResult
+from .audio_spectrum_analysis import SpectrumAnalysisResult
+from .audio_waveform_proxy_analysis import WaveformProxyAnalysisResult
+
+logger = logging.getLogger(__name__)
+
+NATIVE_DSP_LIB_ENV = "TZ_PLAYER_NATIVE_DSP_LIB"
+NATIVE_DSP_DISABLE_ENV = "TZ_PLAYER_DISABLE_NATIVE_DSP"
+_ABI_VERSION = 2
+_MONO_TARGET_RATE_HZ = 11_025
+# Mirrors the C-side caps so output buffers are never undersized.
+_MAX_BAND_COUNT = 96
+_MAX_SPECTRUM_FRAMES = 20_000
+_MAX_BEAT_FRAMES = 30_000
+_MAX_WAVEFORM_FRAMES = 30_000
+_PLATFORM_TO_NATIVE_DSP_LIB: dict[tuple[str, str], str] = {
+    ("linux", "x86_64"): "linux/x86_64/libtz_player_native.so",
+    ("win32", "x86_64"): "windows/x86_64/tz_player_native.dll",
+}
+
+
+def native_dsp_available(env: Mapping[str, str] | None = None) -> bool:
+    """Return whether the native DSP library loads under ``env``."""
+    values = os.environ if env is None else env
+    return (
+        _native_lib(
+            values.get(NATIVE_DSP_DISABLE_ENV, ""),
+            values.get(NATIVE_DSP_LIB_ENV, ""),
+        )
+        is not None
+    )
+
+
+def spectrum_from_mono(
+    sample_rate: int,
+    mono_samples: Sequence[float],
+    *,
+    band_count: int,
+    hop_ms: int,
+    max_frames: int,
+    reference_peak: float | None = None,
+) -> SpectrumAnalysisResult | None:
+    """Compute quantized spectrum frames from mono samples.
+
+    ``reference_peak`` fixes the full-scale magnitude, as in the Python kernel.
+    """
+    lib = _active_lib()
+    if lib is None or sample_rate <= 0 or not mono_samples:
+        return None
+    if not 0 < band_count <= _MAX_BAND_COUNT or max_frames <= 0:
+        return None
+    capacity = min(max_frames, _MAX_SPECTRUM_FRAMES)
+    samples = _float_buffer(mono_samples)
+    positions = array("i", bytes(4 * capacity))
+    bands = ctypes.create_string_buffer(capacity * band_count)
+    peak = ctypes.c_float()
+    count = lib.tzn_spectrum(
+        samples.buffer_info()[0],
+        len(samples),
+        sample_rate,
+        hop_ms,
+        band_count,
+        capacity,
+        max(0.0, reference_peak or 0.0),
+        positions.buffer_info()[0],
+        bands,
+        ctypes.byref(peak),
+    )
+    if count <= 0:
+        return None
+    raw = bands.raw
+    frames = [
+        (positions[idx], raw[idx * band_count : (idx + 1) * band_count])
+        for idx in range(count)
+    ]
+    return SpectrumAnalysisResult(
+        duration_ms=_duration_ms(len(samples), sample_rate),
+        frames=frames,
+        peak=peak.value,
+    )
+
+
+def beats_from_mono(
+    sample_rate: int,
+    mono_samples: Sequence[float],
+    *,
+    hop_ms: int,
+    max_frames: int,
+    reference_peak: float | None = None,
+) -> BeatAnalysisResult | None:
+    """Compute beat strength/onset timeline and BPM from mono samples."""
+    lib = _active_lib()
+    if lib is None or sample_rate <= 0 or not mono_samples or max_frames <= 0:
+        return None
+    capacity = min(max_frames, _MAX_BEAT_FRAMES)
+    samples = _float_buffer(mono_samples)
+    positions = array("i", bytes(4 * capacity))
+    strength = ctypes.create_string_buffer(capacity)
+    is_beat = ctypes.create_string_buffer(capacity)
+    bpm = ctypes.c_double()
+    peak = ctypes.c_double()
+    count = lib.tzn_beat(
+        samples.buffer_info()[0],
+        len(samples),
+        sample_rate,
+        hop_ms,
+        capacity,
+        max(0.0, reference_peak or 0.0),
+        positions.buffer_info()[0],
+        strength,
+        is_beat,
+        ctypes.byref(bpm),
+        ctypes.byref(peak),
+    )
+    if count <= 0:
+        return None
+    strength_raw = strength.raw
+    beat_raw = is_beat.raw
+    frames = [
+        (positions[idx], strength_raw[idx], bool(beat_raw[idx])) for idx in range(count)
+    ]
+    return BeatAnalysisResult(
+        duration_ms=_duration_ms(len(samples), sample_rate),
+        bpm=max(0.0, bpm.value),
+        frames=frames,
+        peak=peak.value,
+    )
+
+
+def waveform_proxy_from_stereo(
+    sample_rate: int,
+    left_samples: Sequence[float],
+    right_samples: Sequence[float],
+    *,
+    hop_ms: int,
+    max_frames: int,
+) -> WaveformProxyAnalysisResult | None:
+    """Compute signed min/max waveform-proxy frames from stereo samples."""
+    lib = _active_lib()
+    if (
+        lib is None
+        or sample_rate <= 0
+        or not left_samples
+        or len(left_samples) != len(right_samples)
+        or max_frames <= 0
+    ):
+        return None
+    capacity = min(max_frames, _MAX_WAVEFORM_FRAMES)
+    left = _float_buffer(left_samples)
+    right = array("f", right_samples)
+    positions = array("i", bytes(4 * capacity))
+    levels = array("b", bytes(4 * capacity))
+    count = lib.tzn_waveform_proxy(
+        left.buffer_info()[0],
+        right.buffer_info()[0],
+        len(left),
+        sample_rate,
+        hop_ms,
+        capacity,
+        positions.buffer_info()[0],
+        levels.buffer_info()[0],
+    )
+    if count <= 0:
+        return None
+    frames = [
+        (
+            positions[idx],
+            levels[idx * 4],
+            levels[idx * 4 + 1],
+            levels[idx * 4 + 2],
+            levels[idx * 4 + 3],
+        )
+        for idx in range(count)
+    ]
+    return WaveformProxyAnalysisResult(
+        duration_ms=_duration_ms(len(left), sample_rate), frames=frames
+    )
+
+
+class EnvelopeAccumulator:
+    """Stream interleaved s16 PCM into mean-level buckets natively.
+
+    Buckets may span ``feed`` calls; ``flush`` returns the trailing partial
+    bucket. Results match the Python envelope analysis bit for bit.
+    """
+
+    def __init__(self, *, channels: int, bucket_frames: int) -> None:
+        self._channels = max(1, int(channels))
+        self._bucket_frames = max(1, int(bucket_frames))
+        self._carry = (ctypes.c_double * 3)()
+
+    @staticmethod
+    def available() -> bool:
+        return _active_lib() is not None
+
+    def feed(self, pcm: bytes) -> list[tuple[float, float]] | None:
+        """Consume whole frames from ``pcm``; ``None`` if native is unavailable."""
+        lib = _active_lib()
+        if lib is None:
+            return None
+        frames = len(pcm) // (2 * self._channels)
+        if frames <= 0:
+            return []
+        max_buckets = frames // self._bucket_frames + 1
+        out = (ctypes.c_double * (2 * max_buckets))()
+        written = lib.tzn_envelope_s16(
+            pcm,
+            frames,
+            self._channels,
+            self._bucket_frames,
+            self._carry,
+            out,
+            max_buckets,
+        )
+        if written < 0:
+            return None
+        return [(out[idx * 2], out[idx * 2 + 1]) for idx in range(written)]
+
+    def flush(self) -> tuple[float, float] | None:
+        left_sum, right_sum, count = self._carry
+        if count <= 0:
+            return None
+        self._carry[0] = self._carry[1] = self._carry[2] = 0.0
+        return (min(1.0, left_sum / count), min(1.0, right_sum / count))
+
+
+def _float_buffer(samples: Sequence[float]) -> array[float]:
+    if isinstance(samples, array) and samples.typecode == "f":
+        return samples
+    return array("f", samples)
+
+
+def _duration_ms(sample_count: int, sample_rate: int) -> int:
+    return max(1, int((sample_count * 1000) / sample_rate))
+
+
+def _active_lib() -> ctypes.CDLL | None:
+    return _native_lib(
+        os.environ.get(NATIVE_DSP_DISABLE_ENV, ""),
+        os.environ.get(NATIVE_DSP_LIB_ENV, ""),
+    )
+
+
+def _resolve_library_path(disable_raw: str, override_raw: str) -> str | None:
+    if disable_raw.strip().lower() in {"1", "true", "yes", "on"}:
+        return None
+    override = override_raw.strip()
+    if override:
+        return override
+    rel = _PLATFORM_TO_NATIVE_DSP_LIB.get(
+        (sys.platform, normalize_machine(platform.machine()))
+    )
+    if rel is None:
+        return None
+    candidate = Path(__file__).resolve().parents[1] / "binaries" / rel
+    return str(candidate) if candidate.is_file() else None
+
+
+@lru_cache(maxsize=4)
+def _native_lib(disable_raw: str, override_raw: str) -> ctypes.CDLL | None:
+    path = _resolve_library_path(disable_raw, override_raw)
+    if path is None:
+        return None
+    try:
+        lib = ctypes.CDLL(path)
+        if lib.tzn_abi_version() != _ABI_VERSION:
+            logger.warning("Native DSP library ABI mismatch at %s; ignoring.", path)
+            return None
+    except (OSError, AttributeError) as exc:
+        logger.warning("Failed to load native DSP library %s: %s", path, exc)
+        return None
+    c_int = ctypes.c_int
+    c_long = ctypes.c_long
+    c_void_p = ctypes.c_void_p
+    lib.tzn_spectrum.argtypes = [
+        c_void_p,
+        c_long,
+        c_int,
+        c_int,
+        c_int,
+        c_int,
+        ctypes.c_float,
+        c_void_p,
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_float),
+    ]
+    lib.tzn_spectrum.restype = c_int
+    lib.tzn_beat.argtypes = [
+        c_void_p,
+        c_long,
+        c_int,
+        c_int,
+        c_int,
+        ctypes.c_double,
+        c_void_p,
+        ctypes.c_char_p,
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_double),
+        ctypes.POINTER(ctypes.c_double),
+    ]
+    lib.tzn_beat.restype = c_int
+    lib.tzn_waveform_proxy.argtypes = [
+        c_void_p,
+        c_void_p,
+        c_long,
+        c_int,
+        c_int,
+        c_int,
+        c_void_p,
+        c_void_p,
+    ]
+    lib.tzn_waveform_proxy.restype = c_int
+    lib.tzn_envelope_s16.argtypes = [
+        ctypes.c_char_p,
+        c_long,
+        c_int,
+        c_int,
+        ctypes.POINTER(ctypes.c_double),
+        ctypes.POINTER(ctypes.c_double),
+        c_int,
+    ]
+    lib.tzn_envelope_s16.restype = c_int
+    logger.debug("Loaded native DSP library from %s", path)
+    return lib
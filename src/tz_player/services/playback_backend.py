@@ -65,6 +65,13 @@ class PlaybackLevelProvider(Protocol):
     async def get_level_sample(self) -> LevelSample | None: ...
 
 
+@runtime_checkable
+class PlaybackPreloader(Protocol):
+    """Optional capability protocol for preparing the next track's media."""
+
+    async def preload(self, track_path: str) -> None: ...
+
+
 class PlaybackBackend(Protocol):
     """Playback engine protocol consumed by `PlayerService`."""
 
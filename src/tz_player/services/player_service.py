@@ -13,8 +13,8 @@ import random
 import time
 from collections.abc import Awaitable
 from contextlib import suppress
-from dataclasses import dataclass, replace
-from typing import Callable, Literal
+from dataclasses import dataclass, fields, replace
+from typing import Callable, Literal, cast
 
 from tz_player.events import PlayerStateChanged, TrackChanged
 from tz_player.services.audio_level_service import (
@@ -28,6 +28,7 @@ from tz_player.services.playback_backend import (
     BackendEvent,
     MediaChanged,
     PlaybackBackend,
+    PlaybackPreloader,
     PositionUpdated,
     StateChanged,
 )
@@ -38,6 +39,8 @@ from tz_player.services.waveform_proxy_service import (
     WaveformProxyService,
 )
 from tz_player.services.waveform_proxy_store import WaveformProxyParams
+from tz_player.utils.async_utils import executor_lane
+from tz_player.utils.tick_scheduler import TickScheduler
 
 logger = logging.getLogger(__name__)
 
@@ -48,6 +51,7 @@ SPEED_MAX = 4.0
 SPEED_STEP = 0.25
 STALE_STOP_START_WINDOW_MS = 750
 TRACK_END_GRACE_MS = 300
+MEDIA_PRELOAD_DELAY_S = 1.0
 
 
 def _format_user_error(
@@ -104,9 +108,28 @@ class PlayerState:
     beat_bpm: float | None = None
     beat_source: str | None = None
     beat_status: str | None = None
+    beat_onsets_ms: tuple[int, ...] | None = None
     error: str | None = None
 
 
+_PLAYER_STATE_FIELDS = tuple(field.name for field in fields(PlayerState))
+
+
+def player_state_changes(
+    previous: PlayerState | None, current: PlayerState
+) -> frozenset[str] | None:
+    """Return names of fields that differ, or ``None`` without a baseline."""
+    if previous is None:
+        return None
+    if previous is current:
+        return frozenset()
+    return frozenset(
+        name
+        for name in _PLAYER_STATE_FIELDS
+        if getattr(previous, name) != getattr(current, name)
+    )
+
+
 class PlayerService:
     """Owns playback state and emits events to subscribers."""
 
@@ -133,6 +156,7 @@ class PlayerService:
         beat_params: BeatParams | None = None,
         should_sample_beat: Callable[[], bool] | None = None,
         poll_interval_s: float = 0.25,
+        tick_scheduler: TickScheduler | None = None,
         shuffle_random: random.Random | None = None,
         default_duration_ms: int = 180_000,
         initial_state: PlayerState | None = None,
@@ -148,10 +172,13 @@ class PlayerService:
             raise ValueError("default_duration_ms must be >= 1")
         self._default_duration_ms = default_duration_ms
         self._state = initial_state or PlayerState()
+        self._last_emitted_state: PlayerState | None = None
         self._lock = asyncio.Lock()
         self._stop_requested = False
         self._poll_task: asyncio.Task[None] | None = None
         self._poll_interval = max(0.05, min(1.0, float(poll_interval_s)))
+        self._ticks = tick_scheduler or TickScheduler()
+        self._ticks.set_playing(self._state.status == "playing")
         self._end_handled_item_id: int | None = None
         self._expecting_transition_stop: bool = False
         self._max_position_seen_ms = self._state.position_ms
@@ -175,6 +202,7 @@ class PlayerService:
         self._should_sample_beat = should_sample_beat
         self._current_track_path: str | None = None
         self._analysis_preload_task: asyncio.Task[None] | None = None
+        self._media_preload_task: asyncio.Task[None] | None = None
         self._backend.set_event_handler(self._handle_backend_event)
 
     @property
@@ -193,6 +221,7 @@ class PlayerService:
     async def shutdown(self) -> None:
         """Stop polling loop and perform best-effort backend shutdown."""
         self._cancel_analysis_preload()
+        self._cancel_media_preload()
         if self._poll_task is not None:
             self._poll_task.cancel()
             with suppress(asyncio.CancelledError):
@@ -229,6 +258,7 @@ class PlayerService:
                 beat_bpm=None,
                 beat_source=None,
                 beat_status=None,
+                beat_onsets_ms=None,
                 error=None,
             )
             # A stale manual-stop latch must never suppress natural track-end advance.
@@ -311,6 +341,7 @@ class PlayerService:
             await self._backend.set_speed(current_speed)
         await self._emit_event(TrackChanged(track_info))
         await self._emit_state()
+        self._schedule_media_preload()
 
     async def toggle_pause(self) -> None:
         async with self._lock:
@@ -349,6 +380,7 @@ class PlayerService:
                 beat_bpm=None,
                 beat_source=None,
                 beat_status=None,
+                beat_onsets_ms=None,
             )
             self._end_handled_item_id = None
             self._max_position_seen_ms = 0
@@ -363,9 +395,10 @@ class PlayerService:
         clear_track_path: str | None = None,
     ) -> None:
         self._cancel_analysis_preload(clear_track_path=clear_track_path)
-        self._analysis_preload_task = asyncio.create_task(
-            self._preload_analysis_for_track(track_path)
-        )
+        with executor_lane("playback"):
+            self._analysis_preload_task = asyncio.create_task(
+                self._preload_analysis_for_track(track_path)
+            )
         self._analysis_preload_task.add_done_callback(
             lambda _task: setattr(self, "_analysis_preload_task", None)
         )
@@ -393,6 +426,39 @@ class PlayerService:
                     clear(path_to_clear)
             self._audio_level_service.clear_envelope_cache(path_to_clear)
 
+    def _schedule_media_preload(self) -> None:
+        """Hand the predicted next track to backends that can prepare media."""
+        self._cancel_media_preload()
+        if not isinstance(self._backend, PlaybackPreloader):
+            return
+        if self._state.status != "playing":
+            return
+        with executor_lane("prefetch"):
+            self._media_preload_task = asyncio.create_task(self._preload_next_media())
+
+    def _cancel_media_preload(self) -> None:
+        task = self._media_preload_task
+        self._media_preload_task = None
+        if task is not None and not task.done():
+            task.cancel()
+
+    async def _preload_next_media(self) -> None:
+        try:
+            # Let the current track's own open settle before probing the next.
+            await asyncio.sleep(MEDIA_PRELOAD_DELAY_S)
+            playlist_id = self._state.playlist_id
+            next_item_id = await self.predict_next_item_id()
+            if playlist_id is None or next_item_id is None:
+                return
+            track_info = await self._track_info_provider(playlist_id, next_item_id)
+            if track_info is None or not track_info.path:
+                return
+            await cast(PlaybackPreloader, self._backend).preload(track_info.path)
+        except asyncio.CancelledError:
+            return
+        except Exception as exc:
+            logger.debug("Next-track media preload failed: %s", exc)
+
     async def _preload_analysis_for_track(self, track_path: str) -> None:
         start = time.monotonic()
         try:
@@ -443,9 +509,32 @@ class PlayerService:
         except asyncio.CancelledError:
             return
 
-    async def prime_analysis_memory_cache(self, track_path: str) -> None:
-        """Prime in-memory analysis caches for a specific track path."""
-        await self._preload_analysis_for_track(track_path)
+    async def prime_analysis_memory_cache(
+        self, track_path: str, *, segment_start_ms: int = 0
+    ) -> None:
+        """Prime in-memory analysis caches for a specific track path.
+
+        With ``segment_start_ms`` only frames from that position on are reloaded
+        and spliced into caches already holding the earlier segments.
+        """
+        if segment_start_ms <= 0:
+            await self._preload_analysis_for_track(track_path)
+            return
+        channels = (
+            (self._spectrum_service, self._spectrum_params),
+            (self._beat_service, self._beat_params),
+            (self._waveform_proxy_service, self._waveform_proxy_params),
+        )
+        for service, params in channels:
+            if service is None or params is None:
+                continue
+            preload = getattr(service, "preload_track", None)
+            if preload is None or not callable(preload):
+                continue
+            try:
+                await preload(track_path, params=params, start_ms=segment_start_ms)
+            except Exception:
+                continue
 
     async def seek_ratio(self, ratio: float) -> None:
         async with self._lock:
@@ -517,6 +606,7 @@ class PlayerService:
                 next_mode = "OFF"
             self._state = replace(self._state, repeat_mode=next_mode)
         await self._emit_state()
+        self._schedule_media_preload()
 
     async def toggle_shuffle(self, *, anchor_item_id: int | None = None) -> None:
         """Toggle shuffle mode and build/clear deterministic traversal order."""
@@ -531,6 +621,7 @@ class PlayerService:
         else:
             self._clear_shuffle_order()
         await self._emit_state()
+        self._schedule_media_preload()
 
     def _clear_shuffle_order(self) -> None:
         self._shuffle_order = []
@@ -857,7 +948,11 @@ class PlayerService:
         return True
 
     async def _emit_state(self) -> None:
-        await self._emit_event(PlayerStateChanged(self._state))
+        state = self._state
+        changed = player_state_changes(self._last_emitted_state, state)
+        self._last_emitted_state = state
+        self._ticks.set_playing(state.status == "playing")
+        await self._emit_event(PlayerStateChanged(state, changed))
 
     async def _poll_position(self) -> None:
         """Poll backend transport/levels and infer end-of-track in edge cases.
@@ -868,10 +963,11 @@ class PlayerService:
         """
         try:
             while True:
-                await asyncio.sleep(self._poll_interval)
+                await self._ticks.sleep("player_poll", self._poll_interval)
                 async with self._lock:
                     status = self._state.status
                 if status not in {"playing", "paused"}:
+                    await self._ticks.wait_for_playing()
                     continue
                 try:
                     (
@@ -1013,24 +1109,28 @@ class PlayerService:
                     beat_bpm: float | None
                     beat_source: str | None
                     beat_status: str | None
+                    beat_onsets_ms: tuple[int, ...] | None
                     if beat_reading is not None:
                         beat_strength = beat_reading.strength
                         beat_is_onset = beat_reading.is_beat
                         beat_bpm = beat_reading.bpm
                         beat_source = beat_reading.source
                         beat_status = beat_reading.status
+                        beat_onsets_ms = beat_reading.upcoming_onsets_ms or None
                     else:
                         beat_strength = None
                         beat_is_onset = None
                         beat_bpm = None
                         beat_source = None
                         beat_status = None
+                        beat_onsets_ms = None
                     if (
                         beat_strength != self._state.beat_strength
                         or beat_is_onset != self._state.beat_is_onset
                         or beat_bpm != self._state.beat_bpm
                         or beat_source != self._state.beat_source
                         or beat_status != self._state.beat_status
+                        or beat_onsets_ms != self._state.beat_onsets_ms
                     ):
                         self._state = replace(
                             self._state,
@@ -1039,6 +1139,7 @@ class PlayerService:
                             beat_bpm=beat_bpm,
                             beat_source=beat_source,
                             beat_status=beat_status,
+                            beat_onsets_ms=beat_onsets_ms,
                         )
                         emit = True
                     if (
@@ -1083,6 +1184,10 @@ class PlayerService:
                     await self._handle_track_end()
                 if emit:
                     await self._emit_state()
+                if status == "paused":
+                    # One pass above refreshed the paused snapshot; nothing moves
+                    # until playback resumes.
+                    await self._ticks.wait_for_playing()
         except asyncio.CancelledError:
             return
 
@@ -0,0 +1,178 @@
+"""Streaming M3U/M3U8/PLS playlist import and export.
+
+Playlist files from other players can list hundreds of thousands of entries.
+Import parses lazily and feeds `PlaylistStore.add_tracks` in fixed-size chunks;
+export writes each row as the store cursor yields it. Neither side holds the
+whole list in memory.
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import re
+from collections.abc import Generator, Iterator
+from itertools import islice
+from pathlib import Path
+from typing import TextIO
+from urllib.parse import unquote, urlparse
+
+from tz_player.media_formats import is_supported_audio_file
+from tz_player.services.playlist_store import PlaylistExportRow, PlaylistStore
+from tz_player.utils.async_utils import run_blocking
+
+logger = logging.getLogger(__name__)
+
+PLAYLIST_FILE_EXTENSIONS = frozenset({".m3u", ".m3u8", ".pls"})
+IMPORT_CHUNK_SIZE = 5_000
+
+_PLS_FILE_RE = re.compile(r"^File(\d+)=(.*)$", re.IGNORECASE)
+
+
+def is_playlist_file(path: Path) -> bool:
+    """Return whether ``path`` has an importable playlist suffix."""
+    return path.suffix.lower() in PLAYLIST_FILE_EXTENSIONS
+
+
+def iter_playlist_entries(playlist_path: Path) -> Generator[Path, None, None]:
+    """Yield supported local audio paths listed in an M3U/M3U8/PLS file.
+
+    Relative entries resolve against the playlist's folder; remote URLs and
+    unsupported suffixes are skipped.
+    """
+    base_dir = playlist_path.parent
+    is_pls = playlist_path.suffix.lower() == ".pls"
+    # Legacy .m3u files declare no encoding; surrogateescape keeps bytes that
+    # are not UTF-8 intact as POSIX path characters.
+    with playlist_path.open(
+        "r", encoding="utf-8-sig", errors="surrogateescape"
+    ) as handle:
+        for raw in handle:
+            line = raw.strip()
+            if not line:
+                continue
+            if is_pls:
+                match = _PLS_FILE_RE.match(line)
+                if match is None:
+                    continue
+                entry = match.group(2).strip()
+            elif line.startswith("#"):
+                continue
+            else:
+                entry = line
+            path = _resolve_entry(entry, base_dir)
+            if path is not None and is_supported_audio_file(path):
+                yield path
+
+
+async def import_playlist_file(
+    store: PlaylistStore,
+    playlist_id: int,
+    playlist_path: Path,
+    *,
+    chunk_size: int = IMPORT_CHUNK_SIZE,
+) -> int:
+    """Append entries of ``playlist_path`` to a playlist; return rows added."""
+    entries = iter_playlist_entries(playlist_path)
+    added = 0
+    try:
+        while True:
+            chunk = await run_blocking(_next_chunk, entries, max(1, chunk_size))
+            if not chunk:
+                break
+            added += await store.add_tracks(playlist_id, chunk)
+    finally:
+        entries.close()
+    logger.info(
+        "Imported %d playlist entries from %s",
+        added,
+        playlist_path,
+        extra={"event": "playlist_import", "added": added},
+    )
+    return added
+
+
+async def export_playlist_file(
+    store: PlaylistStore, playlist_id: int, playlist_path: Path
+) -> int:
+    """Write a playlist to M3U/M3U8/PLS by suffix; return entries written."""
+    suffix = playlist_path.suffix.lower()
+    if suffix not in PLAYLIST_FILE_EXTENSIONS:
+        raise ValueError(f"Unsupported playlist file type: {suffix or '(none)'}")
+    return await run_blocking(_export_sync, store, playlist_id, playlist_path, suffix)
+
+
+def _export_sync(
+    store: PlaylistStore, playlist_id: int, playlist_path: Path, suffix: str
+) -> int:
+    tmp_path = playlist_path.with_name(f".{playlist_path.name}.tmp")
+    rows = store.iter_export_rows(playlist_id)
+    try:
+        with tmp_path.open(
+            "w", encoding="utf-8", errors="surrogateescape", newline="\n"
+        ) as handle:
+            if suffix == ".pls":
+                count = _write_pls(handle, rows)
+            else:
+                count = _write_m3u(handle, rows)
+        os.replace(tmp_path, playlist_path)
+    except BaseException:
+        tmp_path.unlink(missing_ok=True)
+        raise
+    logger.info(
+        "Exported %d playlist entries to %s",
+        count,
+        playlist_path,
+        extra={"event": "playlist_export", "written": count},
+    )
+    return count
+
+
+def _write_m3u(handle: TextIO, rows: Iterator[PlaylistExportRow]) -> int:
+    handle.write("#EXTM3U\n")
+    count = 0
+    for row in rows:
+        seconds = row.duration_ms // 1000 if row.duration_ms else -1
+        handle.write(f"#EXTINF:{seconds},{_display_name(row)}\n{row.path}\n")
+        count += 1
+    return count
+
+
+def _write_pls(handle: TextIO, rows: Iterator[PlaylistExportRow]) -> int:
+    # NumberOfEntries may follow the entries, so the count is written last.
+    handle.write("[playlist]\n")
+    count = 0
+    for row in rows:
+        count += 1
+        seconds = row.duration_ms // 1000 if row.duration_ms else -1
+        handle.write(
+            f"File{count}={row.path}\n"
+            f"Title{count}={_display_name(row)}\n"
+            f"Length{count}={seconds}\n"
+        )
+    handle.write(f"NumberOfEntries={count}\nVersion=2\n")
+    return count
+
+
+def _display_name(row: PlaylistExportRow) -> str:
+    title = row.title or Path(row.path).stem
+    name = f"{row.artist} - {title}" if row.artist else title
+    return name.replace("\n", " ").replace("\r", " ")
+
+
+def _resolve_entry(entry: str, base_dir: Path) -> Path | None:
+    if "://" in entry:
+        parsed = urlparse(entry)
+        if parsed.scheme.lower() != "file":
+            return None
+        entry = unquote(parsed.path)
+        if os.name == "nt" and re.match(r"^/[A-Za-z]:", entry):
+            entry = entry[1:]
+    path = Path(entry)
+    if not path.is_absolute():
+        path = base_dir / path
+    return path
+
+
+def _next_chunk(entries: Iterator[Path], size: int) -> list[Path]:
+    return list(islice(entries, size))
@@ -1,7 +1,7 @@
 """SQLite-backed playlist/query layer for playlist and metadata state.
 
 The public API is async but all DB work is synchronous and dispatched through
-`run_blocking(...)` to keep the Textual event loop non-blocking.
+`run_db(...)` to keep the Textual event loop non-blocking.
 """
 
 from __future__ import annotations
@@ -11,15 +11,24 @@ import os
 import random
 import sqlite3
 import time
+from collections.abc import Iterable, Iterator
+from contextlib import closing
 from dataclasses import dataclass
 from pathlib import Path
 from typing import Literal
 
-from tz_player.db.schema import create_schema
+from tz_player.db.schema import (
+    create_schema,
+    drop_playlist_search,
+    rebuild_playlist_search,
+)
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 POS_STEP = 10_000
+# Below this many rows, per-row FTS trigger deletes beat a rebuild.
+BULK_FTS_REBUILD_MIN_ROWS = 1_000
+_EXPORT_FETCH_ROWS = 1_000
 _PERF_WARN_MS = 50.0
 logger = logging.getLogger(__name__)
 
@@ -41,6 +50,16 @@ class PlaylistRow:
     meta_error: str | None
 
 
+@dataclass(frozen=True)
+class PlaylistExportRow:
+    """Playlist entry fields written by playlist-file export."""
+
+    path: str
+    title: str | None
+    artist: str | None
+    duration_ms: int | None
+
+
 @dataclass(frozen=True)
 class TrackRecord:
     """Minimal immutable track record used for metadata refresh workflows."""
@@ -90,66 +109,58 @@ class PlaylistStore:
         self._db_path = Path(db_path)
 
     async def initialize(self) -> None:
-        await run_blocking(self._initialize_sync)
+        await run_db(self._initialize_sync)
 
     async def create_playlist(self, name: str) -> int:
-        return await run_blocking(self._create_playlist_sync, name)
+        return await run_db(self._create_playlist_sync, name)
 
     async def ensure_playlist(self, name: str) -> int:
-        return await run_blocking(self._ensure_playlist_sync, name)
+        return await run_db(self._ensure_playlist_sync, name)
 
     async def clear_playlist(self, playlist_id: int) -> None:
-        await run_blocking(self._clear_playlist_sync, playlist_id)
+        await run_db(self._clear_playlist_sync, playlist_id)
 
     async def add_tracks(self, playlist_id: int, paths: list[Path]) -> int:
-        return await run_blocking(self._add_tracks_sync, playlist_id, paths)
+        return await run_db(self._add_tracks_sync, playlist_id, paths)
 
     async def remove_items(self, playlist_id: int, item_ids: set[int]) -> int:
-        return await run_blocking(self._remove_items_sync, playlist_id, item_ids)
+        return await run_db(self._remove_items_sync, playlist_id, item_ids)
 
     async def count(self, playlist_id: int) -> int:
-        return await run_blocking(self._count_sync, playlist_id)
+        return await run_db(self._count_sync, playlist_id)
 
     async def fetch_window(
         self, playlist_id: int, offset: int, limit: int
     ) -> list[PlaylistRow]:
-        return await run_blocking(self._fetch_window_sync, playlist_id, offset, limit)
+        return await run_db(self._fetch_window_sync, playlist_id, offset, limit)
 
     async def get_item_row(self, playlist_id: int, item_id: int) -> PlaylistRow | None:
-        return await run_blocking(self._get_item_row_sync, playlist_id, item_id)
+        return await run_db(self._get_item_row_sync, playlist_id, item_id)
 
     async def fetch_rows_by_track_ids(
         self, playlist_id: int, track_ids: list[int]
     ) -> list[PlaylistRow]:
-        return await run_blocking(
-            self._fetch_rows_by_track_ids_sync, playlist_id, track_ids
-        )
+        return await run_db(self._fetch_rows_by_track_ids_sync, playlist_id, track_ids)
 
     async def fetch_rows_by_item_ids(
         self, playlist_id: int, item_ids: list[int]
     ) -> list[PlaylistRow]:
-        return await run_blocking(
-            self._fetch_rows_by_item_ids_sync, playlist_id, item_ids
-        )
+        return await run_db(self._fetch_rows_by_item_ids_sync, playlist_id, item_ids)
 
     async def search_item_ids(
         self, playlist_id: int, query: str, *, limit: int = 1000
     ) -> list[int]:
-        return await run_blocking(self._search_item_ids_sync, playlist_id, query, limit)
+        return await run_db(self._search_item_ids_sync, playlist_id, query, limit)
 
     async def get_next_item_id(
         self, playlist_id: int, item_id: int, *, wrap: bool
     ) -> int | None:
-        return await run_blocking(
-            self._get_next_item_id_sync, playlist_id, item_id, wrap
-        )
+        return await run_db(self._get_next_item_id_sync, playlist_id, item_id, wrap)
 
     async def get_prev_item_id(
         self, playlist_id: int, item_id: int, *, wrap: bool
     ) -> int | None:
-        return await run_blocking(
-            self._get_prev_item_id_sync, playlist_id, item_id, wrap
-        )
+        return await run_db(self._get_prev_item_id_sync, playlist_id, item_id, wrap)
 
     async def move_selection(
         self,
@@ -160,47 +171,77 @@ class PlaylistStore:
     ) -> None:
         if direction not in {"up", "down"}:
             raise ValueError("direction must be 'up' or 'down'")
-        await run_blocking(
+        await run_db(
             self._move_selection_sync, playlist_id, direction, selection, cursor
         )
 
     async def invalidate_metadata(self, track_ids: set[int] | None = None) -> None:
-        await run_blocking(self._invalidate_metadata_sync, track_ids)
+        await run_db(self._invalidate_metadata_sync, track_ids)
 
     async def renumber_playlist(self, playlist_id: int) -> None:
-        await run_blocking(self._renumber_playlist_sync, playlist_id)
+        await run_db(self._renumber_playlist_sync, playlist_id)
 
     async def get_track_id_for_item(self, playlist_id: int, item_id: int) -> int | None:
-        return await run_blocking(
-            self._get_track_id_for_item_sync, playlist_id, item_id
-        )
+        return await run_db(self._get_track_id_for_item_sync, playlist_id, item_id)
 
     async def get_item_index(self, playlist_id: int, item_id: int) -> int | None:
-        return await run_blocking(self._get_item_index_sync, playlist_id, item_id)
+        return await run_db(self._get_item_index_sync, playlist_id, item_id)
 
     async def list_item_ids(self, playlist_id: int) -> list[int]:
-        return await run_blocking(self._list_item_ids_sync, playlist_id)
+        return await run_db(self._list_item_ids_sync, playlist_id)
 
     async def get_random_item_id(
         self, playlist_id: int, *, exclude_item_id: int | None = None
     ) -> int | None:
-        return await run_blocking(
-            self._get_random_item_id_sync, playlist_id, exclude_item_id
-        )
+        return await run_db(self._get_random_item_id_sync, playlist_id, exclude_item_id)
 
     async def get_tracks_basic(self, track_ids: list[int]) -> list[TrackRecord]:
-        return await run_blocking(self._get_tracks_basic_sync, track_ids)
+        return await run_db(self._get_tracks_basic_sync, track_ids)
 
     async def get_track_meta_snapshot(
         self, track_ids: list[int]
     ) -> dict[int, TrackMetaSnapshot]:
-        return await run_blocking(self._get_track_meta_snapshot_sync, track_ids)
+        return await run_db(self._get_track_meta_snapshot_sync, track_ids)
 
     async def upsert_track_meta(self, track_id: int, meta: TrackMeta) -> None:
-        await run_blocking(self._upsert_track_meta_sync, track_id, meta)
+        await run_db(self._upsert_track_meta_sync, track_id, meta)
 
     async def mark_meta_invalid(self, track_id: int, error: str | None = None) -> None:
-        await run_blocking(self._mark_meta_invalid_sync, track_id, error)
+        await run_db(self._mark_meta_invalid_sync, track_id, error)
+
+    def iter_export_rows(self, playlist_id: int) -> Iterator[PlaylistExportRow]:
+        """Yield playlist rows in order straight from a DB cursor.
+
+        Blocking; iterate from a worker thread. Rows are fetched in batches so
+        memory stays flat regardless of playlist size.
+        """
+        with closing(self._connect()) as conn:
+            cursor = conn.execute(
+                """
+                SELECT
+                    tracks.path,
+                    track_meta.title,
+                    track_meta.artist,
+                    track_meta.duration_ms
+                FROM playlist_items
+                JOIN tracks ON tracks.id = playlist_items.track_id
+                LEFT JOIN track_meta ON track_meta.track_id = tracks.id
+                WHERE playlist_items.playlist_id = ?
+                ORDER BY playlist_items.pos_key
+                """,
+                (playlist_id,),
+            )
+            while True:
+                batch = cursor.fetchmany(_EXPORT_FETCH_ROWS)
+                if not batch:
+                    return
+                for row in batch:
+                    yield PlaylistExportRow(
+                        path=str(row["path"]),
+                        title=row["title"],
+                        artist=row["artist"],
+                        duration_ms=row["duration_ms"],
+                    )
 
     def _connect(self) -> sqlite3.Connection:
         """Create a fresh SQLite connection configured for concurrent app usage."""
@@ -309,19 +350,52 @@ class PlaylistStore:
         return added
 
     def _remove_items_sync(self, playlist_id: int, item_ids: set[int]) -> int:
+        """Delete items via a staged id table; large deletes rebuild FTS once."""
         if not item_ids:
             return 0
-        placeholders = ", ".join("?" for _ in item_ids)
-        params: list[int] = [playlist_id, *item_ids]
-        with self._connect() as conn:
-            cursor = conn.execute(
-                f"""
-                DELETE FROM playlist_items
-                WHERE playlist_id = ? AND id IN ({placeholders})
-                """,
-                params,
-            )
-            return int(cursor.rowcount or 0)
+
+        start = time.perf_counter()
+        removed = 0
+        rebuilt_fts = False
+
+        def _op() -> None:
+            nonlocal removed, rebuilt_fts
+            with self._connect() as conn:
+                conn.execute("BEGIN IMMEDIATE")
+                _stage_ids(conn, item_ids)
+                rebuilt_fts = False
+                bulk = len(item_ids) >= BULK_FTS_REBUILD_MIN_ROWS
+                if bulk and _has_playlist_search_fts(conn):
+                    total = conn.execute(
+                        "SELECT COUNT(*) FROM playlist_items"
+                    ).fetchone()[0]
+                    # FTS5 deletes re-tokenize each row; past half the index,
+                    # backfilling the survivors is cheaper.
+                    rebuilt_fts = len(item_ids) * 2 > int(total)
+                if rebuilt_fts:
+                    drop_playlist_search(conn)
+                cursor = conn.execute(
+                    """
+                    DELETE FROM playlist_items
+                    WHERE playlist_id = ?
+                      AND id IN (SELECT id FROM temp.staged_ids)
+                    """,
+                    (playlist_id,),
+                )
+                removed = int(cursor.rowcount or 0)
+                if rebuilt_fts:
+                    rebuild_playlist_search(conn)
+
+        run_with_sqlite_lock_retry(_op, op_name="playlist.remove_items")
+        _log_slow_db_op(
+            "remove_items",
+            start=start,
+            playlist_id=playlist_id,
+            requested=len(item_ids),
+            removed=removed,
+            rebuilt_fts=rebuilt_fts,
+        )
+        return removed
 
     def _count_sync(self, playlist_id: int) -> int:
         with self._connect() as conn:
@@ -724,6 +798,7 @@ class PlaylistStore:
                 if not rows:
                     return
                 item_ids = [int(row["id"]) for row in rows]
+                original_ids = list(item_ids)
                 pos_keys = [int(row["pos_key"]) for row in rows]
 
                 if direction == "up":
@@ -749,9 +824,11 @@ class PlaylistStore:
                                 item_ids[index + 1],
                             )
 
+                # Only rows that actually moved get a new key.
                 updates = [
                     (pos_keys[i], playlist_id, item_ids[i])
                     for i in range(len(item_ids))
+                    if item_ids[i] != original_ids[i]
                 ]
                 conn.executemany(
                     """
@@ -892,14 +969,13 @@ class PlaylistStore:
             if not track_ids:
                 conn.execute("UPDATE track_meta SET meta_valid = 0, meta_error = NULL")
                 return
-            placeholders = ", ".join("?" for _ in track_ids)
+            _stage_ids(conn, track_ids)
             conn.execute(
-                f"""
+                """
                 UPDATE track_meta
                 SET meta_valid = 0, meta_error = NULL
-                WHERE track_id IN ({placeholders})
-                """,
-                list(track_ids),
+                WHERE track_id IN (SELECT id FROM temp.staged_ids)
+                """
             )
 
     def _renumber_playlist_sync(self, playlist_id: int) -> None:
@@ -1088,6 +1164,19 @@ def _coerce_meta_valid(value: int | None) -> bool | None:
     return bool(int(value))
 
 
+def _stage_ids(conn: sqlite3.Connection, ids: Iterable[int]) -> None:
+    """Load ``ids`` into ``temp.staged_ids`` for set-based joins.
+
+    Avoids one bound variable per id, which breaks past SQLite's variable limit.
+    """
+    conn.execute("CREATE TEMP TABLE IF NOT EXISTS staged_ids (id INTEGER PRIMARY KEY)")
+    conn.execute("DELETE FROM temp.staged_ids")
+    conn.executemany(
+        "INSERT OR IGNORE INTO temp.staged_ids (id) VALUES (?)",
+        ((int(item_id),) for item_id in ids),
+    )
+
+
 def _has_playlist_search_fts(conn: sqlite3.Connection) -> bool:
     row = conn.execute(
         """
@@ -3,18 +3,29 @@
 from __future__ import annotations
 
 import logging
+import math
 import time
 from bisect import bisect_left
 from collections.abc import Awaitable, Callable
 from dataclasses import dataclass
 from typing import Literal, Protocol
 
-from .spectrum_store import SpectrumFrame, SpectrumParams
+from .analysis_availability import AnalysisAvailabilityIndex
+from .spectrum_store import SpectrumFrame, SpectrumParams, SqliteSpectrumStore
 
 SpectrumSource = Literal["cache", "fallback"]
 SpectrumStatus = Literal["ready", "loading", "missing", "error"]
+SpectrumInterpolation = Literal["nearest", "linear", "envelope"]
+SPECTRUM_INTERPOLATION_MODES: tuple[SpectrumInterpolation, ...] = (
+    "nearest",
+    "linear",
+    "envelope",
+)
 logger = logging.getLogger(__name__)
 
+# Envelope state older than this (or a seek this large) snaps to the target.
+_ENVELOPE_RESET_MS = 500
+
 
 class SpectrumProvider(Protocol):
     """Protocol for persisted spectrum frame lookup by track position."""
@@ -54,12 +65,26 @@ class SpectrumService:
         cache_provider: SpectrumProvider,
         schedule_analysis: Callable[[str, SpectrumParams], Awaitable[None]]
         | None = None,
+        interpolation: SpectrumInterpolation = "nearest",
+        attack_ms: float = 15.0,
+        decay_ms: float = 120.0,
+        availability: AnalysisAvailabilityIndex | None = None,
     ) -> None:
+        if interpolation not in SPECTRUM_INTERPOLATION_MODES:
+            raise ValueError(f"Unsupported spectrum interpolation '{interpolation}'.")
         self._cache_provider = cache_provider
         self._schedule_analysis = schedule_analysis
+        self._availability = availability
+        self._interpolation = interpolation
+        self._attack_ms = max(1.0, float(attack_ms))
+        self._decay_ms = max(1.0, float(decay_ms))
+        self._envelope_position_ms: int | None = None
+        self._envelope_bands = b""
         self._last_touch_s: dict[str, float] = {}
         self._touch_interval_s = 15.0
         self._frame_cache: dict[str, tuple[list[int], list[bytes]]] = {}
+        # End of the analyzed prefix for cached tracks still being segmented.
+        self._covered_ms: dict[str, int] = {}
         self._stats_memory_hits = 0
         self._stats_db_hits = 0
         self._stats_misses = 0
@@ -90,6 +115,32 @@ class SpectrumService:
             self._maybe_log_stats()
             return SpectrumReading(bands=cached, source="cache", status="ready")
 
+        # Pending or recently failed analysis cannot have landed in the store;
+        # answer from the availability index instead of querying SQLite again.
+        known = (
+            self._availability.state(
+                track_path, SqliteSpectrumStore.ANALYSIS_TYPE, params
+            )
+            if self._availability is not None
+            else None
+        )
+        if known == "pending":
+            self._stats_loading += 1
+            self._maybe_log_stats()
+            return SpectrumReading(
+                bands=b"\x00" * params.band_count,
+                source="fallback",
+                status="loading",
+            )
+        if known == "failed":
+            self._stats_misses += 1
+            self._maybe_log_stats()
+            return SpectrumReading(
+                bands=b"\x00" * params.band_count,
+                source="fallback",
+                status="missing",
+            )
+
         frame = await self._cache_provider.get_frame_at(
             track_path,
             position_ms=max(0, int(position_ms)),
@@ -119,34 +170,94 @@ class SpectrumService:
             status="missing",
         )
 
-    async def preload_track(self, track_path: str, *, params: SpectrumParams) -> int:
+    async def preload_track(
+        self, track_path: str, *, params: SpectrumParams, start_ms: int = 0
+    ) -> int:
+        """Load frames into memory; ``start_ms`` splices in a newly stored segment."""
         if not track_path:
             return 0
         key = f"{track_path}|{params.band_count}|{params.hop_ms}"
-        if key in self._frame_cache:
-            return len(self._frame_cache[key][0])
+        cached = self._frame_cache.get(key)
+        if cached is not None and start_ms <= 0:
+            return len(cached[0])
         list_frames = getattr(self._cache_provider, "list_frames", None)
         if list_frames is None or not callable(list_frames):
             return 0
+        if start_ms > 0 and cached is None:
+            # Nothing in memory to extend; the next full preload picks it up.
+            return 0
         try:
-            frames = await list_frames(track_path, params=params)
+            if start_ms > 0:
+                frames = await list_frames(track_path, params=params, start_ms=start_ms)
+            else:
+                frames = await list_frames(track_path, params=params)
         except Exception:
             return 0
         if not frames:
             return 0
+        covered_ms = await self._load_covered_ms(track_path, params)
         positions = [int(frame.position_ms) for frame in frames]
         bands = [bytes(frame.bands) for frame in frames]
+        if cached is not None and start_ms > 0:
+            keep = bisect_left(cached[0], start_ms)
+            del cached[0][keep:], cached[1][keep:]
+            cached[0].extend(positions)
+            cached[1].extend(bands)
+            self._set_covered_ms(key, covered_ms)
+            return len(cached[0])
         self._frame_cache.clear()
+        self._covered_ms.clear()
         self._frame_cache[key] = (positions, bands)
+        self._set_covered_ms(key, covered_ms)
+        self._envelope_position_ms = None
         return len(positions)
 
+    def bands_at(
+        self, track_path: str, position_ms: int, *, params: SpectrumParams
+    ) -> bytes | None:
+        """Return preloaded bands at ``position_ms`` without touching the store.
+
+        Cheap enough to call once per render frame; returns ``None`` until the
+        track has been preloaded, or past the segments analyzed so far. The "envelope" interpolation smooths only
+        this render-clock path; `sample()` returns unsmoothed frames so polls
+        cannot advance or rewind the render envelope.
+        """
+        target = self._read_from_cache(
+            track_path, params=params, position_ms=position_ms
+        )
+        if target is None or self._interpolation != "envelope":
+            return target
+        return self._apply_envelope(max(0, int(position_ms)), target)
+
     def clear_track_cache(self, track_path: str | None = None) -> None:
+        self._envelope_position_ms = None
         if track_path is None:
             self._frame_cache.clear()
+            self._covered_ms.clear()
             return
         stale = [key for key in self._frame_cache if key.startswith(f"{track_path}|")]
         for key in stale:
             self._frame_cache.pop(key, None)
+            self._covered_ms.pop(key, None)
+
+    async def _load_covered_ms(
+        self, track_path: str, params: SpectrumParams
+    ) -> int | None:
+        """Return where a partially analyzed entry stops, ``None`` if complete."""
+        resume_ms = getattr(self._cache_provider, "spectrum_resume_ms", None)
+        if resume_ms is None or not callable(resume_ms):
+            return None
+        try:
+            covered = await resume_ms(track_path, params=params)
+        except Exception:
+            return None
+        return None if covered is None else int(covered)
+
+    def _set_covered_ms(self, key: str, covered_ms: int | None) -> None:
+        if covered_ms is None:
+            self._covered_ms.pop(key, None)
+        else:
+            self._covered_ms[key] = covered_ms
 
     async def _touch_access_if_due(
         self,
@@ -182,15 +293,57 @@ class SpectrumService:
         if not positions:
             return None
         pos = max(0, int(position_ms))
+        covered_ms = self._covered_ms.get(key)
+        if covered_ms is not None and pos >= covered_ms:
+            # Past the analyzed prefix (e.g. after a seek): not the last frame.
+            return None
         idx = bisect_left(positions, pos)
         if idx <= 0:
-            return bands[0]
-        if idx >= len(positions):
-            return bands[-1]
-        prev_idx = idx - 1
-        if (pos - positions[prev_idx]) <= (positions[idx] - pos):
-            return bands[prev_idx]
-        return bands[idx]
+            target = bands[0]
+        elif idx >= len(positions):
+            target = bands[-1]
+        else:
+            prev_idx = idx - 1
+            span = positions[idx] - positions[prev_idx]
+            offset = pos - positions[prev_idx]
+            if self._interpolation == "nearest" or span <= 0:
+                if offset <= (positions[idx] - pos):
+                    return bands[prev_idx]
+                return bands[idx]
+            return _blend_u8(bands[prev_idx], bands[idx], (offset << 8) // span)
+        return target
+
+    def _apply_envelope(self, position_ms: int, target: bytes) -> bytes:
+        """Smooth toward ``target`` with separate attack/decay time constants."""
+        previous_ms = self._envelope_position_ms
+        current = self._envelope_bands
+        if (
+            previous_ms is None
+            or len(current) != len(target)
+            or abs(position_ms - previous_ms) > _ENVELOPE_RESET_MS
+        ):
+            self._envelope_position_ms = position_ms
+            self._envelope_bands = target
+            return target
+        elapsed_ms = position_ms - previous_ms
+        if elapsed_ms <= 0:
+            # A repeated or slightly late render timestamp reads the current
+            # envelope instead of rewinding it.
+            return current
+        attack = _alpha_q8(elapsed_ms, self._attack_ms)
+        decay = _alpha_q8(elapsed_ms, self._decay_ms)
+        # Steps round away from ``level`` so every band reaches its target.
+        smoothed = bytes(
+            [
+                level - (((level - goal) * attack) >> 8)
+                if goal > level
+                else level + (((goal - level) * decay) >> 8)
+                for level, goal in zip(current, target)
+            ]
+        )
+        self._envelope_position_ms = position_ms
+        self._envelope_bands = smoothed
+        return smoothed
 
     def _maybe_log_stats(self) -> None:
         now = time.monotonic()
@@ -223,3 +376,20 @@ class SpectrumService:
         self._stats_misses = 0
         self._stats_loading = 0
         self._stats_last_log_s = now
+
+
+def _blend_u8(prev: bytes, nxt: bytes, weight_q8: int) -> bytes:
+    """Linear blend of two band frames with an 8-bit fixed-point weight."""
+    if weight_q8 <= 0 or prev == nxt:
+        return prev
+    if weight_q8 >= 256 or len(prev) != len(nxt):
+        return nxt
+    inverse = 256 - weight_q8
+    return bytes([(a * inverse + b * weight_q8 + 128) >> 8 for a, b in zip(prev, nxt)])
+
+
+def _alpha_q8(elapsed_ms: int, time_constant_ms: float) -> int:
+    """One-pole smoothing coefficient for ``elapsed_ms`` in 1/256 units."""
+    return max(
+        1, min(256, round(256 * (1.0 - math.exp(-elapsed_ms / time_constant_ms))))
+    )
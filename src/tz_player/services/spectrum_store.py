@@ -9,8 +9,24 @@ import sqlite3
 from dataclasses import dataclass
 from pathlib import Path
 
+from tz_player.services.analysis_cache_db import (
+    begin_segment_write,
+    complete_segment_entry,
+    connect_analysis_cache,
+    ensure_segment_schema,
+    entry_covered_ms,
+    entry_norm_peak,
+    extend_segment_entry,
+    finish_segment_write,
+    prepare_analysis_cache_db,
+)
+from tz_player.services.analysis_content_key import (
+    AnalysisEntryKey,
+    ensure_content_key_schema,
+    find_entry_id,
+)
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 
 @dataclass(frozen=True)
@@ -33,13 +49,18 @@ class SqliteSpectrumStore:
     """Stores and resolves quantized spectrum frames in app SQLite DB."""
 
     ANALYSIS_TYPE = "spectrum"
+    # Bump when the analyzer's output changes for the same params so older
+    # entries are recomputed instead of mixed in. 2: octave filter bank.
+    ANALYSIS_VERSION = 2
 
-    def __init__(self, db_path: Path, *, analysis_version: int = 1) -> None:
+    def __init__(
+        self, db_path: Path, *, analysis_version: int = ANALYSIS_VERSION
+    ) -> None:
         self._db_path = Path(db_path)
         self._analysis_version = analysis_version
 
     async def initialize(self) -> None:
-        await run_blocking(self._initialize_sync)
+        await run_db(self._initialize_sync)
 
     async def upsert_spectrum(
         self,
@@ -48,19 +69,43 @@ class SqliteSpectrumStore:
         duration_ms: int,
         params: SpectrumParams,
         frames: list[tuple[int, bytes]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
+        norm_peak: float | None = None,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._upsert_spectrum_sync,
             Path(track_path),
             duration_ms,
             params,
             frames,
+            segment_start_ms,
+            covered_ms,
+            norm_peak,
         )
 
     async def has_spectrum(
         self, track_path: Path | str, *, params: SpectrumParams
     ) -> bool:
-        return await run_blocking(self._has_spectrum_sync, Path(track_path), params)
+        return await run_db(self._has_spectrum_sync, Path(track_path), params)
+
+    async def spectrum_resume_ms(
+        self, track_path: Path | str, *, params: SpectrumParams
+    ) -> int | None:
+        """Return where a partially analyzed entry stops, ``None`` if complete."""
+        return await run_db(self._resume_ms_sync, Path(track_path), params)
+
+    async def complete_spectrum(
+        self, track_path: Path | str, *, params: SpectrumParams
+    ) -> None:
+        """Mark a partial entry complete when the track ended at its last segment."""
+        await run_db(self._complete_sync, Path(track_path), params)
+
+    async def spectrum_norm_peak(
+        self, track_path: Path | str, *, params: SpectrumParams
+    ) -> float | None:
+        """Return the full-scale level later segments of an entry must reuse."""
+        return await run_db(self._norm_peak_sync, Path(track_path), params)
 
     async def get_frame_at(
         self,
@@ -69,7 +114,7 @@ class SqliteSpectrumStore:
         position_ms: int,
         params: SpectrumParams,
     ) -> SpectrumFrame | None:
-        return await run_blocking(
+        return await run_db(
             self._get_frame_at_sync,
             Path(track_path),
             position_ms,
@@ -81,8 +126,9 @@ class SqliteSpectrumStore:
         track_path: Path | str,
         *,
         params: SpectrumParams,
+        start_ms: int = 0,
     ) -> list[SpectrumFrame]:
-        return await run_blocking(self._list_frames_sync, Path(track_path), params)
+        return await run_db(self._list_frames_sync, Path(track_path), params, start_ms)
 
     async def touch_spectrum_access(
         self,
@@ -90,7 +136,7 @@ class SqliteSpectrumStore:
         *,
         params: SpectrumParams,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._touch_spectrum_access_sync,
             Path(track_path),
             params,
@@ -103,7 +149,7 @@ class SqliteSpectrumStore:
         max_age_days: int,
         min_recent_tracks_protected: int,
     ) -> int:
-        return await run_blocking(
+        return await run_db(
             self._prune_sync,
             max_cache_bytes,
             max_age_days,
@@ -111,14 +157,24 @@ class SqliteSpectrumStore:
         )
 
     def _connect(self) -> sqlite3.Connection:
-        conn = sqlite3.connect(self._db_path, timeout=30)
-        conn.row_factory = sqlite3.Row
-        conn.execute("PRAGMA foreign_keys=ON")
-        return conn
+        return connect_analysis_cache(self._db_path)
+
+    def _entry_key(self, track_path: Path, params: SpectrumParams) -> AnalysisEntryKey:
+        mtime_ns, size_bytes = _stat_path(track_path)
+        return AnalysisEntryKey(
+            analysis_type=self.ANALYSIS_TYPE,
+            track_path=track_path,
+            path_norm=_normalize_path(track_path),
+            mtime_ns=mtime_ns,
+            size_bytes=size_bytes,
+            analysis_version=self._analysis_version,
+            params_hash=_params_hash(_params_json(params)),
+        )
 
     def _initialize_sync(self) -> None:
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
         with self._connect() as conn:
+            prepare_analysis_cache_db(conn)
             conn.execute(
                 """
                 CREATE TABLE IF NOT EXISTS analysis_cache_entries (
@@ -154,6 +210,8 @@ class SqliteSpectrumStore:
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_cache_lookup ON analysis_cache_entries(analysis_type, path_norm, analysis_version, params_hash)"
             )
+            ensure_content_key_schema(conn)
+            ensure_segment_schema(conn)
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_cache_access ON analysis_cache_entries(last_accessed_at)"
             )
@@ -167,6 +225,9 @@ class SqliteSpectrumStore:
         duration_ms: int,
         params: SpectrumParams,
         frames: list[tuple[int, bytes]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
+        norm_peak: float | None = None,
     ) -> None:
         if not frames:
             return
@@ -174,80 +235,65 @@ class SqliteSpectrumStore:
             (max(0, int(position_ms)), _normalize_bands(raw, params.band_count))
             for position_ms, raw in frames
         ]
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
+        key = self._entry_key(track_path, params)
         params_json = _params_json(params)
-        params_hash = _params_hash(params_json)
         total_bytes = sum(len(payload) for _pos, payload in normalized_frames)
 
         def _op() -> None:
             with self._connect() as conn:
                 conn.execute("BEGIN IMMEDIATE")
-                conn.execute(
-                    """
-                    INSERT INTO analysis_cache_entries (
-                        analysis_type,
-                        path_norm,
-                        mtime_ns,
-                        size_bytes,
-                        analysis_version,
-                        params_hash,
-                        params_json,
-                        duration_ms,
-                        frame_count,
-                        byte_size,
-                        computed_at,
-                        last_accessed_at
-                    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
-                    ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
-                    DO UPDATE SET
-                        params_json = excluded.params_json,
-                        duration_ms = excluded.duration_ms,
-                        frame_count = excluded.frame_count,
-                        byte_size = excluded.byte_size,
-                        computed_at = excluded.computed_at,
-                        last_accessed_at = excluded.last_accessed_at
-                    """,
-                    (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        mtime_ns,
-                        size_bytes,
-                        self._analysis_version,
-                        params_hash,
-                        params_json,
-                        max(1, int(duration_ms)),
-                        len(normalized_frames),
-                        total_bytes,
-                    ),
-                )
-                row = conn.execute(
-                    """
-                    SELECT id
-                    FROM analysis_cache_entries
-                    WHERE analysis_type = ?
-                      AND path_norm = ?
-                      AND analysis_version = ?
-                      AND params_hash = ?
-                      AND mtime_ns IS ?
-                      AND size_bytes IS ?
-                    LIMIT 1
-                    """,
-                    (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        self._analysis_version,
-                        params_hash,
-                        mtime_ns,
-                        size_bytes,
-                    ),
-                ).fetchone()
-                if row is None:
-                    return
-                entry_id = int(row["id"])
-                conn.execute(
-                    "DELETE FROM analysis_spectrum_frames WHERE entry_id = ?",
-                    (entry_id,),
+                # Later segments extend the entry earlier segments created, even
+                # when it was found through the content key.
+                entry_id = find_entry_id(conn, key) if segment_start_ms > 0 else None
+                if entry_id is not None:
+                    extend_segment_entry(conn, entry_id, duration_ms)
+                else:
+                    conn.execute(
+                        """
+                        INSERT INTO analysis_cache_entries (
+                            analysis_type,
+                            path_norm,
+                            mtime_ns,
+                            size_bytes,
+                            content_key,
+                            analysis_version,
+                            params_hash,
+                            params_json,
+                            duration_ms,
+                            frame_count,
+                            byte_size,
+                            computed_at,
+                            last_accessed_at
+                        ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
+                        ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
+                        DO UPDATE SET
+                            content_key = excluded.content_key,
+                            params_json = excluded.params_json,
+                            duration_ms = excluded.duration_ms,
+                            frame_count = excluded.frame_count,
+                            byte_size = excluded.byte_size,
+                            computed_at = excluded.computed_at,
+                            last_accessed_at = excluded.last_accessed_at
+                        """,
+                        (
+                            key.analysis_type,
+                            key.path_norm,
+                            key.mtime_ns,
+                            key.size_bytes,
+                            key.content_key,
+                            key.analysis_version,
+                            key.params_hash,
+                            params_json,
+                            max(1, int(duration_ms)),
+                            len(normalized_frames),
+                            total_bytes,
+                        ),
+                    )
+                    entry_id = find_entry_id(conn, key)
+                    if entry_id is None:
+                        return
+                first_idx = begin_segment_write(
+                    conn, "analysis_spectrum_frames", entry_id, segment_start_ms
                 )
                 conn.executemany(
                     """
@@ -257,42 +303,59 @@ class SqliteSpectrumStore:
                     """,
                     [
                         (entry_id, idx, position_ms, payload)
-                        for idx, (position_ms, payload) in enumerate(normalized_frames)
+                        for idx, (position_ms, payload) in enumerate(
+                            normalized_frames, start=first_idx
+                        )
                     ],
                 )
+                finish_segment_write(
+                    conn,
+                    "analysis_spectrum_frames",
+                    entry_id,
+                    segment_start_ms=segment_start_ms,
+                    covered_ms=covered_ms,
+                    norm_peak=norm_peak,
+                    byte_size_sql="SUM(LENGTH(bands))",
+                )
 
         run_with_sqlite_lock_retry(_op, op_name="spectrum.upsert")
 
+    def _resume_ms_sync(self, track_path: Path, params: SpectrumParams) -> int | None:
+        key = self._entry_key(track_path, params)
+        with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            return entry_covered_ms(conn, entry_id)
+
+    def _complete_sync(self, track_path: Path, params: SpectrumParams) -> None:
+        key = self._entry_key(track_path, params)
+
+        def _op() -> None:
+            with self._connect() as conn:
+                entry_id = find_entry_id(conn, key)
+                if entry_id is not None:
+                    complete_segment_entry(conn, entry_id)
+
+        run_with_sqlite_lock_retry(_op, op_name="spectrum.complete")
+
+    def _norm_peak_sync(self, track_path: Path, params: SpectrumParams) -> float | None:
+        key = self._entry_key(track_path, params)
+        with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            return entry_norm_peak(conn, entry_id)
+
     def _has_spectrum_sync(self, track_path: Path, params: SpectrumParams) -> bool:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return False
             row = conn.execute(
-                """
-                SELECT 1
-                FROM analysis_cache_entries AS e
-                WHERE e.analysis_type = ?
-                  AND e.path_norm = ?
-                  AND e.analysis_version = ?
-                  AND e.params_hash = ?
-                  AND e.mtime_ns IS ?
-                  AND e.size_bytes IS ?
-                  AND EXISTS (
-                      SELECT 1
-                      FROM analysis_spectrum_frames AS f
-                      WHERE f.entry_id = e.id
-                  )
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                "SELECT 1 FROM analysis_spectrum_frames WHERE entry_id = ? LIMIT 1",
+                (entry_id,),
             ).fetchone()
             return row is not None
 
@@ -302,35 +365,15 @@ class SqliteSpectrumStore:
         position_ms: int,
         params: SpectrumParams,
     ) -> SpectrumFrame | None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         pos = max(0, int(position_ms))
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            covered_ms = entry_covered_ms(conn, entry_id)
+            if covered_ms is not None and pos >= covered_ms:
                 return None
-            entry_id = int(row["id"])
             prev_row = conn.execute(
                 """
                 SELECT position_ms, bands
@@ -363,43 +406,21 @@ class SqliteSpectrumStore:
         self,
         track_path: Path,
         params: SpectrumParams,
+        start_ms: int = 0,
     ) -> list[SpectrumFrame]:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return []
-            entry_id = int(row["id"])
             rows = conn.execute(
                 """
                 SELECT position_ms, bands
                 FROM analysis_spectrum_frames
-                WHERE entry_id = ?
+                WHERE entry_id = ? AND position_ms >= ?
                 ORDER BY position_ms ASC
                 """,
-                (entry_id,),
+                (entry_id, max(0, int(start_ms))),
             ).fetchall()
             return [
                 SpectrumFrame(
@@ -414,29 +435,18 @@ class SqliteSpectrumStore:
         track_path: Path,
         params: SpectrumParams,
     ) -> None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return
             conn.execute(
                 """
                 UPDATE analysis_cache_entries
                 SET last_accessed_at = strftime('%s','now')
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
+                WHERE id = ?
                 """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                (entry_id,),
             )
 
     def _prune_sync(
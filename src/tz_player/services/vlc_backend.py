@@ -11,7 +11,9 @@ import asyncio
 import os
 import queue
 import threading
+import time
 from collections.abc import Awaitable, Callable, Coroutine
+from contextlib import suppress
 from dataclasses import dataclass
 from typing import Any, cast
 
@@ -25,6 +27,13 @@ from .playback_backend import (
     StateChanged,
 )
 
+_COMMAND_SETTLE_S = 2.0
+_PLAYING_WATCHDOG_S = 1.0
+# libvlc_media_parse_local with the default timeout: probe local files only.
+_MEDIA_PARSE_LOCAL = 0
+_MEDIA_PARSE_DEFAULT_TIMEOUT = -1
+_PARKED_STATES: frozenset[BackendStatus] = frozenset({"paused", "stopped", "error"})
+
 
 @dataclass
 class _Command:
@@ -40,9 +49,13 @@ class VLCPlaybackBackend:
 
     def __init__(self, *, poll_interval_ms: int = 200) -> None:
         self._poll_interval = poll_interval_ms / 1000
+        self._on_wakeup: Callable[[str], None] | None = None
         self._handler: Callable[[BackendEvent], Awaitable[None]] | None = None
         self._loop: asyncio.AbstractEventLoop | None = None
         self._queue: queue.Queue[_Command] = queue.Queue()
+        # Worker-thread only: the next track's media, created and parsed ahead of
+        # the play command so demux probing is off the track-switch path.
+        self._preloaded: tuple[str, Any] | None = None
         self._thread: threading.Thread | None = None
         self._stop_event = threading.Event()
 
@@ -51,6 +64,10 @@ class VLCPlaybackBackend:
     ) -> None:
         self._handler = handler
 
+    def set_wakeup_observer(self, observer: Callable[[str], None]) -> None:
+        """Report worker-thread wakeups (called from the worker thread)."""
+        self._on_wakeup = observer
+
     async def start(self) -> None:
         if self._thread is not None:
             return
@@ -87,6 +104,9 @@ class VLCPlaybackBackend:
     ) -> None:
         await self._submit("play", track_path, start_ms, duration_ms)
 
+    async def preload(self, track_path: str) -> None:
+        await self._submit("preload", track_path)
+
     async def toggle_pause(self) -> None:
         await self._submit("toggle_pause")
 
@@ -155,11 +175,35 @@ class VLCPlaybackBackend:
         last_duration = -1
         last_state: BackendStatus = "idle"
 
+        # While playing, the player's poll tick sends a transport snapshot
+        # command every interval, so the worker wakes on those instead of its own
+        # timer; the watchdog only covers a stalled poller. VLC applies commands
+        # asynchronously, so poll briefly after each one to observe transitions.
+        # Paused, stopped, or empty players block until the next command.
+        media_loaded = False
+        fast_poll_until = 0.0
         while not self._stop_event.is_set():
+            timeout: float | None = None
+            if time.monotonic() < fast_poll_until:
+                timeout = self._poll_interval
+            elif last_state not in _PARKED_STATES and (
+                media_loaded or last_state != "idle"
+            ):
+                timeout = max(self._poll_interval, _PLAYING_WATCHDOG_S)
             try:
-                cmd = self._queue.get(timeout=self._poll_interval)
+                cmd = self._queue.get(timeout=timeout)
             except queue.Empty:
                 cmd = None
+            if self._on_wakeup is not None:
+                self._on_wakeup("vlc_worker")
+            if (
+                cmd is not None
+                and cmd.name != "preload"
+                and not cmd.name.startswith("get_")
+            ):
+                fast_poll_until = time.monotonic() + _COMMAND_SETTLE_S
+                if cmd.name in {"play", "stop"}:
+                    media_loaded = cmd.name == "play"
 
             if cmd is not None and cmd.name != "wake":
                 try:
@@ -189,6 +233,7 @@ class VLCPlaybackBackend:
                     last_state = "stopped"
                     self._emit_event(StateChanged("stopped"))
 
+        self._release_preloaded()
         player.stop()
 
     def _handle_command(self, cmd: _Command, instance: Any, player: Any) -> Any:
@@ -196,12 +241,18 @@ class VLCPlaybackBackend:
         name = cmd.name
         if name == "play":
             track_path, start_ms, _duration_ms = cmd.args
-            media = instance.media_new_path(track_path)
+            media = self._take_preloaded(track_path)
+            if media is None:
+                media = instance.media_new_path(track_path)
             player.set_media(media)
             player.play()
             if start_ms:
                 player.set_time(int(start_ms))
             return None
+        if name == "preload":
+            (track_path,) = cmd.args
+            self._preload_media(instance, track_path)
+            return None
         if name == "toggle_pause":
             player.pause()
             return None
@@ -234,6 +285,34 @@ class VLCPlaybackBackend:
             )
         raise ValueError(f"Unknown command {name}")
 
+    def _preload_media(self, instance: Any, track_path: str) -> None:
+        """Create and start parsing ``track_path`` for a later play command."""
+        preloaded = self._preloaded
+        if preloaded is not None and preloaded[0] == track_path:
+            return
+        self._release_preloaded()
+        media = instance.media_new_path(track_path)
+        parse = getattr(media, "parse_with_options", None)
+        if parse is not None:
+            # Asynchronous: probing runs on libVLC's preparser thread.
+            parse(_MEDIA_PARSE_LOCAL, _MEDIA_PARSE_DEFAULT_TIMEOUT)
+        self._preloaded = (track_path, media)
+
+    def _take_preloaded(self, track_path: str) -> Any | None:
+        preloaded = self._preloaded
+        if preloaded is None or preloaded[0] != track_path:
+            self._release_preloaded()
+            return None
+        self._preloaded = None
+        return preloaded[1]
+
+    def _release_preloaded(self) -> None:
+        preloaded = self._preloaded
+        self._preloaded = None
+        if preloaded is not None:
+            with suppress(Exception):
+                preloaded[1].release()
+
     def _emit_event(self, event: BackendEvent) -> None:
         """Bridge backend event callbacks from thread -> asyncio loop."""
         if self._handler is None or self._loop is None:
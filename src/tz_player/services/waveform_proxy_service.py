@@ -9,7 +9,12 @@ from collections.abc import Awaitable, Callable
 from dataclasses import dataclass
 from typing import Literal, Protocol
 
-from .waveform_proxy_store import WaveformProxyFrame, WaveformProxyParams
+from .analysis_availability import AnalysisAvailabilityIndex
+from .waveform_proxy_store import (
+    SqliteWaveformProxyStore,
+    WaveformProxyFrame,
+    WaveformProxyParams,
+)
 
 WaveformProxySource = Literal["cache", "fallback"]
 WaveformProxyStatus = Literal["ready", "loading", "missing", "error"]
@@ -63,9 +68,11 @@ class WaveformProxyService:
         cache_provider: WaveformProxyProvider,
         schedule_analysis: Callable[[str, WaveformProxyParams], Awaitable[None]]
         | None = None,
+        availability: AnalysisAvailabilityIndex | None = None,
     ) -> None:
         self._cache_provider = cache_provider
         self._schedule_analysis = schedule_analysis
+        self._availability = availability
         self._last_touch_s: dict[str, float] = {}
         self._touch_interval_s = 15.0
         self._frame_cache: dict[str, tuple[list[int], list[WaveformProxyFrame]]] = {}
@@ -102,6 +109,22 @@ class WaveformProxyService:
                 status="ready",
             )
 
+        known = (
+            self._availability.state(
+                track_path, SqliteWaveformProxyStore.ANALYSIS_TYPE, params
+            )
+            if self._availability is not None
+            else None
+        )
+        if known == "pending":
+            self._stats_loading += 1
+            self._maybe_log_stats()
+            return _fallback(status="loading")
+        if known == "failed":
+            self._stats_misses += 1
+            self._maybe_log_stats()
+            return _fallback(status="missing")
+
         frame = await self._cache_provider.get_frame_at(
             track_path,
             position_ms=max(0, int(position_ms)),
@@ -135,17 +158,26 @@ class WaveformProxyService:
         track_path: str,
         *,
         params: WaveformProxyParams,
+        start_ms: int = 0,
     ) -> int:
+        """Load frames into memory; ``start_ms`` splices in a newly stored segment."""
         if not track_path:
             return 0
         key = f"{track_path}|{params.hop_ms}"
-        if key in self._frame_cache:
-            return len(self._frame_cache[key][0])
+        cached = self._frame_cache.get(key)
+        if cached is not None and start_ms <= 0:
+            return len(cached[0])
         list_frames = getattr(self._cache_provider, "list_frames", None)
         if list_frames is None or not callable(list_frames):
             return 0
+        if start_ms > 0 and cached is None:
+            # Nothing in memory to extend; the next full preload picks it up.
+            return 0
         try:
-            frames = await list_frames(track_path, params=params)
+            if start_ms > 0:
+                frames = await list_frames(track_path, params=params, start_ms=start_ms)
+            else:
+                frames = await list_frames(track_path, params=params)
         except Exception:
             return 0
         if not frames:
@@ -161,6 +193,12 @@ class WaveformProxyService:
             )
             for frame in frames
         ]
+        if cached is not None and start_ms > 0:
+            keep = bisect_left(cached[0], start_ms)
+            del cached[0][keep:], cached[1][keep:]
+            cached[0].extend(positions)
+            cached[1].extend(normalized)
+            return len(cached[0])
         self._frame_cache.clear()
         self._frame_cache[key] = (positions, normalized)
         return len(positions)
@@ -9,8 +9,23 @@ import sqlite3
 from dataclasses import dataclass
 from pathlib import Path
 
+from tz_player.services.analysis_cache_db import (
+    begin_segment_write,
+    complete_segment_entry,
+    connect_analysis_cache,
+    ensure_segment_schema,
+    entry_covered_ms,
+    extend_segment_entry,
+    finish_segment_write,
+    prepare_analysis_cache_db,
+)
+from tz_player.services.analysis_content_key import (
+    AnalysisEntryKey,
+    ensure_content_key_schema,
+    find_entry_id,
+)
 from tz_player.services.sqlite_retry import run_with_sqlite_lock_retry
-from tz_player.utils.async_utils import run_blocking
+from tz_player.utils.async_utils import run_db
 
 
 @dataclass(frozen=True)
@@ -41,7 +56,7 @@ class SqliteWaveformProxyStore:
         self._analysis_version = analysis_version
 
     async def initialize(self) -> None:
-        await run_blocking(self._initialize_sync)
+        await run_db(self._initialize_sync)
 
     async def upsert_waveform_proxy(
         self,
@@ -50,13 +65,17 @@ class SqliteWaveformProxyStore:
         duration_ms: int,
         params: WaveformProxyParams,
         frames: list[tuple[int, int, int, int, int]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._upsert_waveform_proxy_sync,
             Path(track_path),
             duration_ms,
             params,
             frames,
+            segment_start_ms,
+            covered_ms,
         )
 
     async def has_waveform_proxy(
@@ -65,12 +84,24 @@ class SqliteWaveformProxyStore:
         *,
         params: WaveformProxyParams,
     ) -> bool:
-        return await run_blocking(
+        return await run_db(
             self._has_waveform_proxy_sync,
             Path(track_path),
             params,
         )
 
+    async def waveform_proxy_resume_ms(
+        self, track_path: Path | str, *, params: WaveformProxyParams
+    ) -> int | None:
+        """Return where a partially analyzed entry stops, ``None`` if complete."""
+        return await run_db(self._resume_ms_sync, Path(track_path), params)
+
+    async def complete_waveform_proxy(
+        self, track_path: Path | str, *, params: WaveformProxyParams
+    ) -> None:
+        """Mark a partial entry complete when the track ended at its last segment."""
+        await run_db(self._complete_sync, Path(track_path), params)
+
     async def get_frame_at(
         self,
         track_path: Path | str,
@@ -78,7 +109,7 @@ class SqliteWaveformProxyStore:
         position_ms: int,
         params: WaveformProxyParams,
     ) -> WaveformProxyFrame | None:
-        return await run_blocking(
+        return await run_db(
             self._get_frame_at_sync,
             Path(track_path),
             position_ms,
@@ -90,8 +121,9 @@ class SqliteWaveformProxyStore:
         track_path: Path | str,
         *,
         params: WaveformProxyParams,
+        start_ms: int = 0,
     ) -> list[WaveformProxyFrame]:
-        return await run_blocking(self._list_frames_sync, Path(track_path), params)
+        return await run_db(self._list_frames_sync, Path(track_path), params, start_ms)
 
     async def touch_waveform_proxy_access(
         self,
@@ -99,21 +131,33 @@ class SqliteWaveformProxyStore:
         *,
         params: WaveformProxyParams,
     ) -> None:
-        await run_blocking(
+        await run_db(
             self._touch_waveform_proxy_access_sync,
             Path(track_path),
             params,
         )
 
     def _connect(self) -> sqlite3.Connection:
-        conn = sqlite3.connect(self._db_path, timeout=30)
-        conn.row_factory = sqlite3.Row
-        conn.execute("PRAGMA foreign_keys=ON")
-        return conn
+        return connect_analysis_cache(self._db_path)
+
+    def _entry_key(
+        self, track_path: Path, params: WaveformProxyParams
+    ) -> AnalysisEntryKey:
+        mtime_ns, size_bytes = _stat_path(track_path)
+        return AnalysisEntryKey(
+            analysis_type=self.ANALYSIS_TYPE,
+            track_path=track_path,
+            path_norm=_normalize_path(track_path),
+            mtime_ns=mtime_ns,
+            size_bytes=size_bytes,
+            analysis_version=self._analysis_version,
+            params_hash=_params_hash(_params_json(params)),
+        )
 
     def _initialize_sync(self) -> None:
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
         with self._connect() as conn:
+            prepare_analysis_cache_db(conn)
             conn.execute(
                 """
                 CREATE TABLE IF NOT EXISTS analysis_cache_entries (
@@ -152,6 +196,8 @@ class SqliteWaveformProxyStore:
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_cache_lookup ON analysis_cache_entries(analysis_type, path_norm, analysis_version, params_hash)"
             )
+            ensure_content_key_schema(conn)
+            ensure_segment_schema(conn)
             conn.execute(
                 "CREATE INDEX IF NOT EXISTS idx_analysis_waveform_proxy_pos ON analysis_waveform_proxy_frames(entry_id, position_ms)"
             )
@@ -162,6 +208,8 @@ class SqliteWaveformProxyStore:
         duration_ms: int,
         params: WaveformProxyParams,
         frames: list[tuple[int, int, int, int, int]],
+        segment_start_ms: int = 0,
+        covered_ms: int | None = None,
     ) -> None:
         if not frames:
             return
@@ -181,80 +229,65 @@ class SqliteWaveformProxyStore:
                 max_right_i8,
             ) in frames
         ]
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
+        key = self._entry_key(track_path, params)
         params_json = _params_json(params)
-        params_hash = _params_hash(params_json)
         total_bytes = len(normalized_frames) * 8
 
         def _op() -> None:
             with self._connect() as conn:
                 conn.execute("BEGIN IMMEDIATE")
-                conn.execute(
-                    """
-                INSERT INTO analysis_cache_entries (
-                    analysis_type,
-                    path_norm,
-                    mtime_ns,
-                    size_bytes,
-                    analysis_version,
-                    params_hash,
-                    params_json,
-                    duration_ms,
-                    frame_count,
-                    byte_size,
-                    computed_at,
-                    last_accessed_at
-                ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
-                ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
-                DO UPDATE SET
-                    params_json = excluded.params_json,
-                    duration_ms = excluded.duration_ms,
-                    frame_count = excluded.frame_count,
-                    byte_size = excluded.byte_size,
-                    computed_at = excluded.computed_at,
-                    last_accessed_at = excluded.last_accessed_at
-                """,
-                    (
-                        self.ANALYSIS_TYPE,
+                # Later segments extend the entry earlier segments created, even
+                # when it was found through the content key.
+                entry_id = find_entry_id(conn, key) if segment_start_ms > 0 else None
+                if entry_id is not None:
+                    extend_segment_entry(conn, entry_id, duration_ms)
+                else:
+                    conn.execute(
+                        """
+                    INSERT INTO analysis_cache_entries (
+                        analysis_type,
                         path_norm,
                         mtime_ns,
                         size_bytes,
-                        self._analysis_version,
+                        content_key,
+                        analysis_version,
                         params_hash,
                         params_json,
-                        max(1, int(duration_ms)),
-                        len(normalized_frames),
-                        total_bytes,
-                    ),
-                )
-                row = conn.execute(
-                    """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                    (
-                        self.ANALYSIS_TYPE,
-                        path_norm,
-                        self._analysis_version,
-                        params_hash,
-                        mtime_ns,
-                        size_bytes,
-                    ),
-                ).fetchone()
-                if row is None:
-                    return
-                entry_id = int(row["id"])
-                conn.execute(
-                    "DELETE FROM analysis_waveform_proxy_frames WHERE entry_id = ?",
-                    (entry_id,),
+                        duration_ms,
+                        frame_count,
+                        byte_size,
+                        computed_at,
+                        last_accessed_at
+                    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, strftime('%s','now'), strftime('%s','now'))
+                    ON CONFLICT(path_norm, mtime_ns, size_bytes, analysis_type, analysis_version, params_hash)
+                    DO UPDATE SET
+                        content_key = excluded.content_key,
+                        params_json = excluded.params_json,
+                        duration_ms = excluded.duration_ms,
+                        frame_count = excluded.frame_count,
+                        byte_size = excluded.byte_size,
+                        computed_at = excluded.computed_at,
+                        last_accessed_at = excluded.last_accessed_at
+                    """,
+                        (
+                            key.analysis_type,
+                            key.path_norm,
+                            key.mtime_ns,
+                            key.size_bytes,
+                            key.content_key,
+                            key.analysis_version,
+                            key.params_hash,
+                            params_json,
+                            max(1, int(duration_ms)),
+                            len(normalized_frames),
+                            total_bytes,
+                        ),
+                    )
+                    entry_id = find_entry_id(conn, key)
+                    if entry_id is None:
+                        return
+                first_idx = begin_segment_write(
+                    conn, "analysis_waveform_proxy_frames", entry_id, segment_start_ms
                 )
                 conn.executemany(
                     """
@@ -284,46 +317,54 @@ class SqliteWaveformProxyStore:
                             max_left_i8,
                             min_right_i8,
                             max_right_i8,
-                        ) in enumerate(normalized_frames)
+                        ) in enumerate(normalized_frames, start=first_idx)
                     ],
                 )
+                finish_segment_write(
+                    conn,
+                    "analysis_waveform_proxy_frames",
+                    entry_id,
+                    segment_start_ms=segment_start_ms,
+                    covered_ms=covered_ms,
+                    byte_size_sql="COUNT(*) * 8",
+                )
 
         run_with_sqlite_lock_retry(_op, op_name="waveform_proxy.upsert")
 
+    def _resume_ms_sync(
+        self, track_path: Path, params: WaveformProxyParams
+    ) -> int | None:
+        key = self._entry_key(track_path, params)
+        with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return None
+            return entry_covered_ms(conn, entry_id)
+
+    def _complete_sync(self, track_path: Path, params: WaveformProxyParams) -> None:
+        key = self._entry_key(track_path, params)
+
+        def _op() -> None:
+            with self._connect() as conn:
+                entry_id = find_entry_id(conn, key)
+                if entry_id is not None:
+                    complete_segment_entry(conn, entry_id)
+
+        run_with_sqlite_lock_retry(_op, op_name="waveform_proxy.complete")
+
     def _has_waveform_proxy_sync(
         self,
         track_path: Path,
         params: WaveformProxyParams,
     ) -> bool:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return False
             row = conn.execute(
-                """
-                SELECT 1
-                FROM analysis_cache_entries AS e
-                WHERE e.analysis_type = ?
-                  AND e.path_norm = ?
-                  AND e.analysis_version = ?
-                  AND e.params_hash = ?
-                  AND e.mtime_ns IS ?
-                  AND e.size_bytes IS ?
-                  AND EXISTS (
-                      SELECT 1
-                      FROM analysis_waveform_proxy_frames AS f
-                      WHERE f.entry_id = e.id
-                  )
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                "SELECT 1 FROM analysis_waveform_proxy_frames WHERE entry_id = ? LIMIT 1",
+                (entry_id,),
             ).fetchone()
             return row is not None
 
@@ -333,35 +374,12 @@ class SqliteWaveformProxyStore:
         position_ms: int,
         params: WaveformProxyParams,
     ) -> WaveformProxyFrame | None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         pos = max(0, int(position_ms))
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return None
-            entry_id = int(row["id"])
             prev_row = conn.execute(
                 """
                 SELECT
@@ -407,35 +425,13 @@ class SqliteWaveformProxyStore:
         self,
         track_path: Path,
         params: WaveformProxyParams,
+        start_ms: int = 0,
     ) -> list[WaveformProxyFrame]:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
-            row = conn.execute(
-                """
-                SELECT id
-                FROM analysis_cache_entries
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
-                LIMIT 1
-                """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
-            ).fetchone()
-            if row is None:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
                 return []
-            entry_id = int(row["id"])
             rows = conn.execute(
                 """
                 SELECT
@@ -445,10 +441,10 @@ class SqliteWaveformProxyStore:
                     min_right_i8,
                     max_right_i8
                 FROM analysis_waveform_proxy_frames
-                WHERE entry_id = ?
+                WHERE entry_id = ? AND position_ms >= ?
                 ORDER BY position_ms ASC
                 """,
-                (entry_id,),
+                (entry_id, max(0, int(start_ms))),
             ).fetchall()
             return [
                 WaveformProxyFrame(
@@ -466,29 +462,18 @@ class SqliteWaveformProxyStore:
         track_path: Path,
         params: WaveformProxyParams,
     ) -> None:
-        path_norm = _normalize_path(track_path)
-        mtime_ns, size_bytes = _stat_path(track_path)
-        params_hash = _params_hash(_params_json(params))
+        key = self._entry_key(track_path, params)
         with self._connect() as conn:
+            entry_id = find_entry_id(conn, key)
+            if entry_id is None:
+                return
             conn.execute(
                 """
                 UPDATE analysis_cache_entries
                 SET last_accessed_at = strftime('%s','now')
-                WHERE analysis_type = ?
-                  AND path_norm = ?
-                  AND analysis_version = ?
-                  AND params_hash = ?
-                  AND mtime_ns IS ?
-                  AND size_bytes IS ?
+                WHERE id = ?
                 """,
-                (
-                    self.ANALYSIS_TYPE,
-                    path_norm,
-                    self._analysis_version,
-                    params_hash,
-                    mtime_ns,
-                    size_bytes,
-                ),
+                (entry_id,),
             )
 
 
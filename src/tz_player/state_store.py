@@ -38,6 +38,8 @@ class AppState:
     visualizer_plugin_runtime_mode: str = "in-process"
     native_helper_enabled: bool = True
     native_helper_timeout_s: float = 30.0
+    # Parallel analysis jobs per kind; `tz-player doctor --perf` suggests a value.
+    analysis_concurrency: int = 2
     ansi_enabled: bool = True
     log_level: str = "INFO"
 
@@ -116,6 +118,9 @@ def _coerce_state(data: dict[str, Any]) -> AppState:
             0.1,
             _float_or_default(data.get("native_helper_timeout_s"), 30.0),
         ),
+        analysis_concurrency=min(
+            8, max(1, _int_or_default(data.get("analysis_concurrency"), 2))
+        ),
         ansi_enabled=_bool_or_default(data.get("ansi_enabled"), True),
         log_level=_str_or_default(data.get("log_level"), "INFO"),
     )
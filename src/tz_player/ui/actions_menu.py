@@ -77,6 +77,8 @@ class ActionsMenuPopup(Widget):
         self._menu = OptionList(
             Option("Add files...", id="add_files"),
             Option("Add folder...", id="add_folder"),
+            Option("Import playlist file...", id="import_playlist"),
+            Option("Export playlist file...", id="export_playlist"),
             Option("Remove selected", id="remove_selected"),
             Option("Clear playlist", id="clear_playlist"),
             Option("Refresh metadata (selected)", id="refresh_metadata_selected"),
@@ -9,6 +9,8 @@ from __future__ import annotations
 
 import asyncio
 import logging
+from collections.abc import Iterable
+from functools import partial
 from pathlib import Path
 from typing import TYPE_CHECKING, Literal, cast
 
@@ -24,6 +26,11 @@ from tz_player.events import (
     PlaylistScrollRequested,
 )
 from tz_player.media_formats import is_supported_audio_file
+from tz_player.services.playlist_files import (
+    export_playlist_file,
+    import_playlist_file,
+    is_playlist_file,
+)
 from tz_player.services.playlist_store import PlaylistRow, PlaylistStore
 from tz_player.ui.actions_menu import (
     ActionsMenuButton,
@@ -34,9 +41,11 @@ from tz_player.ui.actions_menu import (
 from tz_player.ui.modals.confirm import ConfirmModal
 from tz_player.ui.modals.error import ErrorModal
 from tz_player.ui.modals.file_tree_picker import FileTreePickerModal
+from tz_player.ui.modals.path_input import PathInputModal
 from tz_player.ui.playlist_viewport import PlaylistViewport
 from tz_player.ui.text_button import TextButton, TextButtonPressed
 from tz_player.ui.transport_controls import (
+    TRANSPORT_STATE_FIELDS,
     ToggleRepeat,
     ToggleShuffle,
     TransportAction,
@@ -100,7 +109,10 @@ class PlaylistPane(Static):
         self.limit = 10
         self._rows: list[PlaylistRow] = []
         self.metadata_service: MetadataService | None = None
-        self._metadata_pending: set[int] = set()
+        # Track ids handed to the hydration queue and not yet reported done.
+        self._metadata_requested: list[int] = []
+        self._metadata_offset = 0
+        self._metadata_direction = 1
         self._viewport = PlaylistViewport(id="playlist-viewport")
         self._actions = ActionsMenuButton(id="playlist-actions")
         self._actions_popup: ActionsMenuPopup | None = None
@@ -228,7 +240,10 @@ class PlaylistPane(Static):
         return {row.item_id for row in self._rows}
 
     def mark_metadata_done(self, track_ids: list[int]) -> None:
-        self._metadata_pending.difference_update(track_ids)
+        done = set(track_ids)
+        self._metadata_requested = [
+            track_id for track_id in self._metadata_requested if track_id not in done
+        ]
 
     def set_playing_item_id(self, item_id: int | None) -> None:
         if item_id == self.playing_item_id:
@@ -236,8 +251,17 @@ class PlaylistPane(Static):
         self.playing_item_id = item_id
         self._update_viewport()
 
-    async def update_transport_controls(self, state: PlayerState) -> None:
+    async def update_transport_controls(
+        self, state: PlayerState, changed: frozenset[str] | None = None
+    ) -> None:
+        first = self._last_player_state is None
         self._last_player_state = state
+        if (
+            not first
+            and changed is not None
+            and changed.isdisjoint(TRANSPORT_STATE_FIELDS)
+        ):
+            return
         await self._refresh_transport_controls()
 
     async def on_transport_action(self, event: TransportAction) -> None:
@@ -763,6 +787,10 @@ class PlaylistPane(Static):
             self.run_worker(self._add_files(), exclusive=True)
         elif action == "add_folder":
             self.run_worker(self._add_folder(), exclusive=True)
+        elif action == "import_playlist":
+            self.run_worker(self._import_playlist_file(), exclusive=True)
+        elif action == "export_playlist":
+            self.run_worker(self._export_playlist_file(), exclusive=True)
         elif action == "remove_selected":
             self.run_worker(self._remove_selected(), exclusive=True)
         elif action == "clear_playlist":
@@ -836,6 +864,51 @@ class PlaylistPane(Static):
             return
         await self._run_store_action("add folder", self.store.add_tracks, paths)
 
+    async def _import_playlist_file(self) -> None:
+        if self.store is None:
+            return
+        path = await self._prompt_path(
+            "Import playlist file", placeholder="/music/mix.m3u8"
+        )
+        if path is None:
+            return
+        if not path.is_file() or not is_playlist_file(path):
+            await self._show_error(
+                "Playlist file is invalid.\n"
+                "Likely cause: path does not exist or is not .m3u, .m3u8, or .pls.\n"
+                "Next step: provide an existing playlist file and try again."
+            )
+            return
+        await self._run_store_action(
+            "import playlist file", partial(import_playlist_file, self.store), path
+        )
+
+    async def _export_playlist_file(self) -> None:
+        if self.store is None or self.playlist_id is None:
+            return
+        path = await self._prompt_path(
+            "Export playlist file", placeholder="/music/tz-player.m3u8"
+        )
+        if path is None:
+            return
+        if not is_playlist_file(path) or not path.parent.is_dir():
+            await self._show_error(
+                "Export path is invalid.\n"
+                "Likely cause: folder does not exist or suffix is not .m3u, .m3u8, or .pls.\n"
+                "Next step: choose an existing folder and a supported suffix."
+            )
+            return
+        try:
+            logger.info("Playlist action: export playlist file")
+            await export_playlist_file(self.store, self.playlist_id, path)
+        except Exception as exc:
+            logger.exception("Playlist action failed: %s", exc)
+            await self._show_error(
+                "Failed to export playlist file.\n"
+                "Likely cause: destination is not writable.\n"
+                "Next step: verify folder permissions and check the log file."
+            )
+
     async def _remove_selected(self) -> None:
         if self.store is None:
             return
@@ -869,7 +942,7 @@ class PlaylistPane(Static):
         self.window_offset = 0
         self.total_count = 0
         self._rows = []
-        self._metadata_pending.clear()
+        self._metadata_requested = []
         self._bump_refresh_gen()
         self._update_viewport()
         await self._refresh_transport_controls()
@@ -891,8 +964,8 @@ class PlaylistPane(Static):
             )
             selected_track_ids = {track_id for track_id in track_ids if track_id}
             await self.store.invalidate_metadata(selected_track_ids)
+            self._metadata_requested = []
             await self.refresh_view()
-            self._metadata_pending.difference_update(selected_track_ids)
         except Exception as exc:
             logger.exception("Playlist action failed: %s", exc)
             await self._show_error(
@@ -907,8 +980,8 @@ class PlaylistPane(Static):
         try:
             logger.info("Playlist action: refresh metadata (all)")
             await self.store.invalidate_metadata()
+            self._metadata_requested = []
             await self.refresh_view()
-            self._metadata_pending.clear()
         except Exception as exc:
             logger.exception("Playlist action failed: %s", exc)
             await self._show_error(
@@ -948,6 +1021,14 @@ class PlaylistPane(Static):
             return None
         return [Path(path) for path in result]
 
+    async def _prompt_path(self, title: str, *, placeholder: str) -> Path | None:
+        result: object = await self.app.push_screen_wait(
+            PathInputModal(title, placeholder=placeholder)
+        )
+        if not isinstance(result, str) or not result:
+            return None
+        return Path(result).expanduser()
+
     async def _prompt_folder(self) -> Path | None:
         result: object = await self.app.push_screen_wait(
             FileTreePickerModal("Add folder", mode="folders")
@@ -961,17 +1042,34 @@ class PlaylistPane(Static):
         self.app.push_screen(ErrorModal(message))
 
     def _request_visible_metadata(self) -> None:
-        """Schedule metadata hydration for visible rows that still need it."""
+        """Queue metadata hydration for visible rows, then rows scrolled toward."""
         if self.metadata_service is None:
             return
-        needed = [row.track_id for row in self._rows if _needs_metadata(row)]
-        pending = [
-            track_id for track_id in needed if track_id not in self._metadata_pending
-        ]
-        if not pending:
+        if self.window_offset != self._metadata_offset:
+            self._metadata_direction = (
+                1 if self.window_offset > self._metadata_offset else -1
+            )
+            self._metadata_offset = self.window_offset
+        visible = _unique_track_ids(row for row in self._rows if _needs_metadata(row))
+        ahead = _unique_track_ids(
+            row for row in self._metadata_prefetch_rows() if _needs_metadata(row)
+        )
+        wanted = visible + [track_id for track_id in ahead if track_id not in visible]
+        if wanted == self._metadata_requested:
             return
-        self._metadata_pending.update(pending)
-        self.run_worker(self._ensure_metadata(pending), exclusive=False)
+        self._metadata_requested = wanted
+        self.metadata_service.hydrate(visible, prefetch_ids=ahead)
+
+    def _metadata_prefetch_rows(self) -> list[PlaylistRow]:
+        """Return up to one page of cached rows in the current scroll direction."""
+        if self.search_active or not self._window_cache_rows:
+            return []
+        limit = max(1, self.limit)
+        start = self.window_offset - self._window_cache_offset
+        if self._metadata_direction >= 0:
+            end = start + len(self._rows)
+            return self._window_cache_rows[end : end + limit]
+        return self._window_cache_rows[max(0, start - limit) : max(0, start)][::-1]
 
     def _bump_refresh_gen(self) -> None:
         self._invalidate_item_index_cache()
@@ -1003,14 +1101,6 @@ class PlaylistPane(Static):
         self._window_cache_total_count = 0
         self._window_cache_playlist_id = self.playlist_id
 
-    async def _ensure_metadata(self, track_ids: list[int]) -> None:
-        if self.metadata_service is None:
-            return
-        try:
-            await self.metadata_service.ensure_metadata(track_ids)
-        finally:
-            self._metadata_pending.difference_update(track_ids)
-
 
 def _scan_media_files(folder: Path) -> list[Path]:
     """Recursively collect supported audio files from a selected folder."""
@@ -1023,6 +1113,16 @@ def _scan_media_files(folder: Path) -> list[Path]:
     return sorted(files, key=lambda path: str(path).lower())
 
 
+def _unique_track_ids(rows: Iterable[PlaylistRow]) -> list[int]:
+    seen: set[int] = set()
+    ordered: list[int] = []
+    for row in rows:
+        if row.track_id not in seen:
+            seen.add(row.track_id)
+            ordered.append(row.track_id)
+    return ordered
+
+
 def _needs_metadata(row: PlaylistRow) -> bool:
     """Return whether a row still requires metadata hydration/retry."""
     if row.meta_valid is None:
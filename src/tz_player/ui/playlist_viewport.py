@@ -58,6 +58,10 @@ class PlaylistViewport(Widget):
             playing_item_id=None,
         )
         self._dragging_scrollbar = False
+        # Lines rendered for the previous frame; rows still visible after a
+        # cursor move or scroll are reused instead of rebuilt.
+        self._row_cache: dict[tuple[object, ...], str] = {}
+        self._scrollbar_cache: tuple[tuple[int, int, int, int], list[str]] | None = None
 
     def update_model(self, **kwargs) -> None:
         """Patch render model fields and trigger a repaint."""
@@ -79,32 +83,50 @@ class PlaylistViewport(Widget):
         height = max(1, height)
         text_width = max(0, width - 1)
 
-        scroll_chars = _render_scrollbar(
-            height,
-            self._model.total_count,
-            self._model.limit,
-            self._model.offset,
-        )
-
+        scroll_chars = self._scrollbar_chars(height)
+        model = self._model
+        previous = self._row_cache
+        cache: dict[tuple[object, ...], str] = {}
+        blank = "".ljust(text_width)
         lines: list[str] = []
         for idx in range(height):
-            if idx < len(self._model.rows):
-                row = self._model.rows[idx]
+            if idx < len(model.rows):
+                row = model.rows[idx]
                 marker = _marker_for(
                     row.item_id,
-                    self._model.cursor_item_id,
-                    self._model.selected_item_ids,
-                    self._model.playing_item_id,
+                    model.cursor_item_id,
+                    model.selected_item_ids,
+                    model.playing_item_id,
+                )
+                # Rows are frozen, so metadata refreshes show up as new values.
+                key = (
+                    row.item_id,
+                    row.path,
+                    row.title if row.meta_valid else None,
+                    row.artist,
+                    row.meta_valid,
+                    marker,
+                    text_width,
                 )
-                title = _title_for(row)
-                artist = row.artist or ""
-                content = f"{title} - {artist}" if artist else title
-                line = _truncate(f"{marker} {content}", text_width)
+                line = previous.get(key)
+                if line is None:
+                    line = _render_row(row, marker, text_width)
+                cache[key] = line
             else:
-                line = "".ljust(text_width)
+                line = blank
             lines.append(f"{line}{scroll_chars[idx]}")
+        self._row_cache = cache
         return Text("\n".join(lines))
 
+    def _scrollbar_chars(self, height: int) -> list[str]:
+        key = (height, self._model.total_count, self._model.limit, self._model.offset)
+        cached = self._scrollbar_cache
+        if cached is not None and cached[0] == key:
+            return cached[1]
+        chars = _render_scrollbar(*key)
+        self._scrollbar_cache = (key, chars)
+        return chars
+
     async def on_mouse_scroll_down(self, event: MouseScrollDown) -> None:
         event.stop()
         self.post_message(PlaylistScrollRequested(1))
@@ -184,6 +206,13 @@ def _marker_for(
     return marker or " "
 
 
+def _render_row(row: PlaylistRow, marker: str, width: int) -> str:
+    title = _title_for(row)
+    artist = row.artist or ""
+    content = f"{title} - {artist}" if artist else title
+    return _truncate(f"{marker} {content}", width)
+
+
 def _title_for(row: PlaylistRow) -> str:
     if row.meta_valid:
         return row.title or row.path.name
@@ -18,6 +18,9 @@ SPEED_MIN = 0.5
 SPEED_MAX = 4.0
 SPEED_STEP = 0.25
 
+STATUS_LINE_FIELDS = frozenset({"status", "repeat_mode", "shuffle"})
+TIME_BAR_FIELDS = frozenset({"position_ms", "duration_ms"})
+
 
 class StatusPane(Widget):
     """Status widget combining transport sliders and runtime status text."""
@@ -83,25 +86,42 @@ class StatusPane(Widget):
         """Attach player service used by interactive slider callbacks."""
         self._player_service = player_service
 
-    def update_state(self, state: PlayerState) -> None:
-        """Refresh slider values and status text from latest player state."""
+    def update_state(
+        self, state: PlayerState, changed: frozenset[str] | None = None
+    ) -> None:
+        """Refresh slider values and status text from latest player state.
+
+        With ``changed``, only the sliders and text showing those fields update.
+        """
+        first = self._state is None
         self._state = state
-        self._update_status_text()
-        pos_text, dur_text = format_time_pair_ms(state.position_ms, state.duration_ms)
-        self._time_bar.set_value_text(f"{pos_text}/{dur_text}")
-        if not self._time_bar.is_dragging:
-            fraction = time_fraction(state.position_ms, state.duration_ms)
-            self._time_bar.set_fraction(fraction)
-        if not self._volume_bar.is_dragging:
+
+        def touched(names: frozenset[str] | set[str]) -> bool:
+            return first or changed is None or not changed.isdisjoint(names)
+
+        if touched(STATUS_LINE_FIELDS):
+            self._update_status_text()
+        if touched(TIME_BAR_FIELDS):
+            pos_text, dur_text = format_time_pair_ms(
+                state.position_ms, state.duration_ms
+            )
+            self._time_bar.set_value_text(f"{pos_text}/{dur_text}")
+            if not self._time_bar.is_dragging:
+                fraction = time_fraction(state.position_ms, state.duration_ms)
+                self._time_bar.set_fraction(fraction)
+        if touched({"volume"}) and not self._volume_bar.is_dragging:
             self._volume_bar.set_fraction(volume_fraction(state.volume))
             self._volume_bar.set_value_text(str(state.volume))
-        if not self._speed_bar.is_dragging:
+        if touched({"speed"}) and not self._speed_bar.is_dragging:
             self._speed_bar.set_fraction(speed_fraction(state.speed))
             self._speed_bar.set_value_text(f"{state.speed:.2f}x")
 
     def set_runtime_notice(self, notice: str | None) -> None:
         """Set one-line runtime notice shown ahead of status indicators."""
-        self._runtime_notice = notice.strip() if notice else None
+        notice = notice.strip() if notice else None
+        if notice == self._runtime_notice:
+            return
+        self._runtime_notice = notice
         if self._state is not None:
             self._update_status_text()
 
@@ -17,6 +17,11 @@ from textual.widgets import Static
 from tz_player.services.player_service import PlayerState
 from tz_player.ui.text_button import TextButton, TextButtonPressed
 
+# PlayerState fields shown by the footer; other changes skip a refresh.
+TRANSPORT_STATE_FIELDS = frozenset(
+    {"status", "playlist_id", "item_id", "repeat_mode", "shuffle"}
+)
+
 
 class TransportAction(Message):
     """Transport command intent emitted by button interactions."""
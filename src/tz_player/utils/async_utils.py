@@ -2,47 +2,297 @@
 
 This module provides project-wide executor bridges used to keep the Textual
 event loop responsive:
-- `run_blocking(...)` for IO-bound tasks (file/database/metadata reads),
+- `run_blocking(...)` for IO-bound tasks (file/metadata reads),
+- `run_db(...)` for SQLite store operations,
 - `run_cpu_bound(...)` for heavier CPU-oriented analysis work.
+
+Each pool is a priority queue rather than a FIFO. Submissions inherit the
+caller's lane (see `executor_lane`): `interactive` and `playback` work jumps
+ahead of queued `prefetch` and `background` work, and the low lanes may never
+occupy every worker, so a burst of library-wide metadata reads cannot delay
+the row lookup on the play-selected path. Every job records queue-wait and
+run time per pool and lane; `executor_stats()` returns the totals and long
+waits on the high lanes are logged as ``event=executor_queue_wait``.
 """
 
 from __future__ import annotations
 
 import asyncio
 import atexit
-from concurrent.futures import ThreadPoolExecutor
+import heapq
+import itertools
+import logging
+import os
+import threading
+import time
+from collections.abc import Iterator
+from concurrent.futures import Future
+from contextlib import contextmanager
+from contextvars import ContextVar
+from dataclasses import dataclass
 from functools import partial
-from typing import Any, Callable, TypeVar
+from typing import Any, Callable, Literal, TypeVar
 
 T = TypeVar("T")
 
-_IO_EXECUTOR = ThreadPoolExecutor(max_workers=4, thread_name_prefix="tz-player-io")
-_CPU_EXECUTOR = ThreadPoolExecutor(max_workers=2, thread_name_prefix="tz-player-cpu")
+logger = logging.getLogger(__name__)
+
+Lane = Literal["interactive", "playback", "prefetch", "background"]
+
+LANE_PRIORITIES: dict[str, int] = {
+    "interactive": 0,
+    "playback": 1,
+    "prefetch": 2,
+    "background": 3,
+}
+_LOW_PRIORITY = LANE_PRIORITIES["prefetch"]
+QUEUE_WAIT_LOG_MS = 100.0
+
+_CURRENT_LANE: ContextVar[str] = ContextVar(
+    "tz_player_executor_lane", default="interactive"
+)
+
+
+@contextmanager
+def executor_lane(lane: Lane) -> Iterator[None]:
+    """Submit executor work from this context on ``lane``."""
+    if lane not in LANE_PRIORITIES:
+        raise ValueError(f"Unknown executor lane: {lane}")
+    token = _CURRENT_LANE.set(lane)
+    try:
+        yield
+    finally:
+        _CURRENT_LANE.reset(token)
+
+
+def current_lane() -> str:
+    """Return the lane new submissions from this context will use."""
+    return _CURRENT_LANE.get()
+
+
+@dataclass(frozen=True)
+class LaneStats:
+    """Cumulative job timings for one pool lane."""
+
+    jobs: int
+    wait_total_ms: float
+    wait_max_ms: float
+    run_total_ms: float
+    run_max_ms: float
+
+
+class _WorkItem:
+    __slots__ = ("future", "func", "args", "lane", "enqueued_s")
+
+    def __init__(
+        self, future: Future[Any], func: Callable[..., Any], args: tuple[Any, ...]
+    ) -> None:
+        self.future = future
+        self.func = func
+        self.args = args
+        self.lane = _CURRENT_LANE.get()
+        self.enqueued_s = time.perf_counter()
+
+
+class PriorityExecutor:
+    """Thread pool that runs queued jobs in lane-priority order.
+
+    `prefetch` and `background` jobs may occupy at most ``low_lane_workers``
+    threads; the rest stay free for `interactive` and `playback` jobs.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        max_workers: int,
+        *,
+        low_lane_workers: int | None = None,
+    ) -> None:
+        self.name = name
+        self.max_workers = max(1, int(max_workers))
+        if low_lane_workers is None:
+            low_lane_workers = self.max_workers - 1
+        self.low_lane_workers = max(1, min(self.max_workers, int(low_lane_workers)))
+        self._cond = threading.Condition()
+        self._queue: list[tuple[int, int, _WorkItem]] = []
+        self._seq = itertools.count()
+        self._threads: list[threading.Thread] = []
+        self._idle = 0
+        self._low_running = 0
+        self._shutdown = False
+        self._stats: dict[str, list[float]] = {}
+
+    def submit(self, func: Callable[..., T], /, *args: Any) -> Future[T]:
+        """Queue ``func(*args)`` on the caller's current lane."""
+        future: Future[T] = Future()
+        item = _WorkItem(future, func, args)
+        with self._cond:
+            if self._shutdown:
+                raise RuntimeError(f"{self.name} executor is shut down")
+            entry = (LANE_PRIORITIES[item.lane], next(self._seq), item)
+            heapq.heappush(self._queue, entry)
+            if self._idle == 0 and len(self._threads) < self.max_workers:
+                thread = threading.Thread(
+                    target=self._worker,
+                    name=f"tz-player-{self.name}_{len(self._threads)}",
+                    daemon=True,
+                )
+                self._threads.append(thread)
+                thread.start()
+            self._cond.notify()
+        return future
+
+    def shutdown(self, *, cancel_futures: bool = False) -> None:
+        """Stop accepting work; optionally cancel jobs still queued."""
+        with self._cond:
+            self._shutdown = True
+            if cancel_futures:
+                for _priority, _seq, item in self._queue:
+                    item.future.cancel()
+                self._queue.clear()
+            self._cond.notify_all()
+
+    def stats(self) -> dict[str, LaneStats]:
+        """Return cumulative wait/run timings per lane."""
+        with self._cond:
+            return {
+                lane: LaneStats(
+                    jobs=int(values[0]),
+                    wait_total_ms=round(values[1], 3),
+                    wait_max_ms=round(values[2], 3),
+                    run_total_ms=round(values[3], 3),
+                    run_max_ms=round(values[4], 3),
+                )
+                for lane, values in self._stats.items()
+            }
+
+    def _take_locked(self) -> _WorkItem | None:
+        if not self._queue:
+            return None
+        priority = self._queue[0][0]
+        if priority >= _LOW_PRIORITY:
+            # The heap head is the highest-priority job, so everything queued
+            # is low-lane work; leave it until a low-lane slot frees up.
+            if self._low_running >= self.low_lane_workers:
+                return None
+            self._low_running += 1
+        return heapq.heappop(self._queue)[2]
+
+    def _worker(self) -> None:
+        while True:
+            with self._cond:
+                item = self._take_locked()
+                while item is None:
+                    if self._shutdown:
+                        return
+                    self._idle += 1
+                    self._cond.wait()
+                    self._idle -= 1
+                    item = self._take_locked()
+            self._run(item)
+            if LANE_PRIORITIES[item.lane] >= _LOW_PRIORITY:
+                with self._cond:
+                    self._low_running -= 1
+                    self._cond.notify()
+
+    def _run(self, item: _WorkItem) -> None:
+        if not item.future.set_running_or_notify_cancel():
+            return
+        started_s = time.perf_counter()
+        error: BaseException | None = None
+        try:
+            result = item.func(*item.args)
+        except BaseException as exc:
+            error = exc
+        # Record before resolving so a woken caller already sees its own job.
+        finished_s = time.perf_counter()
+        self._record(
+            item.lane,
+            (started_s - item.enqueued_s) * 1000.0,
+            (finished_s - started_s) * 1000.0,
+        )
+        if error is not None:
+            item.future.set_exception(error)
+        else:
+            item.future.set_result(result)
+
+    def _record(self, lane: str, wait_ms: float, run_ms: float) -> None:
+        with self._cond:
+            values = self._stats.setdefault(lane, [0.0, 0.0, 0.0, 0.0, 0.0])
+            values[0] += 1
+            values[1] += wait_ms
+            values[2] = max(values[2], wait_ms)
+            values[3] += run_ms
+            values[4] = max(values[4], run_ms)
+        if wait_ms >= QUEUE_WAIT_LOG_MS and LANE_PRIORITIES[lane] < _LOW_PRIORITY:
+            logger.info(
+                "Executor job waited %.1f ms in %s queue",
+                wait_ms,
+                self.name,
+                extra={
+                    "event": "executor_queue_wait",
+                    "pool": self.name,
+                    "lane": lane,
+                    "wait_ms": round(wait_ms, 3),
+                    "run_ms": round(run_ms, 3),
+                },
+            )
+
+
+def _pool_sizes(cpu_count: int | None) -> tuple[int, int, int]:
+    """Return (io, db, cpu) worker counts for ``cpu_count`` cores."""
+    cores = max(1, cpu_count or 2)
+    io_workers = min(8, max(4, cores))
+    # SQLite serializes writers; two threads let a read overlap one write.
+    db_workers = 2
+    # Analysis also spawns native helpers, so leave cores for them and the UI.
+    cpu_workers = min(4, max(2, cores // 2))
+    return io_workers, db_workers, cpu_workers
+
+
+_IO_WORKERS, _DB_WORKERS, _CPU_WORKERS = _pool_sizes(os.cpu_count())
+_IO_EXECUTOR = PriorityExecutor("io", _IO_WORKERS)
+_DB_EXECUTOR = PriorityExecutor("db", _DB_WORKERS)
+_CPU_EXECUTOR = PriorityExecutor("cpu", _CPU_WORKERS)
+_EXECUTORS = (_IO_EXECUTOR, _DB_EXECUTOR, _CPU_EXECUTOR)
 
 
 @atexit.register
 def _shutdown_io_executor() -> None:
-    _IO_EXECUTOR.shutdown(wait=False, cancel_futures=True)
-    _CPU_EXECUTOR.shutdown(wait=False, cancel_futures=True)
+    for executor in _EXECUTORS:
+        executor.shutdown(cancel_futures=True)
 
 
-async def run_blocking(func: Callable[..., T], /, *args: Any, **kwargs: Any) -> T:
-    """Run blocking callable on dedicated IO executor and await its result."""
+def executor_stats() -> dict[str, dict[str, LaneStats]]:
+    """Return per-pool, per-lane queue-wait and run timings."""
+    return {executor.name: executor.stats() for executor in _EXECUTORS}
+
+
+async def _submit(
+    executor: PriorityExecutor,
+    func: Callable[..., T],
+    args: tuple[Any, ...],
+    kwargs: dict[str, Any],
+) -> T:
     if not callable(func):
         raise TypeError("func must be callable")
-    loop = asyncio.get_running_loop()
     if kwargs:
-        bound = partial(func, *args, **kwargs)
-        return await loop.run_in_executor(_IO_EXECUTOR, bound)
-    return await loop.run_in_executor(_IO_EXECUTOR, func, *args)
+        future = executor.submit(partial(func, *args, **kwargs))
+    else:
+        future = executor.submit(func, *args)
+    return await asyncio.wrap_future(future)
+
+
+async def run_blocking(func: Callable[..., T], /, *args: Any, **kwargs: Any) -> T:
+    """Run blocking callable on dedicated IO executor and await its result."""
+    return await _submit(_IO_EXECUTOR, func, args, kwargs)
+
+
+async def run_db(func: Callable[..., T], /, *args: Any, **kwargs: Any) -> T:
+    """Run SQLite store callable on dedicated DB executor and await its result."""
+    return await _submit(_DB_EXECUTOR, func, args, kwargs)
 
 
 async def run_cpu_bound(func: Callable[..., T], /, *args: Any, **kwargs: Any) -> T:
     """Run CPU-heavy callable on dedicated executor and await its result."""
-    if not callable(func):
-        raise TypeError("func must be callable")
-    loop = asyncio.get_running_loop()
-    if kwargs:
-        bound = partial(func, *args, **kwargs)
-        return await loop.run_in_executor(_CPU_EXECUTOR, bound)
-    return await loop.run_in_executor(_CPU_EXECUTOR, func, *args)
+    return await _submit(_CPU_EXECUTOR, func, args, kwargs)
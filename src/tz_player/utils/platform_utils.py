@@ -0,0 +1,11 @@
+"""Platform helpers shared by bundled native binary loaders."""
+
+from __future__ import annotations
+
+
+def normalize_machine(machine: str) -> str:
+    """Map `platform.machine()` aliases onto the bundled-binary directory name."""
+    normalized = machine.lower()
+    if normalized in {"x86_64", "amd64", "x64"}:
+        return "x86_64"
+    return normalized
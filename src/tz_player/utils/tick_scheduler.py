@@ -0,0 +1,137 @@
+"""Idle-aware, coalesced wakeups for the app's periodic loops.
+
+Position polling, the VLC worker, and visualizer rendering each woke on their
+own cadence even while nothing was playing. Loops now sleep through one
+scheduler that:
+- drives the player's poll tick, which the VLC worker piggybacks on instead of
+  running its own timer while playing,
+- parks playback-gated loops on an event while paused or stopped,
+- caps render rate while idle or while the terminal is unfocused, and
+- counts wakeups per channel, logged as ``event=tick_scheduler_wakeups`` on
+  every mode change and available via :meth:`TickScheduler.snapshot`.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import logging
+import threading
+import time
+from collections.abc import Callable
+
+logger = logging.getLogger(__name__)
+
+IDLE_RENDER_FPS = 2
+UNFOCUSED_RENDER_FPS = 5
+
+
+class TickScheduler:
+    """Shared wakeup policy for playback, polling, and render loops."""
+
+    def __init__(self, *, clock: Callable[[], float] = time.monotonic) -> None:
+        self._clock = clock
+        self._playing = False
+        self._focused = True
+        self._playing_event: asyncio.Event | None = None
+        self._counts: dict[str, int] = {}
+        self._logged_counts: dict[str, int] = {}
+        self._counts_lock = threading.Lock()
+        self._mode_started_s = clock()
+        self._listeners: list[Callable[[], None]] = []
+
+    @property
+    def playing(self) -> bool:
+        return self._playing
+
+    @property
+    def focused(self) -> bool:
+        return self._focused
+
+    @property
+    def mode(self) -> str:
+        if not self._playing:
+            return "idle"
+        return "active" if self._focused else "unfocused"
+
+    def add_listener(self, listener: Callable[[], None]) -> None:
+        """Call ``listener`` after every mode change."""
+        self._listeners.append(listener)
+
+    def set_playing(self, playing: bool) -> None:
+        playing = bool(playing)
+        if playing == self._playing:
+            return
+        self._log_mode_wakeups()
+        self._playing = playing
+        event = self._playing_event
+        if event is not None:
+            if playing:
+                event.set()
+            else:
+                event.clear()
+        self._notify_listeners()
+
+    def set_focused(self, focused: bool) -> None:
+        focused = bool(focused)
+        if focused == self._focused:
+            return
+        self._log_mode_wakeups()
+        self._focused = focused
+        self._notify_listeners()
+
+    async def sleep(self, channel: str, interval_s: float) -> None:
+        """Sleep one tick of ``channel`` and count the wakeup."""
+        await asyncio.sleep(max(0.0, float(interval_s)))
+        self.record_wakeup(channel)
+
+    async def wait_for_playing(self) -> None:
+        """Return once playback is active; parks without wakeups until then."""
+        if self._playing:
+            return
+        if self._playing_event is None:
+            self._playing_event = asyncio.Event()
+        await self._playing_event.wait()
+
+    def render_fps(self, configured_fps: int) -> int:
+        """Return the render rate allowed in the current mode."""
+        if not self._playing:
+            return min(configured_fps, IDLE_RENDER_FPS)
+        if not self._focused:
+            return min(configured_fps, UNFOCUSED_RENDER_FPS)
+        return configured_fps
+
+    def record_wakeup(self, channel: str) -> None:
+        """Count one wakeup; safe to call from worker threads."""
+        with self._counts_lock:
+            self._counts[channel] = self._counts.get(channel, 0) + 1
+
+    def snapshot(self) -> dict[str, int]:
+        """Return cumulative wakeups per channel."""
+        with self._counts_lock:
+            return dict(self._counts)
+
+    def _log_mode_wakeups(self) -> None:
+        now = self._clock()
+        with self._counts_lock:
+            totals = dict(self._counts)
+        wakeups = {
+            channel: count - self._logged_counts.get(channel, 0)
+            for channel, count in totals.items()
+        }
+        logger.info(
+            "Tick wakeups in %s mode",
+            self.mode,
+            extra={
+                "event": "tick_scheduler_wakeups",
+                "mode": self.mode,
+                "elapsed_s": round(max(0.0, now - self._mode_started_s), 3),
+                "wakeups": wakeups,
+                "total_wakeups": sum(wakeups.values()),
+            },
+        )
+        self._logged_counts = totals
+        self._mode_started_s = now
+
+    def _notify_listeners(self) -> None:
+        for listener in list(self._listeners):
+            listener()
@@ -0,0 +1,248 @@
+"""Versioned frame snapshots shared between the app and visualizer hosts.
+
+Most ``VisualizerFrameInput`` fields only change when ``PlayerState`` or the
+current track changes, while the render loop ticks at up to 30 FPS. The builder
+here derives those fields once per state version and reuses the same value
+objects for every frame until the next change. Track metadata is interned per
+track so repeated frames share one context, and isolated plugin runners ship
+only the fields that changed since the previous frame.
+
+When the beat service publishes an upcoming-onset schedule, ``beat_is_onset``
+is driven from it per render frame instead of from the last poll sample, so
+onsets land on the frame nearest their timestamp regardless of poll rate.
+Spectrum bands can likewise be resolved per frame from the extrapolated
+playhead instead of repeating the last polled frame.
+"""
+
+from __future__ import annotations
+
+from collections.abc import Callable
+from dataclasses import dataclass, fields, replace
+from functools import lru_cache
+from typing import TYPE_CHECKING, Any
+
+from .base import VisualizerFrameInput
+
+if TYPE_CHECKING:
+    from tz_player.services.player_service import PlayerState, TrackInfo
+
+_FRAME_FIELD_NAMES = tuple(field.name for field in fields(VisualizerFrameInput))
+# Onsets further behind the estimated playhead than this are consumed without
+# firing (after a seek or a stalled render loop) rather than fired late.
+_ONSET_STALE_MS = 250.0
+
+
+@dataclass(frozen=True)
+class TrackContext:
+    """Track-level frame fields, interned so frames share one instance."""
+
+    track_id: int | None
+    track_path: str | None
+    title: str | None
+    artist: str | None
+    album: str | None
+
+
+EMPTY_TRACK_CONTEXT = TrackContext(None, None, None, None, None)
+
+
+@lru_cache(maxsize=32)
+def intern_track_context(
+    track_id: int | None,
+    track_path: str | None,
+    title: str | None,
+    artist: str | None,
+    album: str | None,
+) -> TrackContext:
+    """Return the shared context for one track's identity and tags."""
+    return TrackContext(track_id, track_path, title, artist, album)
+
+
+class FrameSnapshotBuilder:
+    """Build frames from player state, re-deriving fields only on change.
+
+    ``version`` increments whenever the state or track snapshot changes, so
+    consumers can tell a new analysis frame apart from a clock-only tick.
+    """
+
+    __slots__ = ("_clock", "_fields", "_onsets", "_state", "_track", "version")
+
+    def __init__(self) -> None:
+        self._state: PlayerState | None = None
+        self._track: TrackInfo | None = None
+        self._fields: dict[str, Any] = {}
+        self._clock = PlayheadClock()
+        self._onsets = OnsetScheduler()
+        self.version = 0
+
+    def build(
+        self,
+        *,
+        frame_index: int,
+        monotonic_s: float,
+        width: int,
+        height: int,
+        state: PlayerState,
+        track: TrackInfo | None,
+        spectrum_at: Callable[[int], bytes | None] | None = None,
+    ) -> VisualizerFrameInput:
+        """Build one frame.
+
+        ``spectrum_at`` optionally resolves bands for a playhead position so
+        spectrum data advances at render rate rather than poll rate.
+        """
+        # PlayerState and TrackInfo are frozen and replaced on every change,
+        # so identity checks are enough to detect a new snapshot.
+        previous = self._state
+        if state is not previous or track is not self._track or not self._fields:
+            if track is not self._track:
+                self._onsets.reset()
+            if (
+                previous is None
+                or state.position_ms != previous.position_ms
+                or state.status != previous.status
+            ):
+                self._clock.anchor(state.position_ms, monotonic_s)
+            self._fields = _state_fields(state, _track_context(track))
+            self._state = state
+            self._track = track
+            self.version += 1
+        beat_is_onset = state.beat_is_onset
+        spectrum_bands = state.spectrum_bands
+        scheduled = bool(state.beat_onsets_ms) and state.beat_status == "ready"
+        interpolated = spectrum_at is not None and state.spectrum_status == "ready"
+        if scheduled or interpolated:
+            playhead_ms = self._clock.estimate_ms(
+                monotonic_s, speed=state.speed if state.status == "playing" else 0.0
+            )
+            if scheduled and state.beat_onsets_ms:
+                beat_is_onset = self._onsets.step(state.beat_onsets_ms, playhead_ms)
+            if interpolated and spectrum_at is not None:
+                spectrum_bands = spectrum_at(round(playhead_ms)) or spectrum_bands
+        return VisualizerFrameInput(
+            frame_index=frame_index,
+            monotonic_s=monotonic_s,
+            width=width,
+            height=height,
+            beat_is_onset=beat_is_onset,
+            spectrum_bands=spectrum_bands,
+            **self._fields,
+        )
+
+
+class PlayheadClock:
+    """Extrapolate the playhead between polled positions."""
+
+    __slots__ = ("_anchor_ms", "_anchor_s")
+
+    def __init__(self) -> None:
+        self._anchor_ms = 0.0
+        self._anchor_s = 0.0
+
+    def anchor(self, position_ms: int, monotonic_s: float) -> None:
+        """Record a polled playhead position observed at ``monotonic_s``."""
+        self._anchor_ms = float(max(0, position_ms))
+        self._anchor_s = monotonic_s
+
+    def estimate_ms(self, monotonic_s: float, *, speed: float) -> float:
+        elapsed_s = max(0.0, monotonic_s - self._anchor_s)
+        return self._anchor_ms + elapsed_s * 1000.0 * max(0.0, speed)
+
+
+class OnsetScheduler:
+    """Fire scheduled beat onsets on the render frame nearest each timestamp."""
+
+    __slots__ = ("_last_estimate_ms", "_last_fired_ms")
+
+    def __init__(self) -> None:
+        self._last_estimate_ms: float | None = None
+        self._last_fired_ms: int | None = None
+
+    def reset(self) -> None:
+        self._last_estimate_ms = None
+        self._last_fired_ms = None
+
+    def step(self, schedule: tuple[int, ...], playhead_ms: float) -> bool:
+        """Advance to ``playhead_ms`` and return whether an onset fires now."""
+        previous = self._last_estimate_ms
+        half_step = 0.0
+        if previous is not None:
+            if playhead_ms < previous - _ONSET_STALE_MS:
+                # Seeked backwards; earlier onsets may fire again.
+                self._last_fired_ms = None
+            elif playhead_ms > previous:
+                half_step = (playhead_ms - previous) / 2.0
+        self._last_estimate_ms = playhead_ms
+        fired = False
+        for onset in schedule:
+            if self._last_fired_ms is not None and onset <= self._last_fired_ms:
+                continue
+            if onset > playhead_ms + half_step:
+                break
+            self._last_fired_ms = onset
+            if onset >= playhead_ms - _ONSET_STALE_MS:
+                fired = True
+        return fired
+
+
+def frame_delta(
+    previous: VisualizerFrameInput, frame: VisualizerFrameInput
+) -> dict[str, Any]:
+    """Return fields of ``frame`` that differ from ``previous``."""
+    delta: dict[str, Any] = {}
+    for name in _FRAME_FIELD_NAMES:
+        value = getattr(frame, name)
+        prior = getattr(previous, name)
+        if value is not prior and value != prior:
+            delta[name] = value
+    return delta
+
+
+def apply_frame_delta(
+    base: VisualizerFrameInput, delta: dict[str, Any]
+) -> VisualizerFrameInput:
+    """Rebuild a frame from ``base`` plus a ``frame_delta`` result."""
+    if not delta:
+        return base
+    return replace(base, **delta)
+
+
+def _track_context(track: TrackInfo | None) -> TrackContext:
+    if track is None:
+        return EMPTY_TRACK_CONTEXT
+    return intern_track_context(
+        None, track.path, track.title, track.artist, track.album
+    )
+
+
+def _state_fields(state: PlayerState, track: TrackContext) -> dict[str, Any]:
+    return {
+        "status": state.status,
+        "position_s": max(0.0, state.position_ms / 1000.0),
+        "duration_s": state.duration_ms / 1000.0 if state.duration_ms > 0 else None,
+        "volume": float(state.volume),
+        "speed": state.speed,
+        "repeat_mode": state.repeat_mode,
+        "shuffle": state.shuffle,
+        "track_id": track.track_id,
+        "track_path": track.track_path,
+        "title": track.title,
+        "artist": track.artist,
+        "album": track.album,
+        "level_left": state.level_left,
+        "level_right": state.level_right,
+        "level_source": state.level_source,
+        "level_status": state.level_status,
+        "spectrum_source": state.spectrum_source,
+        "spectrum_status": state.spectrum_status,
+        "waveform_min_left": state.waveform_min_left,
+        "waveform_max_left": state.waveform_max_left,
+        "waveform_min_right": state.waveform_min_right,
+        "waveform_max_right": state.waveform_max_right,
+        "waveform_source": state.waveform_source,
+        "waveform_status": state.waveform_status,
+        "beat_strength": state.beat_strength,
+        "beat_bpm": state.beat_bpm,
+        "beat_source": state.beat_source,
+        "beat_status": state.beat_status,
+    }
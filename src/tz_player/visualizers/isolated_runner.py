@@ -17,6 +17,7 @@ from types import ModuleType
 from typing import Any, Protocol
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .frame_snapshot import apply_frame_delta, frame_delta
 
 
 class _ConnLike(Protocol):
@@ -63,6 +64,9 @@ class IsolatedPluginProxy:
         self._ctx = multiprocessing.get_context("spawn")
         self._conn: _ConnLike | None = None
         self._process: BaseProcess | None = None
+        # Last frame the worker holds; later renders send only changed fields.
+        self._sent_frame: VisualizerFrameInput | None = None
+        self._sent_version = 0
 
     def on_activate(self, context: VisualizerContext) -> None:
         self._ensure_started()
@@ -78,7 +82,25 @@ class IsolatedPluginProxy:
 
     def render(self, frame: VisualizerFrameInput) -> str:
         self._ensure_started()
-        result = self._request("render", {"frame": frame}, timeout_s=self._timeout_s)
+        base = self._sent_frame
+        payload: dict[str, Any]
+        if base is None:
+            payload = {"frame": frame, "version": self._sent_version + 1}
+        else:
+            payload = {
+                "delta": frame_delta(base, frame),
+                "base_version": self._sent_version,
+                "version": self._sent_version + 1,
+            }
+        self._sent_frame = frame
+        self._sent_version += 1
+        try:
+            result = self._request("render", payload, timeout_s=self._timeout_s)
+        except RuntimeError:
+            # Resync with a full frame next time in case the worker never
+            # applied this one.
+            self._sent_frame = None
+            raise
         return str(result)
 
     def _ensure_started(self) -> None:
@@ -111,6 +133,7 @@ class IsolatedPluginProxy:
         process = self._process
         self._conn = None
         self._process = None
+        self._sent_frame = None
         if conn is not None:
             try:
                 if process is not None and process.is_alive():
@@ -171,6 +194,8 @@ def _isolated_worker(
     expected_plugin_id: str,
 ) -> None:
     plugin: Any = None
+    frame: VisualizerFrameInput | None = None
+    frame_version = 0
     try:
         plugin_class = _load_plugin_class(
             source_kind=source_kind,
@@ -213,7 +238,15 @@ def _isolated_worker(
                 plugin.on_deactivate()
                 _safe_send(conn, {"ok": True, "result": None})
             elif op == "render":
-                result = plugin.render(payload["frame"])
+                if "frame" in payload:
+                    frame = payload["frame"]
+                elif frame is None or payload.get("base_version") != frame_version:
+                    frame = None
+                    raise RuntimeError("frame delta does not match worker snapshot")
+                else:
+                    frame = apply_frame_delta(frame, payload["delta"])
+                frame_version = int(payload.get("version", frame_version + 1))
+                result = plugin.render(frame)
                 _safe_send(conn, {"ok": True, "result": result})
             else:
                 _safe_send(conn, {"ok": False, "error": f"Unknown worker op '{op}'."})
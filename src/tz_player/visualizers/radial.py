@@ -7,6 +7,7 @@ import re
 from dataclasses import dataclass
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .spectrum_lut import collapse_bands_peak, heat_cells
 
 _SGR_PATTERN = re.compile(r"\x1b\[[0-9;]*m")
 
@@ -42,8 +43,8 @@ class RadialSpectrumVisualizer:
         beat_onset = bool(frame.beat_is_onset)
         spoke_count = max(16, min(64, len(bands) if bands else 32))
 
-        for spoke_idx in range(spoke_count):
-            level = _band_level(bands, spoke_idx, spoke_count)
+        levels = collapse_bands_peak(bands, spoke_count)
+        for spoke_idx, level in enumerate(levels):
             spoke_len = base_radius + ((max_radius - base_radius) * (level / 255.0))
             angle = (2.0 * math.pi * spoke_idx / spoke_count) + (
                 (frame.frame_index % 360) * math.pi / 720.0
@@ -62,19 +63,6 @@ class RadialSpectrumVisualizer:
         return _fit_lines(lines, width, height)
 
 
-def _band_level(bands: bytes, index: int, count: int) -> int:
-    if not bands:
-        return 0
-    start = int((index * len(bands)) / count)
-    end = int(((index + 1) * len(bands)) / count)
-    if end <= start:
-        end = min(len(bands), start + 1)
-    chunk = bands[start:end] if start < len(bands) else b""
-    if not chunk:
-        return 0
-    return int(max(chunk))
-
-
 def _draw_spoke(
     canvas: list[list[str]],
     cx: float,
@@ -133,13 +121,7 @@ def _status_line(frame: VisualizerFrameInput) -> str:
 
 
 def _colorize(glyph: str, level: int, ansi_enabled: bool) -> str:
-    if not ansi_enabled:
-        return glyph
-    if level < 96:
-        return f"\x1b[38;2;53;230;138m{glyph}\x1b[0m"
-    if level < 192:
-        return f"\x1b[38;2;242;201;76m{glyph}\x1b[0m"
-    return f"\x1b[38;2;255;90;54m{glyph}\x1b[0m"
+    return heat_cells(glyph, ansi_enabled)[max(0, min(255, level))]
 
 
 def _fit_lines(lines: list[str], width: int, height: int) -> str:
@@ -0,0 +1,302 @@
+"""Optional native render kernel with pure-Python fallbacks.
+
+Hot visualizer primitives (band collapse, bar rasterization, spectrogram row
+shading, and ANSI serialization with SGR coalescing) run in the bundled
+``tz_player_native_render`` shared library when it is present and fall back to
+equivalent Python implementations otherwise. Both paths produce identical
+output so plugins never branch on availability.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import logging
+import os
+import platform
+import re
+import sys
+from array import array
+from collections.abc import Mapping, Sequence
+from dataclasses import dataclass
+from functools import lru_cache
+from pathlib import Path
+
+from ..utils.platform_utils import normalize_machine
+from .spectrum_lut import (
+    SGR_RESET,
+    CellPalette,
+    collapse_bands_mean,
+    collapse_bands_peak,
+)
+
+logger = logging.getLogger(__name__)
+
+NATIVE_RENDER_LIB_ENV = "TZ_PLAYER_NATIVE_RENDER_LIB"
+NATIVE_RENDER_DISABLE_ENV = "TZ_PLAYER_DISABLE_NATIVE_RENDER"
+_ABI_VERSION = 1
+_CLASS_UNCOLORED = 0
+_CLASS_TRANSPARENT = 255
+# A run is one color class plus any uncolored spaces it swallows, or a bare
+# stretch of uncolored spaces.
+_CLASS_RUN_PATTERN = re.compile(rb"([^\xff])(?:\1|\xff)*|\xff+", re.DOTALL)
+_PLATFORM_TO_NATIVE_RENDER_LIB: dict[tuple[str, str], str] = {
+    ("linux", "x86_64"): "linux/x86_64/libtz_player_render.so",
+    ("win32", "x86_64"): "windows/x86_64/tz_player_render.dll",
+}
+
+
+def native_render_available(env: Mapping[str, str] | None = None) -> bool:
+    """Return whether the native render kernel loads under ``env``."""
+    values = os.environ if env is None else env
+    return (
+        _native_kernel(
+            values.get(NATIVE_RENDER_DISABLE_ENV, ""),
+            values.get(NATIVE_RENDER_LIB_ENV, ""),
+        )
+        is not None
+    )
+
+
+def collapse_bands(bands: bytes | None, width: int, *, peak: bool) -> bytes:
+    """Pool arbitrary band count into ``width`` u8 columns (max or mean)."""
+    if width <= 0:
+        return b""
+    if not bands:
+        return bytes(width)
+    kernel = _active_kernel()
+    if kernel is not None:
+        out = ctypes.create_string_buffer(width)
+        kernel.tzr_collapse_bands(bands, len(bands), width, int(peak), out)
+        return out.raw
+    if peak:
+        return bytes(collapse_bands_peak(bands, width))
+    return bytes(collapse_bands_mean(bands, width))
+
+
+def shade_levels(values: bytes, lut: bytes) -> bytes:
+    """Map u8 levels to cell ids through a 256-entry lookup table."""
+    if len(lut) != 256:
+        raise ValueError("shade_levels requires a 256-entry lookup table.")
+    # bytes.translate is already a C loop; no native round-trip needed.
+    return values.translate(lut)
+
+
+def rasterize_bars(
+    heights: Sequence[int], rows: int, *, cap_ids: bytes, body_ids: bytes
+) -> bytes:
+    """Rasterize bottom-up bar heights into a top-down ``rows * width`` grid."""
+    width = len(heights)
+    if rows <= 0 or width <= 0:
+        return b""
+    if len(cap_ids) != width or len(body_ids) != width:
+        raise ValueError("rasterize_bars requires one cap/body id per column.")
+    kernel = _active_kernel()
+    if kernel is not None:
+        out = ctypes.create_string_buffer(rows * width)
+        packed = array("i", heights)
+        address, _length = packed.buffer_info()
+        kernel.tzr_rasterize_bars(address, cap_ids, body_ids, width, rows, out)
+        return out.raw
+    # Build each column top-down with C-speed byte ops, then transpose via
+    # strided slices instead of visiting every cell from Python.
+    top = rows - 1
+    column_major = b"".join(
+        [
+            bytes(top - height)
+            + cap_ids[col : col + 1]
+            + body_ids[col : col + 1] * height
+            if 0 <= height <= top
+            else (body_ids[col : col + 1] * rows if height > top else bytes(rows))
+            for col, height in enumerate(heights)
+        ]
+    )
+    return b"".join([column_major[row::rows] for row in range(rows)])
+
+
+def serialize_grid(cells: bytes, width: int, palette: CellPalette) -> list[str]:
+    """Serialize a cell grid into lines, coalescing runs that share an SGR."""
+    if width <= 0 or not cells:
+        return []
+    rows = len(cells) // width
+    kernel = _active_kernel()
+    if kernel is not None:
+        blobs = _palette_blobs(palette)
+        capacity = rows * (width * blobs.max_cell_bytes + len(SGR_RESET) + 1)
+        out = ctypes.create_string_buffer(capacity)
+        written = kernel.tzr_serialize_grid(
+            cells,
+            width,
+            rows,
+            blobs.glyph_blob,
+            blobs.glyph_offsets,
+            blobs.sgr_blob,
+            blobs.sgr_offsets,
+            len(palette.glyphs),
+            out,
+            capacity,
+        )
+        if written >= 0:
+            return out.raw[:written].decode("utf-8").split("\n")
+    return [
+        _serialize_row(cells[start : start + width], palette)
+        for start in range(0, rows * width, width)
+    ]
+
+
+def _serialize_row(row: bytes, palette: CellPalette) -> str:
+    tables = _palette_tables(palette)
+    if tables.glyph_map is None:
+        text = "".join([palette.glyphs[cell] for cell in row])
+    else:
+        text = row.decode("latin-1").translate(tables.glyph_map)
+    if not palette.colored:
+        return text
+    # Walk color-class runs (uncolored spaces join the surrounding run) so the
+    # Python loop runs once per color change rather than once per cell.
+    classes = row.translate(tables.class_table)
+    out: list[str] = []
+    current = 0
+    for match in _CLASS_RUN_PATTERN.finditer(classes):
+        start, end = match.span()
+        run_class = classes[start]
+        if run_class == _CLASS_UNCOLORED and current:
+            out.append(SGR_RESET)
+            current = 0
+        elif run_class not in (_CLASS_UNCOLORED, _CLASS_TRANSPARENT) and (
+            run_class != current
+        ):
+            out.append(tables.class_sgrs[run_class])
+            current = run_class
+        out.append(text[start:end])
+    if current:
+        out.append(SGR_RESET)
+    return "".join(out)
+
+
+@dataclass(frozen=True)
+class _PaletteTables:
+    glyph_map: dict[int, str] | None
+    class_table: bytes
+    class_sgrs: tuple[str, ...]
+
+
+@lru_cache(maxsize=32)
+def _palette_tables(palette: CellPalette) -> _PaletteTables:
+    single_char = all(len(glyph) == 1 for glyph in palette.glyphs)
+    class_ids: dict[str, int] = {}
+    class_table = bytearray(256)
+    for cell, (glyph, sgr) in enumerate(zip(palette.glyphs, palette.sgrs)):
+        if not sgr:
+            class_table[cell] = _CLASS_TRANSPARENT if glyph == " " else 0
+            continue
+        class_table[cell] = class_ids.setdefault(sgr, len(class_ids) + 1)
+    return _PaletteTables(
+        glyph_map=dict(enumerate(palette.glyphs)) if single_char else None,
+        class_table=bytes(class_table),
+        class_sgrs=("",) + tuple(class_ids),
+    )
+
+
+@dataclass(frozen=True)
+class _PaletteBlobs:
+    glyph_blob: bytes
+    glyph_offsets: ctypes.Array[ctypes.c_int32]
+    sgr_blob: bytes
+    sgr_offsets: ctypes.Array[ctypes.c_int32]
+    max_cell_bytes: int
+
+
+@lru_cache(maxsize=32)
+def _palette_blobs(palette: CellPalette) -> _PaletteBlobs:
+    glyphs = [glyph.encode("utf-8") for glyph in palette.glyphs]
+    sgrs = [sgr.encode("utf-8") for sgr in palette.sgrs]
+    return _PaletteBlobs(
+        glyph_blob=b"".join(glyphs),
+        glyph_offsets=_offsets(glyphs),
+        sgr_blob=b"".join(sgrs),
+        sgr_offsets=_offsets(sgrs),
+        max_cell_bytes=max(len(g) + len(s) for g, s in zip(glyphs, sgrs))
+        + len(SGR_RESET),
+    )
+
+
+def _offsets(parts: list[bytes]) -> ctypes.Array[ctypes.c_int32]:
+    offsets = (ctypes.c_int32 * (len(parts) + 1))()
+    total = 0
+    for idx, part in enumerate(parts):
+        offsets[idx] = total
+        total += len(part)
+    offsets[len(parts)] = total
+    return offsets
+
+
+def _active_kernel() -> ctypes.CDLL | None:
+    # Keyed on raw env values so per-frame calls stay a dict lookup; path
+    # resolution and dlopen happen once per distinct configuration.
+    return _native_kernel(
+        os.environ.get(NATIVE_RENDER_DISABLE_ENV, ""),
+        os.environ.get(NATIVE_RENDER_LIB_ENV, ""),
+    )
+
+
+def _resolve_library_path(disable_raw: str, override_raw: str) -> str | None:
+    if disable_raw.strip().lower() in {"1", "true", "yes", "on"}:
+        return None
+    override = override_raw.strip()
+    if override:
+        return override
+    rel = _PLATFORM_TO_NATIVE_RENDER_LIB.get(
+        (sys.platform, normalize_machine(platform.machine()))
+    )
+    if rel is None:
+        return None
+    candidate = Path(__file__).resolve().parents[1] / "binaries" / rel
+    return str(candidate) if candidate.is_file() else None
+
+
+@lru_cache(maxsize=4)
+def _native_kernel(disable_raw: str, override_raw: str) -> ctypes.CDLL | None:
+    path = _resolve_library_path(disable_raw, override_raw)
+    if path is None:
+        return None
+    try:
+        lib = ctypes.CDLL(path)
+        if lib.tzr_abi_version() != _ABI_VERSION:
+            logger.warning("Native render kernel ABI mismatch at %s; ignoring.", path)
+            return None
+    except (OSError, AttributeError) as exc:
+        logger.warning("Failed to load native render kernel %s: %s", path, exc)
+        return None
+    u8_p = ctypes.c_char_p
+    lib.tzr_collapse_bands.argtypes = [
+        u8_p,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_char_p,
+    ]
+    lib.tzr_collapse_bands.restype = ctypes.c_int
+    lib.tzr_rasterize_bars.argtypes = [
+        ctypes.c_void_p,
+        u8_p,
+        u8_p,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_char_p,
+    ]
+    lib.tzr_rasterize_bars.restype = ctypes.c_int
+    lib.tzr_serialize_grid.argtypes = [
+        u8_p,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_int32),
+        ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_int32),
+        ctypes.c_int,
+        ctypes.c_char_p,
+        ctypes.c_long,
+    ]
+    lib.tzr_serialize_grid.restype = ctypes.c_long
+    logger.debug("Loaded native render kernel from %s", path)
+    return lib
@@ -0,0 +1,175 @@
+"""Size-keyed lookup tables shared by spectrum-driven visualizers.
+
+Band-to-column ranges, per-level glyph/color cells, and SGR prefixes only
+depend on band count, output size, and ANSI/Unicode capability. Builders here
+are memoized on exactly those keys so render paths become table lookups instead
+of per-frame arithmetic and string formatting.
+"""
+
+from __future__ import annotations
+
+from collections.abc import Sequence
+from dataclasses import dataclass
+from functools import lru_cache
+
+SGR_RESET = "\x1b[0m"
+HEAT_LOW_SGR = "\x1b[38;2;53;230;138m"
+HEAT_MID_SGR = "\x1b[38;2;242;201;76m"
+HEAT_HIGH_SGR = "\x1b[38;2;255;90;54m"
+_HEAT_TIER_SGR = (HEAT_LOW_SGR, HEAT_MID_SGR, HEAT_HIGH_SGR)
+HEAT_TIER_COUNT = len(_HEAT_TIER_SGR)
+
+ASCII_RAMP = " .:-=+*#%@"
+UNICODE_RAMP = " ▁▂▃▄▅▆▇█"
+
+# Large enough for every (band_count, width) pair seen across resizes without
+# letting a long session with many distinct sizes grow unbounded.
+_RANGE_CACHE_SIZE = 64
+
+
+@dataclass(frozen=True)
+class CellPalette:
+    """Cell-id palette: glyph plus optional SGR prefix per u8 cell id.
+
+    SGR prefixes must be complete foreground selections so serialization can
+    switch between them without an intermediate reset.
+    """
+
+    glyphs: tuple[str, ...]
+    sgrs: tuple[str, ...]
+
+    @classmethod
+    def build(cls, entries: Sequence[tuple[str, str]]) -> CellPalette:
+        if not entries or len(entries) > 256:
+            raise ValueError("CellPalette requires between 1 and 256 entries.")
+        return cls(
+            glyphs=tuple(glyph for glyph, _sgr in entries),
+            sgrs=tuple(sgr for _glyph, sgr in entries),
+        )
+
+    @property
+    def colored(self) -> bool:
+        return any(self.sgrs)
+
+
+@lru_cache(maxsize=_RANGE_CACHE_SIZE)
+def band_ranges(band_count: int, width: int) -> tuple[tuple[int, int], ...]:
+    """Return ``(start, end)`` band slice bounds for each output column."""
+    if band_count <= 0 or width <= 0:
+        return ((0, 0),) * max(0, width)
+    ranges: list[tuple[int, int]] = []
+    for idx in range(width):
+        start = int((idx * band_count) / width)
+        end = int(((idx + 1) * band_count) / width)
+        if end <= start:
+            end = min(band_count, start + 1)
+        if start >= band_count:
+            start = end = 0
+        ranges.append((start, end))
+    return tuple(ranges)
+
+
+def collapse_bands_mean(bands: bytes | None, width: int) -> list[int]:
+    """Average-pool arbitrary band count into ``width`` columns."""
+    if not bands:
+        return [0] * width
+    out: list[int] = []
+    for start, end in band_ranges(len(bands), width):
+        if end <= start:
+            out.append(0)
+            continue
+        out.append(int(round(sum(bands[start:end]) / (end - start))))
+    return out
+
+
+def collapse_bands_peak(bands: bytes | None, width: int) -> list[int]:
+    """Max-pool arbitrary band count into ``width`` columns."""
+    if not bands:
+        return [0] * width
+    return [
+        max(bands[start:end]) if end > start else 0
+        for start, end in band_ranges(len(bands), width)
+    ]
+
+
+def heat_sgr_for_u8(level_u8: int) -> str:
+    """Return the shared green/yellow/red SGR prefix for a 0..255 level."""
+    return _HEAT_TIER_SGR[_heat_tier_for_u8(level_u8)]
+
+
+@lru_cache(maxsize=16)
+def heat_cells(glyph: str, ansi_enabled: bool) -> tuple[str, ...]:
+    """Return 256 prebuilt heat-colored cells for one glyph."""
+    if not ansi_enabled:
+        return (glyph,) * 256
+    return tuple(f"{heat_sgr_for_u8(level)}{glyph}{SGR_RESET}" for level in range(256))
+
+
+@lru_cache(maxsize=_RANGE_CACHE_SIZE)
+def row_heat_tiers(rows: int) -> tuple[int, ...]:
+    """Return low/mid/high tier (0/1/2) per row level ``0..rows-1``."""
+    if rows <= 1:
+        return (0,) * max(1, rows)
+    out: list[int] = []
+    for level in range(rows):
+        ratio = max(0.0, min(1.0, level / (rows - 1)))
+        if ratio < 0.4:
+            out.append(0)
+        elif ratio < 0.75:
+            out.append(1)
+        else:
+            out.append(2)
+    return tuple(out)
+
+
+def tiered_base_id(glyph_idx: int) -> int:
+    """Return the `tiered_palette` id of ``glyph_idx`` at heat tier 0."""
+    return 1 + glyph_idx * HEAT_TIER_COUNT
+
+
+@lru_cache(maxsize=8)
+def tiered_palette(glyphs: tuple[str, ...], ansi_enabled: bool) -> CellPalette:
+    """Return a palette with id ``tiered_base_id(glyph_idx) + tier`` per tier.
+
+    Id 0 is an uncolored space so rasterized grids can leave cells empty.
+    """
+    entries: list[tuple[str, str]] = [(" ", "")]
+    for glyph in glyphs:
+        for sgr in _HEAT_TIER_SGR:
+            entries.append((glyph, sgr if ansi_enabled else ""))
+    return CellPalette.build(entries)
+
+
+@lru_cache(maxsize=4)
+def ramp_shading(
+    unicode_enabled: bool, ansi_enabled: bool
+) -> tuple[CellPalette, bytes]:
+    """Return spectrogram palette plus 256-entry level -> cell-id table."""
+    ramp = UNICODE_RAMP if unicode_enabled else ASCII_RAMP
+    palette = tiered_palette(tuple(ramp[1:]), ansi_enabled)
+    lut = bytearray(256)
+    for level in range(256):
+        glyph_idx = int(round((level / 255.0) * (len(ramp) - 1)))
+        if glyph_idx > 0:
+            lut[level] = tiered_base_id(glyph_idx - 1) + _heat_tier_for_u8(level)
+    return palette, bytes(lut)
+
+
+@lru_cache(maxsize=2)
+def fft_meter_shading(ansi_enabled: bool) -> tuple[CellPalette, bytes]:
+    """Return single-row FFT meter palette plus level -> cell-id table."""
+    entries: list[tuple[str, str]] = [(".", "")]
+    for glyph, sgr in (("-", HEAT_LOW_SGR), ("=", HEAT_MID_SGR), ("#", HEAT_HIGH_SGR)):
+        entries.append((glyph, sgr if ansi_enabled else ""))
+    lut = bytes(
+        0 if level < 32 else 1 + _heat_tier_for_u8(level) for level in range(256)
+    )
+    return CellPalette.build(entries), lut
+
+
+def _heat_tier_for_u8(level_u8: int) -> int:
+    if level_u8 < 96:
+        return 0
+    if level_u8 < 192:
+        return 1
+    return 2
@@ -6,6 +6,14 @@ import re
 from dataclasses import dataclass
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .render_kernel import collapse_bands, rasterize_bars, serialize_grid
+from .spectrum_lut import row_heat_tiers, tiered_base_id, tiered_palette
+
+_TERRAIN_GLYPHS = ("^", "#", ":")
+# Heat-tier-0 palette ids per glyph; add the row's heat tier to pick a color.
+_PEAK_BASE_ID = tiered_base_id(_TERRAIN_GLYPHS.index("^"))
+_RIDGE_BASE_ID = tiered_base_id(_TERRAIN_GLYPHS.index("#"))
+_SLOPE_BASE_ID = tiered_base_id(_TERRAIN_GLYPHS.index(":"))
 
 _SGR_PATTERN = re.compile(r"\x1b\[[0-9;]*m")
 
@@ -30,7 +38,7 @@ class AudioTerrainVisualizer:
         width = max(1, frame.width)
         height = max(1, frame.height)
         chart_rows = max(1, height - 2)
-        columns = _collapse_bands(frame.spectrum_bands, width)
+        columns = list(collapse_bands(frame.spectrum_bands, width, peak=False))
         peaks = _terrain_heights(columns, chart_rows, frame.beat_is_onset)
         lines = [
             "AUDIO TERRAIN",
@@ -47,24 +55,6 @@ def _status_line(frame: VisualizerFrameInput) -> str:
     return f"FFT {status} [{source}] BEAT {beat}"
 
 
-def _collapse_bands(bands: bytes | None, width: int) -> list[int]:
-    if not bands:
-        return [0] * width
-    out: list[int] = []
-    for idx in range(width):
-        start = int((idx * len(bands)) / width)
-        end = int(((idx + 1) * len(bands)) / width)
-        if end <= start:
-            end = min(len(bands), start + 1)
-        chunk = bands[start:end] if start < len(bands) else b""
-        if not chunk:
-            out.append(0)
-            continue
-        avg = int(round(sum(chunk) / len(chunk)))
-        out.append(avg)
-    return out
-
-
 def _terrain_heights(
     values: list[int], rows: int, beat_onset: bool | None
 ) -> list[int]:
@@ -82,47 +72,18 @@ def _terrain_heights(
 
 
 def _render_terrain(peaks: list[int], rows: int, ansi_enabled: bool) -> list[str]:
-    lines: list[str] = []
-    width = len(peaks)
-    for row_idx in range(rows):
-        threshold = rows - 1 - row_idx
-        cells: list[str] = []
-        for col_idx in range(width):
-            peak = peaks[col_idx]
-            if peak < threshold:
-                cells.append(" ")
-                continue
-            if peak == threshold:
-                cells.append(_terrain_top(peak, rows, ansi_enabled))
-                continue
-            cells.append(_terrain_fill(col_idx, peak, rows, ansi_enabled))
-        lines.append("".join(cells))
-    return lines
-
-
-def _terrain_top(peak: int, rows: int, ansi_enabled: bool) -> str:
-    glyph = "^"
-    if not ansi_enabled:
-        return glyph
-    return f"{_terrain_color(peak, rows)}{glyph}\x1b[0m"
-
-
-def _terrain_fill(col_idx: int, peak: int, rows: int, ansi_enabled: bool) -> str:
-    glyph = "#" if (col_idx % 3 == 0) else ":"
-    if not ansi_enabled:
-        return glyph
-    return f"{_terrain_color(peak, rows)}{glyph}\x1b[0m"
-
-
-def _terrain_color(level: int, rows: int) -> str:
-    if rows <= 1:
-        return "\x1b[38;2;53;230;138m"
-    ratio = max(0.0, min(1.0, level / (rows - 1)))
-    if ratio < 0.4:
-        return "\x1b[38;2;53;230;138m"
-    if ratio < 0.75:
-        return "\x1b[38;2;242;201;76m"
-    return "\x1b[38;2;255;90;54m"
+    if not peaks:
+        return [""] * rows
+    tiers = row_heat_tiers(rows)
+    cap_ids = bytes(_PEAK_BASE_ID + tiers[peak] for peak in peaks)
+    body_ids = bytes(
+        (_RIDGE_BASE_ID if col_idx % 3 == 0 else _SLOPE_BASE_ID) + tiers[peak]
+        for col_idx, peak in enumerate(peaks)
+    )
+    grid = rasterize_bars(peaks, rows, cap_ids=cap_ids, body_ids=body_ids)
+    return serialize_grid(
+        grid, len(peaks), tiered_palette(_TERRAIN_GLYPHS, ansi_enabled)
+    )
 
 
 def _fit_lines(lines: list[str], width: int, height: int) -> str:
@@ -155,7 +116,12 @@ def _truncate_ansi(text: str, width: int) -> str:
             remaining -= take
         if idx < len(codes):
             out.append(codes[idx])
-    return "".join(out)
+    truncated = "".join(out)
+    # Coalesced SGR runs span many cells; close any run cut by truncation.
+    emitted = _SGR_PATTERN.findall(truncated)
+    if emitted and emitted[-1] != "\x1b[0m":
+        truncated += "\x1b[0m"
+    return truncated
 
 
 def _strip_sgr(text: str) -> str:
@@ -7,8 +7,22 @@ import re
 from dataclasses import dataclass, field
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .render_kernel import collapse_bands, serialize_grid, shade_levels
+from .spectrum_lut import (
+    HEAT_HIGH_SGR,
+    HEAT_LOW_SGR,
+    HEAT_MID_SGR,
+    SGR_RESET,
+    fft_meter_shading,
+)
 
 _SGR_PATTERN = re.compile(r"\x1b\[[0-9;]*m")
+_METER_LOW_CELL = f"{HEAT_LOW_SGR}#{SGR_RESET}"
+_METER_MID_CELL = f"{HEAT_MID_SGR}#{SGR_RESET}"
+_METER_HIGH_CELL = f"{HEAT_HIGH_SGR}#{SGR_RESET}"
+_HISTORY_LOW_CELL = f"{HEAT_LOW_SGR}█{SGR_RESET}"
+_HISTORY_MID_CELL = f"{HEAT_MID_SGR}█{SGR_RESET}"
+_HISTORY_HIGH_CELL = f"{HEAT_HIGH_SGR}█{SGR_RESET}"
 
 
 @dataclass
@@ -140,11 +154,11 @@ def _color_meter(fill: int, empty: int, width: int, ansi_enabled: bool) -> str:
     parts: list[str] = []
     for idx in range(fill):
         if idx < green_end:
-            parts.append("\x1b[38;2;53;230;138m#\x1b[0m")
+            parts.append(_METER_LOW_CELL)
         elif idx < yellow_end:
-            parts.append("\x1b[38;2;242;201;76m#\x1b[0m")
+            parts.append(_METER_MID_CELL)
         else:
-            parts.append("\x1b[38;2;255;90;54m#\x1b[0m")
+            parts.append(_METER_HIGH_CELL)
     if empty > 0:
         parts.append("-" * empty)
     return "".join(parts)
@@ -182,18 +196,9 @@ def _spectrum_bar_line(
     if not bands:
         return "F [" + ("-" * width) + "]"
     # Collapse arbitrary band count into current width by max-pooling per bucket.
-    columns: list[int] = []
-    for idx in range(width):
-        start = int((idx * len(bands)) / width)
-        end = int(((idx + 1) * len(bands)) / width)
-        if end <= start:
-            end = min(len(bands), start + 1)
-        peak = max(bands[start:end]) if start < len(bands) else 0
-        columns.append(int(peak))
-    if ansi_enabled:
-        cells = "".join(_fft_color_cell(value) for value in columns)
-    else:
-        cells = "".join(_fft_ascii_cell(value) for value in columns)
+    columns = collapse_bands(bands, width, peak=True)
+    palette, lut = fft_meter_shading(ansi_enabled)
+    cells = serialize_grid(shade_levels(columns, lut), width, palette)[0]
     return f"F [{cells}]"
 
 
@@ -205,26 +210,6 @@ def _source_line(source: str) -> str:
     return "SRC SIMULATED FALLBACK"
 
 
-def _fft_ascii_cell(level_u8: int) -> str:
-    if level_u8 >= 192:
-        return "#"
-    if level_u8 >= 96:
-        return "="
-    if level_u8 >= 32:
-        return "-"
-    return "."
-
-
-def _fft_color_cell(level_u8: int) -> str:
-    if level_u8 < 32:
-        return "."
-    if level_u8 < 96:
-        return "\x1b[38;2;53;230;138m-\x1b[0m"
-    if level_u8 < 192:
-        return "\x1b[38;2;242;201;76m=\x1b[0m"
-    return "\x1b[38;2;255;90;54m#\x1b[0m"
-
-
 def _source_token(level_source: str | None) -> str:
     if level_source == "live":
         return "LIVE"
@@ -261,10 +246,10 @@ def _history_block(
 
 def _level_glyph(level: float) -> str:
     if level < 0.7:
-        return "\x1b[38;2;53;230;138m█\x1b[0m"
+        return _HISTORY_LOW_CELL
     if level < 0.9:
-        return "\x1b[38;2;242;201;76m█\x1b[0m"
-    return "\x1b[38;2;255;90;54m█\x1b[0m"
+        return _HISTORY_MID_CELL
+    return _HISTORY_HIGH_CELL
 
 
 def _fit_lines(lines: list[str], width: int, height: int) -> str:
@@ -312,7 +297,12 @@ def _truncate_ansi(text: str, width: int) -> str:
             remaining -= take
         if idx < len(codes):
             out.append(codes[idx])
-    return "".join(out)
+    truncated = "".join(out)
+    # Coalesced SGR runs span many cells; close any run cut by truncation.
+    emitted = _SGR_PATTERN.findall(truncated)
+    if emitted and emitted[-1] != "\x1b[0m":
+        truncated += "\x1b[0m"
+    return truncated
 
 
 def _strip_sgr(text: str) -> str:
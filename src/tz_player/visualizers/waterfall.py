@@ -6,10 +6,11 @@ import re
 from dataclasses import dataclass, field
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .render_kernel import collapse_bands, serialize_grid, shade_levels
+from .spectrum_lut import ramp_shading
 
 _SGR_PATTERN = re.compile(r"\x1b\[[0-9;]*m")
-_ASCII_RAMP = " .:-=+*#%@"
-_UNICODE_RAMP = " ▁▂▃▄▅▆▇█"
+_BEAT_BOOST = bytes(min(255, value + 40) for value in range(256))
 
 
 @dataclass
@@ -22,7 +23,7 @@ class SpectrogramWaterfallVisualizer:
     requires_spectrum: bool = True
     _ansi_enabled: bool = True
     _unicode_enabled: bool = True
-    _history: list[list[int]] = field(default_factory=list)
+    _history: list[bytes] = field(default_factory=list)
 
     def on_activate(self, context: VisualizerContext) -> None:
         self._ansi_enabled = context.ansi_enabled
@@ -37,9 +38,9 @@ class SpectrogramWaterfallVisualizer:
         height = max(1, frame.height)
         grid_height = max(1, height - 2)
         grid_width = max(1, width - 1)
-        newest = _collapse_bands(frame.spectrum_bands, grid_width)
+        newest = collapse_bands(frame.spectrum_bands, grid_width, peak=True)
         if frame.beat_is_onset:
-            newest = [min(255, value + 40) for value in newest]
+            newest = newest.translate(_BEAT_BOOST)
         self._history.insert(0, newest)
         if len(self._history) > grid_height:
             self._history = self._history[:grid_height]
@@ -48,16 +49,16 @@ class SpectrogramWaterfallVisualizer:
             "SPECTRO WATERFALL",
             _status_line(frame),
         ]
-        for row_idx in range(grid_height):
-            row = (
-                self._history[row_idx]
-                if row_idx < len(self._history)
-                else [0] * (grid_width)
-            )
+        rows = _render_rows(
+            self._history,
+            grid_width,
+            grid_height,
+            self._ansi_enabled,
+            self._unicode_enabled,
+        )
+        for row_idx, row in enumerate(rows):
             marker = ">" if row_idx == 0 and frame.beat_is_onset else " "
-            lines.append(
-                marker + _render_row(row, self._ansi_enabled, self._unicode_enabled)
-            )
+            lines.append(marker + row)
         return _fit_lines(lines, width, height)
 
 
@@ -68,35 +69,21 @@ def _status_line(frame: VisualizerFrameInput) -> str:
     return f"FFT {status} [{source}] BEAT {beat}"
 
 
-def _collapse_bands(bands: bytes | None, width: int) -> list[int]:
-    if not bands:
-        return [0] * width
-    columns: list[int] = []
-    for idx in range(width):
-        start = int((idx * len(bands)) / width)
-        end = int(((idx + 1) * len(bands)) / width)
-        if end <= start:
-            end = min(len(bands), start + 1)
-        peak = max(bands[start:end]) if start < len(bands) else 0
-        columns.append(int(peak))
-    return columns
-
-
-def _render_row(values: list[int], ansi_enabled: bool, unicode_enabled: bool) -> str:
-    ramp = _UNICODE_RAMP if unicode_enabled else _ASCII_RAMP
-    return "".join(_render_cell(value, ramp, ansi_enabled) for value in values)
-
-
-def _render_cell(level_u8: int, ramp: str, ansi_enabled: bool) -> str:
-    idx = int(round((max(0, min(255, int(level_u8))) / 255.0) * (len(ramp) - 1)))
-    glyph = ramp[idx]
-    if not ansi_enabled or glyph == " ":
-        return glyph
-    if level_u8 < 96:
-        return f"\x1b[38;2;53;230;138m{glyph}\x1b[0m"
-    if level_u8 < 192:
-        return f"\x1b[38;2;242;201;76m{glyph}\x1b[0m"
-    return f"\x1b[38;2;255;90;54m{glyph}\x1b[0m"
+def _render_rows(
+    history: list[bytes],
+    width: int,
+    height: int,
+    ansi_enabled: bool,
+    unicode_enabled: bool,
+) -> list[str]:
+    """Shade and serialize the whole history grid in one pass."""
+    levels = b"".join(
+        row if len(row) == width else row[:width].ljust(width, b"\x00")
+        for row in history[:height]
+    )
+    levels += bytes(width * (height - min(height, len(history))))
+    palette, lut = ramp_shading(unicode_enabled, ansi_enabled)
+    return serialize_grid(shade_levels(levels, lut), width, palette)
 
 
 def _fit_lines(lines: list[str], width: int, height: int) -> str:
@@ -129,7 +116,12 @@ def _truncate_ansi(text: str, width: int) -> str:
             remaining -= take
         if idx < len(codes):
             out.append(codes[idx])
-    return "".join(out)
+    truncated = "".join(out)
+    # Coalesced SGR runs span many cells; close any run cut by truncation.
+    emitted = _SGR_PATTERN.findall(truncated)
+    if emitted and emitted[-1] != "\x1b[0m":
+        truncated += "\x1b[0m"
+    return truncated
 
 
 def _strip_sgr(text: str) -> str:
@@ -7,8 +7,25 @@ import re
 from dataclasses import dataclass
 
 from .base import VisualizerContext, VisualizerFrameInput
+from .render_kernel import serialize_grid
+from .spectrum_lut import CellPalette
 
 _SGR_PATTERN = re.compile(r"\x1b\[[0-9;]*m")
+_EMPTY = 0
+_GLOW = 1
+_LEFT = 2
+_RIGHT = 3
+_OVERLAP = 4
+_NEON_PALETTE = CellPalette.build(
+    [
+        (" ", ""),
+        ("·", "\x1b[38;2;66;245;224m"),
+        ("●", "\x1b[38;2;62;132;255m"),
+        ("■", "\x1b[38;2;255;77;163m"),
+        ("◆", "\x1b[38;2;255;194;62m"),
+    ]
+)
+_PLAIN_PALETTE = CellPalette.build([(glyph, "") for glyph in _NEON_PALETTE.glyphs])
 
 
 @dataclass
@@ -40,7 +57,7 @@ class WaveformNeonVisualizer:
         left_amp = max(0.05, (left_max - left_min) * 0.5)
         right_amp = max(0.05, (right_max - right_min) * 0.5)
 
-        canvas = [[" " for _ in range(width)] for _ in range(chart_height)]
+        canvas = bytearray(width * chart_height)
         for x in range(width):
             phase = (frame.frame_index * 0.23) + (x * 0.21)
             left_value = _clamp(left_center + (math.sin(phase) * left_amp))
@@ -49,14 +66,20 @@ class WaveformNeonVisualizer:
             )
             left_y = _to_row(left_value, chart_height)
             right_y = _to_row(right_value, chart_height)
-            _set_glow(canvas, x, left_y, primary=True)
-            _set_glow(canvas, x, right_y, primary=False)
+            _set_glow(canvas, width, x, left_y, primary=True)
+            _set_glow(canvas, width, x, right_y, primary=False)
 
         lines = [
             f"WaveformNeon [{source}/{status}]",
             _render_status_line(left_amp, right_amp, width),
         ]
-        lines.extend(_render_canvas(canvas, ansi_enabled=self._ansi_enabled))
+        lines.extend(
+            serialize_grid(
+                bytes(canvas),
+                width,
+                _NEON_PALETTE if self._ansi_enabled else _PLAIN_PALETTE,
+            )
+        )
         return _fit_lines(lines, width, height)
 
 
@@ -80,19 +103,20 @@ def _resolve_ranges(
     return (-left, left, -right, right)
 
 
-def _set_glow(canvas: list[list[str]], x: int, y: int, *, primary: bool) -> None:
-    height = len(canvas)
+def _set_glow(canvas: bytearray, width: int, x: int, y: int, *, primary: bool) -> None:
+    height = len(canvas) // width
     if not (0 <= y < height):
         return
+    idx = (y * width) + x
     if primary:
-        canvas[y][x] = "●"
-    elif canvas[y][x] == "●":
-        canvas[y][x] = "◆"
+        canvas[idx] = _LEFT
+    elif canvas[idx] == _LEFT:
+        canvas[idx] = _OVERLAP
     else:
-        canvas[y][x] = "■"
+        canvas[idx] = _RIGHT
     for ny in (y - 1, y + 1):
-        if 0 <= ny < height and canvas[ny][x] == " ":
-            canvas[ny][x] = "·"
+        if 0 <= ny < height and canvas[(ny * width) + x] == _EMPTY:
+            canvas[(ny * width) + x] = _GLOW
 
 
 def _render_status_line(left_amp: float, right_amp: float, width: int) -> str:
@@ -105,24 +129,6 @@ def _render_status_line(left_amp: float, right_amp: float, width: int) -> str:
     return text
 
 
-def _render_canvas(canvas: list[list[str]], *, ansi_enabled: bool) -> list[str]:
-    if not ansi_enabled:
-        return ["".join(row) for row in canvas]
-    return ["".join(_colorize(cell) for cell in row) for row in canvas]
-
-
-def _colorize(cell: str) -> str:
-    if cell == " ":
-        return cell
-    if cell == "·":
-        return f"\x1b[38;2;66;245;224m{cell}\x1b[0m"
-    if cell == "●":
-        return f"\x1b[38;2;62;132;255m{cell}\x1b[0m"
-    if cell == "■":
-        return f"\x1b[38;2;255;77;163m{cell}\x1b[0m"
-    return f"\x1b[38;2;255;194;62m{cell}\x1b[0m"
-
-
 def _to_row(value: float, height: int) -> int:
     normalized = (_clamp(value) + 1.0) * 0.5
     return max(0, min(height - 1, int(round((1.0 - normalized) * (height - 1)))))
@@ -158,7 +164,12 @@ def _truncate_ansi(text: str, width: int) -> str:
             remaining -= take
         if idx < len(codes):
             out.append(codes[idx])
-    return "".join(out)
+    truncated = "".join(out)
+    # Coalesced SGR runs span many cells; close any run cut by truncation.
+    emitted = _SGR_PATTERN.findall(truncated)
+    if emitted and emitted[-1] != "\x1b[0m":
+        truncated += "\x1b[0m"
+    return truncated
 
 
 def _strip_sgr(text: str) -> str:
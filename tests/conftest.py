@@ -26,7 +26,7 @@ def run_blocking_inline(monkeypatch: pytest.MonkeyPatch):
     async def _inline(func, /, *args, **kwargs):
         return func(*args, **kwargs)
 
-    monkeypatch.setattr(playlist_store_module, "run_blocking", _inline)
+    monkeypatch.setattr(playlist_store_module, "run_db", _inline)
     monkeypatch.setattr(metadata_service_module, "run_blocking", _inline)
     monkeypatch.setattr(app_module, "run_blocking", _inline)
     monkeypatch.setattr(playlist_pane_module, "run_blocking", _inline)
@@ -0,0 +1,128 @@
+"""Tests for the in-process analysis availability index."""
+
+from __future__ import annotations
+
+import asyncio
+from pathlib import Path
+
+from tz_player.services.analysis_availability import AnalysisAvailabilityIndex
+from tz_player.services.analysis_cache_db import list_analysis_entries
+from tz_player.services.beat_store import BeatParams
+from tz_player.services.spectrum_service import SpectrumService
+from tz_player.services.spectrum_store import (
+    SpectrumFrame,
+    SpectrumParams,
+    SqliteSpectrumStore,
+)
+
+
+class _CountingMissProvider:
+    def __init__(self) -> None:
+        self.lookups = 0
+
+    async def get_frame_at(
+        self,
+        track_path: str,
+        *,
+        position_ms: int,
+        params: SpectrumParams,
+    ) -> SpectrumFrame | None:
+        del track_path, position_ms, params
+        self.lookups += 1
+        return None
+
+    async def has_spectrum(self, track_path: str, *, params: SpectrumParams) -> bool:
+        del track_path, params
+        return False
+
+
+def _run(coro):
+    return asyncio.run(coro)
+
+
+def test_pending_and_failed_tracks_skip_store_lookups() -> None:
+    now = [0.0]
+    index = AnalysisAvailabilityIndex(failed_retry_s=60.0, clock=lambda: now[0])
+    provider = _CountingMissProvider()
+    scheduled: list[str] = []
+
+    async def schedule(track_path: str, params: SpectrumParams) -> None:
+        del params
+        scheduled.append(track_path)
+
+    service = SpectrumService(
+        cache_provider=provider, schedule_analysis=schedule, availability=index
+    )
+    params = SpectrumParams(band_count=4)
+
+    async def sample(path: str):
+        return await service.sample(track_path=path, position_ms=0, params=params)
+
+    index.mark_pending("/music/a.mp3", SqliteSpectrumStore.ANALYSIS_TYPE, params)
+    assert _run(sample("/music/a.mp3")).status == "loading"
+    index.mark_failed("/music/b.mp3", SqliteSpectrumStore.ANALYSIS_TYPE, params)
+    assert _run(sample("/music/b.mp3")).status == "missing"
+    assert provider.lookups == 0
+    assert scheduled == []
+
+    now[0] = 61.0
+    assert _run(sample("/music/b.mp3")).status == "loading"
+    assert provider.lookups == 1
+    assert scheduled == ["/music/b.mp3"]
+
+
+def test_ready_entries_follow_file_fingerprint(tmp_path: Path) -> None:
+    track = tmp_path / "song.mp3"
+    track.write_bytes(b"audio")
+    index = AnalysisAvailabilityIndex()
+    params = BeatParams(hop_ms=40)
+
+    index.mark_ready(track, "beat", params)
+    assert index.is_ready(track, "beat", params)
+    assert not index.is_ready(track, "beat", BeatParams(hop_ms=20))
+
+    track.write_bytes(b"re-encoded audio")
+    assert not index.is_ready(track, "beat", params)
+
+    index.mark_pending(track, "beat", params)
+    index.clear_pending(track, "beat", params)
+    assert index.state(track, "beat", params) is None
+
+
+def test_index_seeds_ready_entries_from_cache_db(tmp_path: Path) -> None:
+    cache_db = tmp_path / "analysis.sqlite"
+    store = SqliteSpectrumStore(cache_db)
+    _run(store.initialize())
+    track = tmp_path / "song.mp3"
+    track.write_bytes(b"audio")
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    _run(
+        store.upsert_spectrum(
+            track, duration_ms=80, params=params, frames=[(0, b"\x01\x02")]
+        )
+    )
+
+    index = AnalysisAvailabilityIndex()
+    types = {SqliteSpectrumStore.ANALYSIS_TYPE: SpectrumParams}
+    assert index.load_ready(list_analysis_entries(cache_db), types) == 0
+    loaded = index.load_ready(
+        list_analysis_entries(cache_db),
+        types,
+        analysis_versions={
+            SqliteSpectrumStore.ANALYSIS_TYPE: SqliteSpectrumStore.ANALYSIS_VERSION
+        },
+    )
+    assert loaded == 1
+    assert index.is_ready(track, SqliteSpectrumStore.ANALYSIS_TYPE, params)
+    index.clear_ready()
+    assert len(index) == 0
+
+
+def test_string_and_path_keys_normalize_like_the_stores(tmp_path: Path) -> None:
+    track = tmp_path / "song.mp3"
+    track.write_bytes(b"audio")
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    index = AnalysisAvailabilityIndex()
+    index.mark_ready(f"{tmp_path}//./song.mp3", "spectrum", params)
+    assert index.is_ready(track, "spectrum", params)
+    assert index.state(str(track), "spectrum", params) == "ready"
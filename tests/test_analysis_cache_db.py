@@ -0,0 +1,108 @@
+"""Tests for the dedicated analysis-cache database."""
+
+from __future__ import annotations
+
+import asyncio
+import sqlite3
+from pathlib import Path
+
+from tz_player.db.schema import create_schema
+from tz_player.services.analysis_cache_db import (
+    ANALYSIS_CACHE_PAGE_SIZE,
+    import_legacy_analysis_cache,
+)
+from tz_player.services.analysis_cache_pruner import SqliteAnalysisCachePruner
+from tz_player.services.spectrum_store import SpectrumParams, SqliteSpectrumStore
+
+
+def _run(coro):
+    return asyncio.run(coro)
+
+
+def test_new_cache_db_uses_cache_settings(tmp_path) -> None:
+    cache_db = tmp_path / "analysis.sqlite"
+    _run(SqliteSpectrumStore(cache_db).initialize())
+    with sqlite3.connect(cache_db) as conn:
+        assert conn.execute("PRAGMA page_size").fetchone()[0] == (
+            ANALYSIS_CACHE_PAGE_SIZE
+        )
+        assert conn.execute("PRAGMA auto_vacuum").fetchone()[0] == 2
+        assert conn.execute("PRAGMA journal_mode").fetchone()[0] == "wal"
+
+
+def test_legacy_analysis_rows_move_out_of_library_db(tmp_path) -> None:
+    library_db = tmp_path / "library.sqlite"
+    with sqlite3.connect(library_db) as conn:
+        create_schema(conn)
+    track = tmp_path / "song.mp3"
+    track.write_bytes(b"audio")
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    _run(SqliteSpectrumStore(library_db).initialize())
+    _run(
+        SqliteSpectrumStore(library_db).upsert_spectrum(
+            track, duration_ms=80, params=params, frames=[(0, b"\x01\x02")]
+        )
+    )
+
+    cache_db = tmp_path / "analysis.sqlite"
+    store = SqliteSpectrumStore(cache_db)
+    _run(store.initialize())
+    assert import_legacy_analysis_cache(cache_db, library_db) == 1
+    frames = _run(store.list_frames(track, params=params))
+    assert [frame.bands for frame in frames] == [b"\x01\x02"]
+    with sqlite3.connect(library_db) as conn:
+        tables = {
+            row[0]
+            for row in conn.execute(
+                "SELECT name FROM sqlite_master WHERE type = 'table'"
+            )
+        }
+        assert conn.execute("PRAGMA freelist_count").fetchone()[0] == 0
+    assert "playlists" in tables
+    assert not {"analysis_cache_entries", "analysis_spectrum_frames"} & tables
+    assert import_legacy_analysis_cache(cache_db, library_db) == 0
+
+
+def test_new_library_db_has_no_analysis_tables(tmp_path: Path) -> None:
+    library_db = tmp_path / "library.sqlite"
+    with sqlite3.connect(library_db) as conn:
+        create_schema(conn)
+        tables = {
+            row[0]
+            for row in conn.execute(
+                "SELECT name FROM sqlite_master WHERE type = 'table'"
+            )
+        }
+    assert "playlists" in tables
+    assert not {"analysis_cache_entries", "audio_envelopes"} & tables
+    cache_db = tmp_path / "analysis.sqlite"
+    _run(SqliteSpectrumStore(cache_db).initialize())
+    assert import_legacy_analysis_cache(cache_db, library_db) == 0
+
+
+def test_prune_releases_pages_with_incremental_vacuum(tmp_path: Path) -> None:
+    cache_db = tmp_path / "analysis.sqlite"
+    store = SqliteSpectrumStore(cache_db)
+    _run(store.initialize())
+    params = SpectrumParams(band_count=48, hop_ms=40)
+    for idx in range(4):
+        track = tmp_path / f"song{idx}.mp3"
+        track.write_bytes(bytes([idx]) * 32)
+        _run(
+            store.upsert_spectrum(
+                track,
+                duration_ms=80_000,
+                params=params,
+                frames=[(pos * 40, bytes([idx]) * 48) for pos in range(2000)],
+            )
+        )
+    with sqlite3.connect(cache_db) as conn:
+        pages_before = conn.execute("PRAGMA page_count").fetchone()[0]
+    result = _run(
+        SqliteAnalysisCachePruner(cache_db).prune(
+            max_cache_bytes=0, max_age_days=30, min_recent_tracks_protected=0
+        )
+    )
+    assert result.entries_pruned == 4
+    with sqlite3.connect(cache_db) as conn:
+        assert conn.execute("PRAGMA page_count").fetchone()[0] < pages_before
@@ -6,14 +6,20 @@ import asyncio
 import sqlite3
 import time
 
-from tz_player.db.schema import create_schema
 from tz_player.services.analysis_cache_pruner import SqliteAnalysisCachePruner
+from tz_player.services.audio_envelope_store import SqliteEnvelopeStore
+from tz_player.services.spectrum_store import SqliteSpectrumStore
 
 
 def _run(coro):
     return asyncio.run(coro)
 
 
+def _create_cache_db(db_path) -> None:
+    _run(SqliteEnvelopeStore(db_path).initialize())
+    _run(SqliteSpectrumStore(db_path).initialize())
+
+
 def _insert_entry(
     conn: sqlite3.Connection,
     *,
@@ -61,9 +67,9 @@ def _insert_entry(
 
 
 def test_analysis_cache_pruner_threshold_check(tmp_path) -> None:
-    db_path = tmp_path / "library.sqlite"
+    db_path = tmp_path / "analysis.sqlite"
+    _create_cache_db(db_path)
     with sqlite3.connect(db_path) as conn:
-        create_schema(conn)
         _insert_entry(
             conn,
             entry_id=1,
@@ -79,9 +85,9 @@ def test_analysis_cache_pruner_threshold_check(tmp_path) -> None:
 
 
 def test_analysis_cache_pruner_prunes_by_age_and_size(tmp_path) -> None:
-    db_path = tmp_path / "library.sqlite"
+    db_path = tmp_path / "analysis.sqlite"
+    _create_cache_db(db_path)
     with sqlite3.connect(db_path) as conn:
-        create_schema(conn)
         _insert_entry(
             conn,
             entry_id=1,
@@ -0,0 +1,130 @@
+"""Tests for content-addressed analysis cache identity."""
+
+from __future__ import annotations
+
+import asyncio
+import shutil
+import sqlite3
+from pathlib import Path
+
+import pytest
+
+from tz_player.db.schema import create_schema
+from tz_player.services.analysis_content_key import (
+    CONTENT_KEY_DISABLE_ENV,
+    content_key_for_path,
+)
+from tz_player.services.beat_store import BeatParams, SqliteBeatStore
+from tz_player.services.spectrum_store import SpectrumParams, SqliteSpectrumStore
+
+_AUDIO = bytes(range(256)) * 1024
+
+
+def _run(coro):
+    return asyncio.run(coro)
+
+
+def _id3v2(payload: bytes) -> bytes:
+    size = len(payload)
+    syncsafe = bytes(
+        [(size >> 21) & 0x7F, (size >> 14) & 0x7F, (size >> 7) & 0x7F, size & 0x7F]
+    )
+    return b"ID3\x04\x00\x00" + syncsafe + payload
+
+
+def _key(path: Path) -> str | None:
+    stat = path.stat()
+    return content_key_for_path(path, stat.st_mtime_ns, stat.st_size)
+
+
+def test_content_key_ignores_leading_and_trailing_tag_blocks(tmp_path) -> None:
+    plain = tmp_path / "plain.mp3"
+    plain.write_bytes(_AUDIO)
+    tagged = tmp_path / "tagged.mp3"
+    tagged.write_bytes(_id3v2(b"TIT2 some title" * 40) + _AUDIO + b"TAG" + bytes(125))
+    retagged = tmp_path / "retagged.mp3"
+    retagged.write_bytes(_id3v2(b"TIT2 other" * 3) + _AUDIO)
+    other = tmp_path / "other.mp3"
+    other.write_bytes(_AUDIO[:-1] + b"\x00")
+
+    key = _key(plain)
+    assert key is not None
+    assert _key(tagged) == key
+    assert _key(retagged) == key
+    assert _key(other) != key
+
+
+def test_relocated_and_duplicate_tracks_reuse_analysis(tmp_path) -> None:
+    db_path = tmp_path / "library.sqlite"
+    spectrum = SqliteSpectrumStore(db_path)
+    beats = SqliteBeatStore(db_path)
+    _run(spectrum.initialize())
+    _run(beats.initialize())
+    original = tmp_path / "a" / "song.mp3"
+    original.parent.mkdir()
+    original.write_bytes(_AUDIO)
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    _run(
+        spectrum.upsert_spectrum(
+            original, duration_ms=80, params=params, frames=[(0, b"\x01\x02")]
+        )
+    )
+    _run(
+        beats.upsert_beats(
+            original,
+            duration_ms=80,
+            params=BeatParams(),
+            bpm=120.0,
+            frames=[(0, 200, True)],
+        )
+    )
+
+    moved = tmp_path / "b" / "song.mp3"
+    moved.parent.mkdir()
+    shutil.copyfile(original, moved)
+    original.unlink()
+
+    assert _run(spectrum.has_spectrum(moved, params=params)) is True
+    frames = _run(spectrum.list_frames(moved, params=params))
+    assert [frame.bands for frame in frames] == [b"\x01\x02"]
+    assert _run(beats.has_beats(moved, params=BeatParams())) is True
+    assert not _run(spectrum.has_spectrum(moved, params=SpectrumParams(band_count=3)))
+
+
+def test_content_key_can_be_disabled(tmp_path, monkeypatch: pytest.MonkeyPatch) -> None:
+    db_path = tmp_path / "library.sqlite"
+    store = SqliteSpectrumStore(db_path)
+    _run(store.initialize())
+    first = tmp_path / "first.mp3"
+    first.write_bytes(_AUDIO)
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    _run(
+        store.upsert_spectrum(
+            first, duration_ms=80, params=params, frames=[(0, b"\x01\x02")]
+        )
+    )
+    copy = tmp_path / "copy.mp3"
+    shutil.copyfile(first, copy)
+    monkeypatch.setenv(CONTENT_KEY_DISABLE_ENV, "1")
+    assert _run(store.has_spectrum(copy, params=params)) is False
+
+
+def test_schema_v8_adds_content_key_column(tmp_path) -> None:
+    with sqlite3.connect(tmp_path / "library.sqlite") as conn:
+        conn.execute(
+            """
+            CREATE TABLE analysis_cache_entries (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                analysis_type TEXT NOT NULL,
+                path_norm TEXT NOT NULL,
+                analysis_version INTEGER NOT NULL,
+                params_hash TEXT NOT NULL
+            )
+            """
+        )
+        conn.execute("PRAGMA user_version = 7")
+        create_schema(conn)
+        columns = {
+            row[1] for row in conn.execute("PRAGMA table_info(analysis_cache_entries)")
+        }
+        assert "content_key" in columns
@@ -0,0 +1,61 @@
+"""Tests for analysis I/O pacing."""
+
+from __future__ import annotations
+
+import wave
+from pathlib import Path
+
+from tz_player.services import audio_decode
+from tz_player.services.analysis_io import IoTokenBucket
+
+
+class _FakeTime:
+    def __init__(self) -> None:
+        self.now = 0.0
+        self.slept: list[float] = []
+
+    def clock(self) -> float:
+        return self.now
+
+    def sleep(self, seconds: float) -> None:
+        self.slept.append(seconds)
+        self.now += seconds
+
+
+def test_token_bucket_paces_debt_and_slows_during_playback() -> None:
+    fake = _FakeTime()
+    mib = 1024 * 1024
+    bucket = IoTokenBucket(
+        4 * mib, burst_bytes=4 * mib, clock=fake.clock, sleep=fake.sleep
+    )
+    assert bucket.consume(4 * mib) == 0.0
+    assert bucket.consume(2 * mib) == 0.5
+    bucket.set_playback_active(True)
+    assert bucket.consume(1 * mib) == 1.0
+    bucket.set_playback_active(False)
+    fake.now += 10.0
+    assert bucket.consume(4 * mib) == 0.0
+    assert IoTokenBucket(0).consume(10 * mib) == 0.0
+
+
+def test_wave_decode_reads_in_budgeted_chunks(tmp_path: Path, monkeypatch) -> None:
+    track = tmp_path / "tone.wav"
+    with wave.open(str(track), "wb") as handle:
+        handle.setnchannels(2)
+        handle.setsampwidth(2)
+        handle.setframerate(44_100)
+        handle.writeframes(b"\x01\x00" * 2 * 44_100 * 7)
+
+    charged: list[int] = []
+
+    class _Recorder:
+        def consume(self, nbytes: int) -> float:
+            charged.append(nbytes)
+            return 0.0
+
+    monkeypatch.setattr(audio_decode, "analysis_io_budget", lambda: _Recorder())
+    decoded = audio_decode.decode_track_for_analysis(track)
+    assert decoded is not None
+    assert sum(charged) == 4 * 44_100 * 7
+    assert len(charged) == 2
+    assert max(charged) <= 1024 * 1024
@@ -0,0 +1,74 @@
+"""Tests for cross-process analysis leases."""
+
+from __future__ import annotations
+
+import asyncio
+import subprocess
+import sys
+from pathlib import Path
+
+from tz_player.services.analysis_lease import (
+    SqliteAnalysisLeaseStore,
+    analysis_lease_key,
+)
+
+
+def _run(coro):
+    return asyncio.run(coro)
+
+
+def test_lease_is_single_flight_until_released_or_expired(tmp_path: Path) -> None:
+    db_path = tmp_path / "analysis.sqlite"
+    now = [1000.0]
+    first = SqliteAnalysisLeaseStore(
+        db_path, ttl_s=30, owner="elsewhere:1:a", clock=lambda: now[0]
+    )
+    second = SqliteAnalysisLeaseStore(
+        db_path, ttl_s=30, owner="elsewhere:2:b", clock=lambda: now[0]
+    )
+
+    async def run() -> None:
+        await first.initialize()
+        assert await first.acquire("k")
+        assert await first.acquire("k")
+        assert not await second.acquire("k")
+        await second.release("k")
+        assert not await second.acquire("k")
+        await first.release("k")
+        assert await second.acquire("k")
+        now[0] += 31
+        assert await first.acquire("k")
+
+    _run(run())
+
+
+def test_lease_held_by_exited_local_process_is_taken_over(tmp_path: Path) -> None:
+    db_path = tmp_path / "analysis.sqlite"
+    proc = subprocess.run(
+        [sys.executable, "-c", "import os; print(os.getpid())"],
+        capture_output=True,
+        text=True,
+        check=True,
+    )
+    live = SqliteAnalysisLeaseStore(db_path)
+    host = live.owner.split(":")[0]
+    dead = SqliteAnalysisLeaseStore(db_path, owner=f"{host}:{proc.stdout.strip()}:x")
+
+    async def run() -> None:
+        await live.initialize()
+        assert await dead.acquire("k")
+        assert await live.acquire("k")
+
+    if sys.platform != "win32":
+        _run(run())
+
+
+def test_lease_key_prefers_content_key(tmp_path: Path, monkeypatch) -> None:
+    track = tmp_path / "a.mp3"
+    track.write_bytes(b"\x00" * 512)
+    copy = tmp_path / "b.mp3"
+    copy.write_bytes(b"\x00" * 512)
+    assert analysis_lease_key(track, "p") == analysis_lease_key(copy, "p")
+    assert analysis_lease_key(track, "p") != analysis_lease_key(track, "q")
+    monkeypatch.setenv("TZ_PLAYER_DISABLE_ANALYSIS_CONTENT_KEY", "1")
+    assert analysis_lease_key(track, "p") != analysis_lease_key(copy, "p")
@@ -0,0 +1,151 @@
+"""Tests for segment-by-segment lazy analysis in the app."""
+
+from __future__ import annotations
+
+import asyncio
+import logging
+import math
+import wave
+from pathlib import Path
+
+import pytest
+
+import tz_player.app as app_module
+from tz_player.services.audio_spectrum_native_cli import (
+    NATIVE_SPECTRUM_HELPER_CMD_ENV,
+    NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV,
+)
+from tz_player.services.beat_store import SqliteBeatStore
+from tz_player.services.native_dsp import NATIVE_DSP_DISABLE_ENV
+from tz_player.services.spectrum_store import SqliteSpectrumStore
+from tz_player.services.waveform_proxy_store import SqliteWaveformProxyStore
+
+
+def _run(coro):
+    return asyncio.run(coro)
+
+
+def _write_wave(path: Path, *, seconds: int, sample_rate: int = 22_050) -> None:
+    with wave.open(str(path), "wb") as handle:
+        handle.setnchannels(1)
+        handle.setsampwidth(2)
+        handle.setframerate(sample_rate)
+        handle.writeframes(
+            b"".join(
+                int(16000 * math.sin(2 * math.pi * 330 * idx / sample_rate)).to_bytes(
+                    2, "little", signed=True
+                )
+                for idx in range(seconds * sample_rate)
+            )
+        )
+
+
+def test_track_ending_on_segment_boundary_completes_analysis(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    monkeypatch.setenv(NATIVE_DSP_DISABLE_ENV, "1")
+    monkeypatch.delenv(NATIVE_SPECTRUM_HELPER_CMD_ENV, raising=False)
+    monkeypatch.setenv(NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV, "0")
+    monkeypatch.setattr(app_module, "analysis_segment_ms", lambda **_kwargs: 1_000)
+    track = tmp_path / "exact.wav"
+    _write_wave(track, seconds=2)
+    cache_db = tmp_path / "analysis.sqlite"
+
+    app = app_module.TzPlayerApp(auto_init=False)
+    app._schedule_analysis_cache_prune = lambda **kwargs: None  # type: ignore[assignment]
+    app.spectrum_store = SqliteSpectrumStore(cache_db)
+    app.beat_store = SqliteBeatStore(cache_db)
+    app.waveform_proxy_store = SqliteWaveformProxyStore(cache_db)
+
+    async def run() -> None:
+        await app.spectrum_store.initialize()
+        await app.beat_store.initialize()
+        await app.waveform_proxy_store.initialize()
+        await app._run_analysis_bundle_for_track(str(track))
+        assert await app._analysis_bundle_resume_points(track) is None
+        assert (
+            await app.spectrum_store.spectrum_resume_ms(
+                track, params=app._spectrum_params
+            )
+            is None
+        )
+        frames = await app.spectrum_store.list_frames(
+            track, params=app._spectrum_params
+        )
+        assert frames[-1].position_ms >= 1_900
+        assert (
+            await app.spectrum_store.spectrum_norm_peak(
+                track, params=app._spectrum_params
+            )
+            or 0.0
+        ) > 0.0
+
+    _run(run())
+    assert app.analysis_availability.is_ready(
+        track, SqliteSpectrumStore.ANALYSIS_TYPE, app._spectrum_params
+    )
+    assert app.analysis_availability.is_ready(
+        track, SqliteWaveformProxyStore.ANALYSIS_TYPE, app._waveform_proxy_params
+    )
+
+
+class _TakenOverLeases:
+    """Lease store whose renewal after the first segment is refused once."""
+
+    def __init__(self) -> None:
+        self.results = [True, False, True]
+        self.calls = 0
+        self.released: list[str] = []
+
+    async def acquire(self, lease_key: str) -> bool:
+        self.calls += 1
+        return self.results.pop(0) if self.results else True
+
+    async def release(self, lease_key: str) -> None:
+        self.released.append(lease_key)
+
+
+def test_lost_lease_hands_off_and_resumes_from_stored_segments(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch, caplog: pytest.LogCaptureFixture
+) -> None:
+    monkeypatch.setenv(NATIVE_DSP_DISABLE_ENV, "1")
+    monkeypatch.delenv(NATIVE_SPECTRUM_HELPER_CMD_ENV, raising=False)
+    monkeypatch.setenv(NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV, "0")
+    monkeypatch.setattr(app_module, "analysis_segment_ms", lambda **_kwargs: 1_000)
+    monkeypatch.setattr(app_module, "LEASE_POLL_S", 0.0)
+    track = tmp_path / "handoff.wav"
+    _write_wave(track, seconds=2)
+    cache_db = tmp_path / "analysis.sqlite"
+
+    app = app_module.TzPlayerApp(auto_init=False)
+    app._schedule_analysis_cache_prune = lambda **kwargs: None  # type: ignore[assignment]
+    app.spectrum_store = SqliteSpectrumStore(cache_db)
+    app.beat_store = SqliteBeatStore(cache_db)
+    app.waveform_proxy_store = SqliteWaveformProxyStore(cache_db)
+    leases = _TakenOverLeases()
+    app.analysis_leases = leases  # type: ignore[assignment]
+    starts: list[int] = []
+    analyze = app_module.analyze_track_analysis_bundle
+
+    def _recording_analyze(*args, **kwargs):
+        starts.append(kwargs["segment_start_ms"])
+        return analyze(*args, **kwargs)
+
+    monkeypatch.setattr(app_module, "analyze_track_analysis_bundle", _recording_analyze)
+
+    async def run() -> None:
+        await app.spectrum_store.initialize()
+        await app.beat_store.initialize()
+        await app.waveform_proxy_store.initialize()
+        await app._run_analysis_bundle_for_track(str(track))
+        assert await app._analysis_bundle_resume_points(track) is None
+
+    with caplog.at_level(logging.INFO, logger="tz_player.app"):
+        _run(run())
+    events = [getattr(record, "event", None) for record in caplog.records]
+    assert "analysis_lease_lost" in events
+    assert "analysis_lease_wait" in events
+    # The first segment is kept; analysis resumes after it once re-acquired.
+    assert starts[:2] == [0, 1_000]
+    assert leases.calls >= 3
+    assert len(leases.released) == 1
@@ -0,0 +1,87 @@
+"""Tests for lane-priority executor pools."""
+
+from __future__ import annotations
+
+import asyncio
+import threading
+
+import pytest
+
+from tz_player.utils.async_utils import (
+    PriorityExecutor,
+    _pool_sizes,
+    executor_lane,
+    executor_stats,
+    run_db,
+)
+
+
+def _blocker(started: threading.Event, release: threading.Event) -> None:
+    started.set()
+    release.wait(timeout=5.0)
+
+
+def test_interactive_jobs_run_before_queued_background_jobs() -> None:
+    executor = PriorityExecutor("test", 1)
+    started = threading.Event()
+    release = threading.Event()
+    order: list[str] = []
+    try:
+        executor.submit(_blocker, started, release)
+        assert started.wait(timeout=5.0)
+        with executor_lane("background"):
+            background = [executor.submit(order.append, f"bg{i}") for i in range(2)]
+        with executor_lane("prefetch"):
+            prefetch = executor.submit(order.append, "prefetch")
+        interactive = executor.submit(order.append, "interactive")
+        release.set()
+        for future in [*background, prefetch, interactive]:
+            future.result(timeout=5.0)
+    finally:
+        release.set()
+        executor.shutdown()
+
+    assert order == ["interactive", "prefetch", "bg0", "bg1"]
+    stats = executor.stats()
+    assert stats["background"].jobs == 2
+    assert stats["interactive"].jobs == 2
+    assert stats["background"].wait_max_ms >= 0.0
+
+
+def test_low_lanes_leave_a_worker_for_interactive_jobs() -> None:
+    executor = PriorityExecutor("test", 2)
+    release = threading.Event()
+    started = [threading.Event() for _ in range(3)]
+    try:
+        with executor_lane("background"):
+            first = executor.submit(_blocker, started[0], release)
+            second = executor.submit(_blocker, started[1], release)
+        assert started[0].wait(timeout=5.0)
+        interactive = executor.submit(_blocker, started[2], release)
+        # The second background job stays queued behind the low-lane cap, so
+        # the interactive job gets the reserved worker straight away.
+        assert started[2].wait(timeout=5.0)
+        assert not started[1].is_set()
+        release.set()
+        for future in (first, second, interactive):
+            future.result(timeout=5.0)
+    finally:
+        release.set()
+        executor.shutdown()
+
+
+def test_run_db_records_lane_stats_and_rejects_unknown_lanes() -> None:
+    async def run() -> int:
+        with executor_lane("playback"):
+            return await run_db(sum, [1, 2, 3])
+
+    before = executor_stats()["db"].get("playback")
+    assert asyncio.run(run()) == 6
+    after = executor_stats()["db"]["playback"]
+    assert after.jobs == (before.jobs if before else 0) + 1
+
+    with pytest.raises(ValueError), executor_lane("urgent"):  # type: ignore[arg-type]
+        pass
+
+    assert _pool_sizes(1) == (4, 2, 2)
+    assert _pool_sizes(32) == (8, 2, 4)
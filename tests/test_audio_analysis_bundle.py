@@ -6,6 +6,8 @@ import math
 import wave
 from pathlib import Path
 
+import pytest
+
 from tz_player.services.audio_analysis_bundle import analyze_track_analysis_bundle
 from tz_player.services.audio_beat_analysis import BeatAnalysisResult
 from tz_player.services.audio_spectrum_analysis import SpectrumAnalysisResult
@@ -17,6 +19,13 @@ from tz_player.services.audio_spectrum_native_cli import (
     NativeSpectrumHelperTimingBreakdown,
 )
 from tz_player.services.audio_waveform_proxy_analysis import WaveformProxyAnalysisResult
+from tz_player.services.native_dsp import NATIVE_DSP_DISABLE_ENV
+
+
+@pytest.fixture(autouse=True)
+def _python_dsp_kernels(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Pin the Python kernels; a built native DSP library changes backend labels."""
+    monkeypatch.setenv(NATIVE_DSP_DISABLE_ENV, "1")
 
 
 def _write_wave(path: Path, *, frames: int = 44_100, sample_rate: int = 44_100) -> None:
@@ -352,3 +361,97 @@ def test_analyze_track_analysis_bundle_records_native_fallback_reason(
     assert result.backend_info.analysis_backend == "python"
     assert result.backend_info.spectrum_backend == "python"
     assert result.backend_info.fallback_reason == "native_helper_timeout"
+
+
+def test_analyze_track_analysis_bundle_covers_long_tracks_in_segments(
+    tmp_path, monkeypatch
+) -> None:
+    monkeypatch.delenv(NATIVE_SPECTRUM_HELPER_CMD_ENV, raising=False)
+    monkeypatch.setenv(NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV, "0")
+    track = tmp_path / "tone.wav"
+    _write_wave(track, frames=44_100 * 5 // 2, sample_rate=44_100)
+
+    positions: list[int] = []
+    start_ms = 0
+    segments = 0
+    while True:
+        result = analyze_track_analysis_bundle(
+            track,
+            spectrum_band_count=8,
+            spectrum_hop_ms=40,
+            beat_hop_ms=40,
+            waveform_hop_ms=20,
+            max_spectrum_frames=25,
+            segment_start_ms=start_ms,
+            segment_ms=1_000,
+        )
+        assert result is not None and result.spectrum is not None
+        assert len(result.spectrum.frames) <= 25
+        assert all(pos >= start_ms for pos, _bands in result.spectrum.frames)
+        positions.extend(pos for pos, _bands in result.spectrum.frames)
+        segments += 1
+        if result.segment_end_ms is None:
+            break
+        start_ms = result.segment_end_ms
+
+    assert segments == 3
+    assert positions == sorted(positions)
+    assert positions[-1] >= 2_400
+
+
+def test_segments_reuse_first_segment_scale_across_seams(tmp_path, monkeypatch) -> None:
+    monkeypatch.delenv(NATIVE_SPECTRUM_HELPER_CMD_ENV, raising=False)
+    monkeypatch.setenv(NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV, "0")
+    track = tmp_path / "fade.wav"
+    sample_rate = 22_050
+    with wave.open(str(track), "wb") as handle:
+        handle.setnchannels(1)
+        handle.setsampwidth(2)
+        handle.setframerate(sample_rate)
+        handle.writeframes(
+            b"".join(
+                int(
+                    (24000 if idx < sample_rate else 3000)
+                    * math.sin(2.0 * math.pi * 330.0 * idx / sample_rate)
+                ).to_bytes(2, "little", signed=True)
+                for idx in range(2 * sample_rate)
+            )
+        )
+    kwargs = {
+        "spectrum_band_count": 8,
+        "spectrum_hop_ms": 40,
+        "beat_hop_ms": 40,
+        "waveform_hop_ms": 20,
+        "include_waveform_proxy": False,
+    }
+    first = analyze_track_analysis_bundle(
+        track, segment_start_ms=0, segment_ms=1_000, **kwargs
+    )
+    assert first is not None and first.spectrum is not None and first.beat is not None
+    assert first.spectrum.peak > 0.0 and first.beat.peak > 0.0
+    second = analyze_track_analysis_bundle(
+        track,
+        segment_start_ms=1_000,
+        segment_ms=1_000,
+        spectrum_peak=first.spectrum.peak,
+        beat_peak=first.beat.peak,
+        **kwargs,
+    )
+    whole = analyze_track_analysis_bundle(
+        track, spectrum_peak=first.spectrum.peak, **kwargs
+    )
+    assert second is not None and second.spectrum is not None
+    assert whole is not None and whole.spectrum is not None
+    assert second.spectrum.peak == first.spectrum.peak
+
+    # Away from the seam and the track end, both segments match one pass on the
+    # shared scale, so the quiet half stays quiet instead of renormalizing.
+    expected = dict(whole.spectrum.frames)
+    compared = 0
+    for pos, bands in [*first.spectrum.frames, *second.spectrum.frames]:
+        if pos <= 800 or 1_200 <= pos <= 1_800:
+            assert max(abs(a - b) for a, b in zip(bands, expected[pos])) <= 2
+            compared += 1
+    assert compared >= 30
+    quiet = [max(bands) for pos, bands in second.spectrum.frames if pos <= 1_800]
+    assert max(quiet) < 160
@@ -6,7 +6,10 @@ import math
 import wave
 from pathlib import Path
 
-from tz_player.services.audio_spectrum_analysis import analyze_track_spectrum
+from tz_player.services.audio_spectrum_analysis import (
+    analyze_spectrum_from_mono,
+    analyze_track_spectrum,
+)
 
 
 def _write_wave(path: Path, *, frames: int = 2_205, sample_rate: int = 44_100) -> None:
@@ -35,3 +38,17 @@ def test_analyze_track_spectrum_returns_quantized_frames_for_wave(tmp_path) -> N
 def test_analyze_track_spectrum_returns_none_for_missing_file(tmp_path) -> None:
     missing = tmp_path / "missing.wav"
     assert analyze_track_spectrum(missing) is None
+
+
+def test_low_bands_resolve_neighbouring_tones_after_octave_decimation() -> None:
+    sample_rate = 11_025
+    samples = [
+        0.5 * math.sin((2.0 * math.pi * 42.0 * idx) / sample_rate)
+        for idx in range(sample_rate * 2)
+    ]
+    result = analyze_spectrum_from_mono(sample_rate, samples, band_count=48, hop_ms=40)
+    assert result is not None
+    bands = result.frames[len(result.frames) // 2][1]
+    assert max(bands[:2]) == 255
+    # ~60 Hz sits four bands up; the full-rate window used to smear into it.
+    assert bands[4] < 64
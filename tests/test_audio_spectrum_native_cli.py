@@ -8,6 +8,7 @@ import subprocess
 from pathlib import Path
 
 from tz_player.services.audio_spectrum_native_cli import (
+    NATIVE_HELPER_PERF_COUNTERS_ENV,
     NATIVE_SPECTRUM_HELPER_CMD_ENV,
     NATIVE_SPECTRUM_HELPER_TIMEOUT_ENV,
     NATIVE_SPECTRUM_HELPER_USE_BUNDLED_ENV,
@@ -197,6 +198,61 @@ def test_analyze_track_spectrum_via_native_cli_parses_response(monkeypatch) -> N
     assert result.helper_version == "dev-cli"
 
 
+def test_native_cli_requests_and_parses_perf_counters(monkeypatch) -> None:
+    captured: dict[str, object] = {}
+
+    def fake_run(cmd, **kwargs):  # noqa: ANN001
+        captured["input"] = kwargs.get("input")
+        payload = {
+            "schema": "tz_player.native_spectrum_helper_response.v1",
+            "duration_ms": 1000,
+            "frames": [[0, [1, 2, 3, 4]]],
+            "timings": {
+                "total_ms": 5.6,
+                "counters": {
+                    "available": True,
+                    "stages": {
+                        "spectrum": {
+                            "ms": 3.4,
+                            "cycles": 1000,
+                            "instructions": 2500,
+                            "ipc": 2.5,
+                            "l1d_misses": 12,
+                            "llc_misses": None,
+                            "branch_misses": 3,
+                        }
+                    },
+                },
+            },
+        }
+        return subprocess.CompletedProcess(
+            args=cmd,
+            returncode=0,
+            stdout=json.dumps(payload).encode("utf-8"),
+            stderr=b"",
+        )
+
+    monkeypatch.setattr(subprocess, "run", fake_run)
+    result = analyze_track_spectrum_via_native_cli(
+        Path("/tmp/test.wav"),
+        band_count=4,
+        hop_ms=40,
+        max_frames=100,
+        env={
+            NATIVE_SPECTRUM_HELPER_CMD_ENV: "native-helper",
+            NATIVE_HELPER_PERF_COUNTERS_ENV: "1",
+        },
+    )
+
+    request = json.loads((captured["input"] or b"").decode("utf-8"))
+    assert request["perf_counters"] == 1
+    assert result is not None and result.timings is not None
+    counters = result.timings.counters
+    assert counters is not None and counters.available
+    assert counters.stages["spectrum"]["ipc"] == 2.5
+    assert counters.stages["spectrum"]["llc_misses"] is None
+
+
 def test_analyze_track_spectrum_via_native_cli_falls_back_on_bad_payload(
     monkeypatch,
 ) -> None:
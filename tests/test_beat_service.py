@@ -115,3 +115,36 @@ def test_beat_service_returns_loading_and_schedules_on_cache_miss() -> None:
         assert scheduled == [("/tmp/song.mp3", params)]
 
     _run(run())
+
+
+def test_beat_service_publishes_upcoming_onset_schedule_from_preload() -> None:
+    class _ListProvider(_CacheMissProvider):
+        async def list_frames(
+            self, track_path: str, *, params: BeatParams
+        ) -> list[BeatFrame]:
+            del track_path, params
+            return [
+                BeatFrame(
+                    position_ms=ms, strength_u8=200, is_beat=ms % 500 == 0, bpm=120.0
+                )
+                for ms in range(0, 5000, 50)
+            ]
+
+    async def run() -> None:
+        service = BeatService(cache_provider=_ListProvider())
+        params = BeatParams(hop_ms=50)
+        assert await service.preload_track("/tmp/song.mp3", params=params) == 100
+        reading = await service.sample(
+            track_path="/tmp/song.mp3", position_ms=1100, params=params
+        )
+        assert reading.upcoming_onsets_ms[:3] == (1000, 1500, 2000)
+        assert len(reading.upcoming_onsets_ms) == 8
+        assert service.upcoming_onsets(
+            "/tmp/song.mp3", params=params, position_ms=4700
+        ) == (4500,)
+        service.clear_track_cache("/tmp/song.mp3")
+        assert (
+            service.upcoming_onsets("/tmp/song.mp3", params=params, position_ms=0) == ()
+        )
+
+    _run(run())
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+import os
+import sqlite3
 import types
 
 import tz_player.doctor as doctor_module
@@ -126,3 +128,131 @@ def _check(name: str, status: str, required: bool) -> doctor_module.DoctorCheck:
         required=required,
         detail="detail",
     )
+
+
+def test_recommend_perf_settings_scales_with_probe_results() -> None:
+    fast = doctor_module.recommend_perf_settings(
+        analysis_ms_per_audio_s=4.0,
+        db_read_p95_ms=0.5,
+        db_write_p95_ms=2.0,
+        visualizer_p95_ms=5.0,
+        cpu_count=8,
+    )
+    assert (fast.profile, fast.visualizer_fps, fast.analysis_concurrency) == (
+        "aggressive",
+        22,
+        4,
+    )
+
+    slow_render = doctor_module.recommend_perf_settings(
+        analysis_ms_per_audio_s=120.0,
+        db_read_p95_ms=0.5,
+        db_write_p95_ms=2.0,
+        visualizer_p95_ms=45.0,
+        cpu_count=8,
+    )
+    assert slow_render.profile == "safe"
+    assert slow_render.visualizer_fps == 10
+    assert slow_render.analysis_concurrency == 1
+
+    failed = doctor_module.recommend_perf_settings(
+        analysis_ms_per_audio_s=None,
+        db_read_p95_ms=None,
+        db_write_p95_ms=None,
+        visualizer_p95_ms=None,
+        cpu_count=None,
+    )
+    assert failed.profile == "safe"
+    assert failed.reasons
+
+
+def test_perf_probes_measure_library_db_and_visualizers(tmp_path, monkeypatch) -> None:
+    from tz_player.db.schema import create_schema
+
+    db_file = tmp_path / "tz-player.sqlite"
+    with sqlite3.connect(db_file) as conn:
+        create_schema(conn)
+    sqlite_probe = doctor_module.probe_sqlite_perf(db_file, iterations=3)
+    assert sqlite_probe.status == "ok"
+    assert "library" in sqlite_probe.detail
+    assert sqlite_probe.values["commit_p95_ms"] >= 0.0
+    assert sorted(path.name for path in tmp_path.iterdir()) == ["tz-player.sqlite"]
+
+    visualizer_probe = doctor_module.probe_visualizer_perf(frames=1)
+    assert visualizer_probe.status == "ok"
+    assert visualizer_probe.values["render_p95_ms"] > 0.0
+
+    monkeypatch.delenv("TZ_PLAYER_NATIVE_SPECTRUM_HELPER_CMD", raising=False)
+    monkeypatch.setenv("TZ_PLAYER_USE_BUNDLED_NATIVE_SPECTRUM_HELPER", "0")
+    analysis_probe = doctor_module.probe_analysis_perf(tmp_path, track_seconds=0.5)
+    assert analysis_probe.status == "ok"
+    assert analysis_probe.values["analysis_ms_per_audio_s"] > 0.0
+
+
+def test_run_doctor_perf_is_advisory(monkeypatch) -> None:
+    monkeypatch.setattr(
+        doctor_module, "probe_tinytag", lambda: _check("tinytag", "ok", True)
+    )
+    monkeypatch.setattr(
+        doctor_module,
+        "probe_vlc",
+        lambda **kwargs: _check("vlc/libvlc", "ok", kwargs["required"]),
+    )
+    monkeypatch.setattr(
+        doctor_module,
+        "probe_ffmpeg",
+        lambda **kwargs: _check("ffmpeg", "ok", kwargs["required"]),
+    )
+    perf = doctor_module.PerfSelfCheck(
+        probes=[doctor_module.PerfProbe("sqlite", "error", "disk I/O error")],
+        recommendation=doctor_module.PerfRecommendation("safe", 10, 1, ["note"]),
+    )
+    monkeypatch.setattr(doctor_module, "run_perf_self_check", lambda: perf)
+
+    report = doctor_module.run_doctor("vlc", perf=True)
+    text = doctor_module.render_report(report)
+    assert report.exit_code == 0
+    assert "Performance self-check" in text
+    assert "--visualizer-responsiveness safe --visualizer-fps 10" in text
+
+
+def test_perf_self_check_uses_saved_helper_settings(tmp_path, monkeypatch) -> None:
+    state_file = tmp_path / "state.json"
+    state_file.write_text(
+        '{"native_helper_enabled": false, "native_helper_timeout_s": 5.0}',
+        encoding="utf-8",
+    )
+    seen: dict[str, object] = {}
+
+    def fake_probe(work_dir, **kwargs):
+        seen.update(kwargs)
+        return doctor_module.PerfProbe("analysis", "ok", "skipped")
+
+    monkeypatch.setattr(doctor_module, "probe_analysis_perf", fake_probe)
+    monkeypatch.setattr(
+        doctor_module,
+        "probe_sqlite_perf",
+        lambda db_file: doctor_module.PerfProbe("sqlite", "ok", "skipped"),
+    )
+    monkeypatch.setattr(
+        doctor_module,
+        "probe_visualizer_perf",
+        lambda: doctor_module.PerfProbe("visualizer", "ok", "skipped"),
+    )
+    doctor_module.run_perf_self_check(
+        db_file=tmp_path / "tz-player.sqlite", state_file=state_file, cpu_count=2
+    )
+    assert seen["helper_enabled"] is False
+    assert seen["helper_timeout_s"] == 5.0
+
+
+def test_perf_analysis_restores_helper_env(tmp_path, monkeypatch) -> None:
+    monkeypatch.delenv("TZ_PLAYER_NATIVE_SPECTRUM_HELPER_CMD", raising=False)
+    monkeypatch.delenv("TZ_PLAYER_USE_BUNDLED_NATIVE_SPECTRUM_HELPER", raising=False)
+    monkeypatch.delenv("TZ_PLAYER_NATIVE_SPECTRUM_HELPER_TIMEOUT_S", raising=False)
+    probe = doctor_module.probe_analysis_perf(
+        tmp_path, track_seconds=0.5, helper_enabled=False, helper_timeout_s=5.0
+    )
+    assert probe.status == "ok"
+    assert "TZ_PLAYER_USE_BUNDLED_NATIVE_SPECTRUM_HELPER" not in os.environ
+    assert "TZ_PLAYER_NATIVE_SPECTRUM_HELPER_TIMEOUT_S" not in os.environ
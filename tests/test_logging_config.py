@@ -319,7 +319,9 @@ def test_app_main_doctor_path_returns_report_exit_code(
     monkeypatch.setattr(app_module, "build_parser", lambda: FakeParser())
     monkeypatch.setattr(app_module, "setup_logging", lambda **kwargs: None)
     monkeypatch.setattr(app_module, "log_dir", lambda: tmp_path / "logs")
-    monkeypatch.setattr(app_module, "run_doctor", lambda _backend: FakeReport())
+    monkeypatch.setattr(
+        app_module, "run_doctor", lambda _backend, **_kwargs: FakeReport()
+    )
     monkeypatch.setattr(app_module, "render_report", lambda _report: "doctor output")
     monkeypatch.setattr(app_module, "TzPlayerApp", ForbiddenApp)
 
@@ -17,9 +17,9 @@ def _run(coro):
 
 def test_mark_metadata_done() -> None:
     pane = PlaylistPane()
-    pane._metadata_pending.update({1, 2, 3})
+    pane._metadata_requested = [1, 2, 3]
     pane.mark_metadata_done([2, 4])
-    assert pane._metadata_pending == {1, 3}
+    assert pane._metadata_requested == [1, 3]
 
 
 def test_metadata_debounce_reschedules(tmp_path, monkeypatch) -> None:
@@ -10,6 +10,7 @@ import pytest
 
 from tz_player.services.metadata_service import MetadataService
 from tz_player.services.playlist_store import PlaylistStore
+from tz_player.utils.async_utils import current_lane
 
 
 def _run(coro):
@@ -112,3 +113,102 @@ def test_metadata_service_rejects_non_positive_concurrency(tmp_path) -> None:
 
     with pytest.raises(ValueError, match="concurrency"):
         MetadataService(store, concurrency=0)
+
+
+def test_hydrate_reprioritizes_and_drops_rows_scrolled_away(tmp_path) -> None:
+    async def run() -> tuple[list[int], list[int]]:
+        store = PlaylistStore(tmp_path / "library.sqlite")
+        await store.initialize()
+        playlist_id = await store.create_playlist("Default")
+        paths = [tmp_path / f"{name}.wav" for name in ("a", "b", "c", "d")]
+        for path in paths:
+            _write_wave(path, duration_sec=0.05)
+        await store.add_tracks(playlist_id, paths)
+        rows = await store.fetch_window(playlist_id, 0, 4)
+        ids = [row.track_id for row in rows]
+
+        updated: list[int] = []
+
+        async def on_updated(track_ids: list[int]) -> None:
+            updated.extend(track_ids)
+
+        service = MetadataService(store, concurrency=1, on_metadata_updated=on_updated)
+        release = asyncio.Event()
+        started: list[int] = []
+        load_one = service._load_one
+
+        async def gated_load_one(track):  # type: ignore[no-untyped-def]
+            started.append(track.track_id)
+            await release.wait()
+            return await load_one(track)
+
+        service._load_one = gated_load_one  # type: ignore[method-assign]
+        service.hydrate(ids[:2])
+        while not started:
+            await asyncio.sleep(0.01)
+        # Viewport moved on: the queued second row is dropped, new rows jump in.
+        service.hydrate([ids[3], ids[2], ids[0]])
+        assert service.pending_hydration == [ids[3], ids[2]]
+        release.set()
+        while len(updated) < 3:
+            await asyncio.sleep(0.01)
+        return started, updated
+
+    started, updated = _run(asyncio.wait_for(run(), timeout=10))
+    assert len(started) == 3
+    assert updated == started
+    assert started[1:] == sorted(started[1:], reverse=True)
+
+
+def test_hydrate_reports_every_finished_id(tmp_path) -> None:
+    async def run() -> tuple[list[int], list[int]]:
+        store = PlaylistStore(tmp_path / "library.sqlite")
+        await store.initialize()
+        playlist_id = await store.create_playlist("Default")
+        present = tmp_path / "present.wav"
+        missing = tmp_path / "missing.wav"
+        _write_wave(present, duration_sec=0.05)
+        _write_wave(missing, duration_sec=0.05)
+        await store.add_tracks(playlist_id, [present, missing])
+        missing.unlink()
+        ids = [row.track_id for row in await store.fetch_window(playlist_id, 0, 2)]
+
+        reported: list[int] = []
+
+        async def on_updated(track_ids: list[int]) -> None:
+            reported.extend(track_ids)
+
+        service = MetadataService(store, concurrency=1, on_metadata_updated=on_updated)
+        service.hydrate(ids)
+        while len(reported) < 2:
+            await asyncio.sleep(0.01)
+        # Already-fresh metadata still reports so requesters can stop waiting.
+        service.hydrate([ids[0]])
+        while len(reported) < 3:
+            await asyncio.sleep(0.01)
+        return ids, reported
+
+    ids, reported = _run(asyncio.wait_for(run(), timeout=10))
+    assert sorted(reported[:2]) == sorted(ids)
+    assert reported[2] == ids[0]
+
+
+def test_hydrate_reads_visible_rows_on_interactive_lane(tmp_path) -> None:
+    async def run() -> dict[int, str]:
+        store = PlaylistStore(tmp_path / "library.sqlite")
+        await store.initialize()
+        service = MetadataService(store, concurrency=1)
+        lanes: dict[int, str] = {}
+
+        async def record_lane(track_id: int) -> None:
+            lanes[track_id] = current_lane()
+
+        service._hydrate_one = record_lane  # type: ignore[method-assign]
+        service.hydrate([1, 2], prefetch_ids=[2, 3])
+        assert service.pending_hydration == [1, 2, 3]
+        while len(lanes) < 3:
+            await asyncio.sleep(0.01)
+        return lanes
+
+    lanes = _run(asyncio.wait_for(run(), timeout=5))
+    assert lanes == {1: "interactive", 2: "interactive", 3: "prefetch"}
@@ -0,0 +1,207 @@
+"""Tests for the in-process native DSP library and its Python fallbacks."""
+
+from __future__ import annotations
+
+import math
+import os
+import shutil
+import struct
+import subprocess
+import wave
+from pathlib import Path
+
+import pytest
+
+from tz_player.services.audio_analysis_bundle import analyze_track_analysis_bundle
+from tz_player.services.audio_beat_analysis import analyze_beats_from_mono
+from tz_player.services.audio_decode import decode_track_for_analysis
+from tz_player.services.audio_envelope_analysis import analyze_track_envelope
+from tz_player.services.audio_spectrum_analysis import analyze_spectrum_from_mono
+from tz_player.services.audio_waveform_proxy_analysis import (
+    analyze_waveform_proxy_from_decoded,
+)
+from tz_player.services.native_dsp import (
+    NATIVE_DSP_DISABLE_ENV,
+    NATIVE_DSP_LIB_ENV,
+    EnvelopeAccumulator,
+    beats_from_mono,
+    native_dsp_available,
+    spectrum_from_mono,
+)
+
+
+@pytest.fixture(scope="module")
+def native_lib(tmp_path_factory: pytest.TempPathFactory) -> Path:
+    if os.name == "nt" or shutil.which("gcc") is None:
+        pytest.skip("gcc not available")
+    out_dir = tmp_path_factory.mktemp("native_dsp")
+    repo_root = Path(__file__).resolve().parents[1]
+    subprocess.run(
+        [
+            "bash",
+            "tools/build_native_spectrum_helper.sh",
+            str(out_dir / "tz_player_native_helper"),
+        ],
+        cwd=repo_root,
+        check=True,
+        capture_output=True,
+    )
+    return out_dir / "libtz_player_native.so"
+
+
+def _write_wave(path: Path, *, seconds: float = 1.0, sample_rate: int = 22050) -> None:
+    frames = int(seconds * sample_rate)
+    with wave.open(str(path), "wb") as handle:
+        handle.setnchannels(2)
+        handle.setsampwidth(2)
+        handle.setframerate(sample_rate)
+        payload = bytearray()
+        for idx in range(frames):
+            left = int(12000 * math.sin(2 * math.pi * 440 * idx / sample_rate))
+            right = int(6000 * math.sin(2 * math.pi * 97 * idx / sample_rate))
+            payload.extend(struct.pack("<hh", left, right))
+        handle.writeframes(bytes(payload))
+
+
+def test_disabled_library_returns_none_and_keeps_python_paths(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    monkeypatch.setenv(NATIVE_DSP_DISABLE_ENV, "1")
+    assert native_dsp_available() is False
+    assert native_dsp_available({NATIVE_DSP_LIB_ENV: str(tmp_path / "x.so")}) is False
+    assert (
+        spectrum_from_mono(11025, [0.1] * 4000, band_count=8, hop_ms=40, max_frames=10)
+        is None
+    )
+    assert EnvelopeAccumulator(channels=2, bucket_frames=4).feed(b"\x00" * 16) is None
+    track = tmp_path / "tone.wav"
+    _write_wave(track, seconds=0.5)
+    bundle = analyze_track_analysis_bundle(
+        track,
+        spectrum_band_count=8,
+        spectrum_hop_ms=40,
+        beat_hop_ms=40,
+        waveform_hop_ms=20,
+    )
+    assert bundle is not None and bundle.backend_info is not None
+    assert bundle.backend_info.spectrum_backend == "python"
+
+
+def test_native_envelope_matches_python_bit_for_bit(
+    native_lib: Path, tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    track = tmp_path / "tone.wav"
+    _write_wave(track, seconds=1.3)
+    monkeypatch.setenv(NATIVE_DSP_DISABLE_ENV, "1")
+    expected = analyze_track_envelope(track, bucket_ms=50)
+    monkeypatch.delenv(NATIVE_DSP_DISABLE_ENV)
+    monkeypatch.setenv(NATIVE_DSP_LIB_ENV, str(native_lib))
+    assert native_dsp_available()
+    assert analyze_track_envelope(track, bucket_ms=50) == expected
+
+    pcm = struct.pack("<" + "h" * 14, *range(-7000, 7000, 1000))
+    accumulator = EnvelopeAccumulator(channels=2, bucket_frames=3)
+    levels = accumulator.feed(pcm[:8])
+    assert levels is not None and len(levels) == 0
+    levels = accumulator.feed(pcm[8:])
+    assert levels is not None and len(levels) == 2
+    assert accumulator.flush() is not None
+    assert accumulator.flush() is None
+
+
+def test_native_kernels_analyze_decoded_pcm_in_process(
+    native_lib: Path, tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    track = tmp_path / "tone.wav"
+    _write_wave(track, seconds=2.0)
+    monkeypatch.setenv(NATIVE_DSP_LIB_ENV, str(native_lib))
+    bundle = analyze_track_analysis_bundle(
+        track,
+        spectrum_band_count=16,
+        spectrum_hop_ms=40,
+        beat_hop_ms=40,
+        waveform_hop_ms=20,
+    )
+    assert bundle is not None and bundle.backend_info is not None
+    assert bundle.backend_info.spectrum_backend == "native_lib"
+    assert bundle.backend_info.beat_backend == "native_lib"
+    assert bundle.backend_info.waveform_proxy_backend == "native_lib"
+    assert bundle.spectrum is not None
+    assert all(len(bands) == 16 for _pos, bands in bundle.spectrum.frames)
+    assert bundle.beat is not None and bundle.beat.frames
+    reference = decode_track_for_analysis(track)
+    assert reference is not None
+    python_waveform = analyze_waveform_proxy_from_decoded(
+        reference, hop_ms=20, max_frames=30_000
+    )
+    assert bundle.waveform_proxy is not None and python_waveform is not None
+    assert len(bundle.waveform_proxy.frames) == len(python_waveform.frames)
+
+
+def test_native_spectrum_tracks_python_octave_filter_bank(
+    native_lib: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    sample_rate = 11_025
+    samples = [
+        0.5 * math.sin(2 * math.pi * 42 * idx / sample_rate)
+        + 0.3 * math.sin(2 * math.pi * 1500 * idx / sample_rate)
+        for idx in range(sample_rate * 2)
+    ]
+    expected = analyze_spectrum_from_mono(
+        sample_rate, samples, band_count=48, hop_ms=40, max_frames=100
+    )
+    monkeypatch.setenv(NATIVE_DSP_LIB_ENV, str(native_lib))
+    native = spectrum_from_mono(
+        sample_rate, samples, band_count=48, hop_ms=40, max_frames=100
+    )
+    assert expected is not None and native is not None
+    assert [pos for pos, _ in native.frames] == [pos for pos, _ in expected.frames]
+    for (_pos, native_bands), (_pos2, python_bands) in zip(
+        native.frames, expected.frames
+    ):
+        assert max(abs(a - b) for a, b in zip(native_bands, python_bands)) <= 2
+
+
+def test_native_kernels_honor_carried_reference_peak(
+    native_lib: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    sample_rate = 11_025
+    samples = [
+        0.4 * math.sin(2 * math.pi * 220 * idx / sample_rate) * (1 + (idx // 2205) % 3)
+        for idx in range(sample_rate * 2)
+    ]
+    expected = analyze_spectrum_from_mono(
+        sample_rate, samples, band_count=16, hop_ms=40, max_frames=100
+    )
+    expected_beat = analyze_beats_from_mono(
+        sample_rate, samples, hop_ms=40, max_frames=100
+    )
+    assert expected is not None and expected_beat is not None
+    monkeypatch.setenv(NATIVE_DSP_LIB_ENV, str(native_lib))
+    native = spectrum_from_mono(
+        sample_rate, samples, band_count=16, hop_ms=40, max_frames=100
+    )
+    native_beat = beats_from_mono(sample_rate, samples, hop_ms=40, max_frames=100)
+    assert native is not None and native_beat is not None
+    assert native.peak == pytest.approx(expected.peak, rel=1e-3)
+    assert native_beat.peak == pytest.approx(expected_beat.peak, rel=1e-6)
+
+    louder = spectrum_from_mono(
+        sample_rate,
+        samples,
+        band_count=16,
+        hop_ms=40,
+        max_frames=100,
+        reference_peak=native.peak * 2,
+    )
+    louder_beat = beats_from_mono(
+        sample_rate,
+        samples,
+        hop_ms=40,
+        max_frames=100,
+        reference_peak=native_beat.peak * 2,
+    )
+    assert louder is not None and louder_beat is not None
+    assert louder.peak == pytest.approx(native.peak * 2)
+    assert max(max(bands) for _pos, bands in louder.frames) < 200
+    assert max(strength for _pos, strength, _beat in louder_beat.frames) <= 128
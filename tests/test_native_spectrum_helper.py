@@ -136,6 +136,41 @@ def test_native_spectrum_helper_accepts_nested_request_objects(tmp_path) -> None
     assert payload["waveform_proxy"]["frames"][1][0] in {24, 25}
 
 
+def test_native_spectrum_helper_reports_perf_counters_when_requested(
+    tmp_path,
+) -> None:
+    repo_root = Path(__file__).resolve().parents[1]
+    bin_path = _build_helper_or_skip(repo_root, tmp_path)
+    track = tmp_path / "tone.wav"
+    _write_wave(track)
+    request = {
+        "schema": "tz_player.native_spectrum_helper_request.v1",
+        "track_path": str(track),
+        "beat": {"hop_ms": 40, "max_frames": 100},
+        "perf_counters": 1,
+    }
+    proc = subprocess.run(
+        [str(bin_path)],
+        input=json.dumps(request).encode("utf-8"),
+        capture_output=True,
+        check=False,
+    )
+    assert proc.returncode == 0, proc.stderr.decode("utf-8", errors="ignore")
+    counters = json.loads(proc.stdout.decode("utf-8"))["timings"]["counters"]
+    # Hosts without PMU access (VMs, strict perf_event_paranoid) degrade to
+    # an empty report rather than failing the analysis.
+    if not counters["available"]:
+        assert counters["stages"] == {}
+        return
+    assert {"decode", "resample", "spectrum", "beat", "serialize"} <= set(
+        counters["stages"]
+    )
+    assert "waveform_proxy" not in counters["stages"]
+    spectrum = counters["stages"]["spectrum"]
+    assert spectrum["ms"] >= 0
+    assert {"cycles", "instructions", "ipc", "llc_misses"} <= set(spectrum)
+
+
 @pytest.mark.skipif(shutil.which("ffmpeg") is None, reason="ffmpeg required")
 def test_native_spectrum_helper_supports_mp3_via_ffmpeg(tmp_path) -> None:
     repo_root = Path(__file__).resolve().parents[1]
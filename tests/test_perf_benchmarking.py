@@ -13,10 +13,16 @@ from tz_player.perf_benchmarking import (
     PerfRunResult,
     PerfScenarioResult,
     build_perf_media_manifest,
+    compare_perf_run_groups,
     compare_perf_run_payloads,
     load_perf_run_payload,
+    load_perf_run_payloads,
+    mann_whitney_min_p_value,
+    mann_whitney_u_p_value,
+    parse_metric_thresholds,
     perf_media_skip_reason,
     render_perf_comparison_text,
+    render_perf_significance_text,
     resolve_perf_media_dir,
     resolve_perf_results_dir,
     summarize_samples,
@@ -200,3 +206,82 @@ def test_compare_perf_run_payloads_detects_regression_and_renders_text(
     assert "Perf comparison" in text
     assert "Regressions:" in text
     assert "visualizer_matrix_render.render_ms" in text
+
+
+def _sample_payloads(prefix: str, medians: list[float]) -> list[dict[str, object]]:
+    return [
+        _sample_run(run_id=f"{prefix}-{idx}", median_ms=median).to_dict()
+        for idx, median in enumerate(medians)
+    ]
+
+
+def test_mann_whitney_exact_and_tied_p_values() -> None:
+    # Full separation of 4 vs 4 tie-free samples: 2 / C(8, 4).
+    assert mann_whitney_u_p_value([1, 2, 3, 4], [5, 6, 7, 8]) == pytest.approx(2 / 70)
+    assert mann_whitney_u_p_value([1, 2, 3], [1, 2, 3]) == pytest.approx(1.0)
+
+
+def test_compare_perf_run_groups_separates_regressions_from_noise() -> None:
+    baselines = _sample_payloads("base", [20.0, 20.4, 19.8, 20.1, 20.2])
+    regressed = compare_perf_run_groups(
+        baselines, _sample_payloads("cand", [24.0, 24.3, 23.9, 24.4, 24.1])
+    )
+    [metric] = regressed.metrics
+    assert metric.verdict == "regressed"
+    assert metric.p_value is not None and metric.p_value < 0.05
+    assert metric.ci_low_pct is not None and metric.ci_low_pct > 0
+    text = render_perf_significance_text(regressed)
+    assert "regressed=1" in text
+    assert "visualizer_matrix_render.render_ms" in text
+
+    # Overlapping runs with a similar median stay within noise.
+    noisy = compare_perf_run_groups(
+        baselines, _sample_payloads("cand", [20.3, 19.9, 20.6, 20.0, 21.5])
+    )
+    assert noisy.metrics[0].verdict == "within_noise"
+    assert not noisy.regressed_metrics
+
+    # A per-metric threshold above the observed change suppresses the verdict.
+    relaxed = compare_perf_run_groups(
+        baselines,
+        _sample_payloads("cand", [24.0, 24.3, 23.9, 24.4, 24.1]),
+        metric_thresholds=parse_metric_thresholds(["visualizer_*.render_ms=30"]),
+    )
+    assert relaxed.metrics[0].verdict == "within_noise"
+    assert relaxed.metrics[0].regression_pct_threshold == 30.0
+
+    single = compare_perf_run_groups(baselines[:1], _sample_payloads("cand", [40.0]))
+    assert single.metrics[0].verdict == "insufficient_data"
+
+    # Three runs per side cannot reach p <= 0.05, even for a large regression.
+    assert mann_whitney_min_p_value(3, 3) == pytest.approx(0.1)
+    few = compare_perf_run_groups(
+        baselines[:3], _sample_payloads("cand", [40.0, 41.0, 42.0])
+    )
+    assert few.metrics[0].verdict == "insufficient_data"
+    assert not few.regressed_metrics
+    assert "--repeat 4" in render_perf_significance_text(few)
+    with pytest.raises(ValueError):
+        parse_metric_thresholds(["render_ms"])
+
+
+def test_load_perf_run_payloads_expands_suite_summaries(tmp_path: Path) -> None:
+    paths = [
+        write_perf_run_artifact(
+            _sample_run(run_id=f"run-{idx}", median_ms=20.0), results_dir=tmp_path
+        )
+        for idx in range(3)
+    ]
+    summary = tmp_path / "suite.json"
+    summary.write_text(
+        json.dumps(
+            {
+                "schema": "tz_player.perf_run_suite_summary.v1",
+                "artifacts": [str(path) for path in paths],
+            }
+        ),
+        encoding="utf-8",
+    )
+    assert len(load_perf_run_payloads(summary)) == 3
+    assert len(load_perf_run_payloads(tmp_path)) == 3
+    assert len(load_perf_run_payloads(paths[0])) == 1
@@ -1,9 +1,12 @@
 from __future__ import annotations
 
+import threading
+import time
 from pathlib import Path
 
 from tz_player.perf_profiling import (
     PERF_PROFILE_DIR_ENV,
+    StackSampler,
     render_pstats_summary_text,
     resolve_perf_profile_dir,
     run_cprofile_callable,
@@ -50,3 +53,35 @@ def test_run_cprofile_callable_writes_artifacts(tmp_path: Path) -> None:
     assert "work" in summary or "Profiling suppressed" in summary
     rendered = render_pstats_summary_text(artifact.prof_path, top_n=5)
     assert "work" in rendered or "Profiling suppressed" in summary
+
+
+def test_stack_sampler_writes_collapsed_stacks(tmp_path: Path) -> None:
+    stop = threading.Event()
+
+    def busy_sampled_work() -> None:
+        while not stop.is_set():
+            sum(idx * idx for idx in range(200))
+
+    worker = threading.Thread(target=busy_sampled_work, name="busy worker")
+    worker.start()
+    sampler = StackSampler(label="unit sample", hz=200, profile_dir=tmp_path)
+    sampler.start()
+    try:
+        time.sleep(0.2)
+    finally:
+        artifact = sampler.stop()
+        stop.set()
+        worker.join()
+
+    assert artifact.samples > 0
+    assert artifact.collapsed_path.name.endswith("_unit_sample.collapsed")
+    lines = artifact.collapsed_path.read_text(encoding="utf-8").splitlines()
+    assert lines
+    stack, count = lines[0].rsplit(" ", 1)
+    assert int(count) >= 1
+    assert stack.split(";")[0]
+    assert any(
+        line.startswith("busy_worker;") and "busy_sampled_work (" in line
+        for line in lines
+    )
+    assert not any("tz-player-stack-sampler" in line for line in lines)
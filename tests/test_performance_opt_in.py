@@ -51,6 +51,7 @@ from tz_player.services.audio_envelope_analysis import (
 )
 from tz_player.services.audio_envelope_store import SqliteEnvelopeStore
 from tz_player.services.audio_level_service import AudioLevelService
+from tz_player.services.audio_spectrum_native_cli import NativeHelperCounters
 from tz_player.services.beat_service import BeatService
 from tz_player.services.beat_store import BeatParams, SqliteBeatStore
 from tz_player.services.fake_backend import FakePlaybackBackend
@@ -168,6 +169,27 @@ def _cpu_spin(iterations: int) -> int:
     return total
 
 
+def _record_native_helper_counters(
+    counters: NativeHelperCounters | None,
+    per_track_meta: dict[str, object],
+    metrics_samples: dict[str, list[float]],
+) -> None:
+    """Attach helper hardware counters (when reported) to bench artifacts."""
+    if counters is None:
+        return
+    per_track_meta["native_helper_counters"] = {
+        "available": counters.available,
+        "stages": counters.stages,
+    }
+    for stage, values in counters.stages.items():
+        for name in ("ipc", "cycles", "llc_misses"):
+            value = values.get(name)
+            if value is not None:
+                metrics_samples.setdefault(f"native_helper_{stage}_{name}", []).append(
+                    value
+                )
+
+
 def _setup_dirs(tmp_path, monkeypatch) -> None:
     """Patch AppDirs to avoid touching real user data/config locations."""
     data_dir = tmp_path / "data"
@@ -1139,6 +1161,11 @@ def test_real_analysis_cache_cold_warm_benchmark_artifact(tmp_path) -> None:
                 cold_metrics_samples.setdefault(
                     "bundle_native_helper_total_ms", []
                 ).append(bundle.timings.native_helper_total_ms)
+                _record_native_helper_counters(
+                    bundle.timings.native_helper_counters,
+                    per_track_meta,
+                    cold_metrics_samples,
+                )
                 cold_metrics_samples.setdefault("bundle_spectrum_ms", []).append(
                     bundle.timings.spectrum_ms
                 )
@@ -1591,6 +1618,11 @@ def test_real_analysis_bundle_spectrum_waveform_cold_benchmark_artifact(
                 cold_metrics_samples.setdefault(
                     "bundle_native_helper_total_ms", []
                 ).append(bundle.timings.native_helper_total_ms)
+                _record_native_helper_counters(
+                    bundle.timings.native_helper_counters,
+                    per_track_meta,
+                    cold_metrics_samples,
+                )
                 cold_metrics_samples.setdefault("bundle_spectrum_ms", []).append(
                     bundle.timings.spectrum_ms
                 )
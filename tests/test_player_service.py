@@ -8,6 +8,7 @@ import random
 import time
 from dataclasses import replace
 
+from tz_player.events import PlayerStateChanged
 from tz_player.services.beat_service import BeatReading
 from tz_player.services.beat_store import BeatParams
 from tz_player.services.fake_backend import FakePlaybackBackend
@@ -779,6 +780,36 @@ def test_volume_speed_repeat_shuffle() -> None:
     _run(run())
 
 
+def test_state_events_carry_changed_fields() -> None:
+    events: list[PlayerStateChanged] = []
+
+    async def emit_event(event: object) -> None:
+        if isinstance(event, PlayerStateChanged):
+            events.append(event)
+
+    async def run() -> None:
+        service = PlayerService(
+            emit_event=emit_event,
+            track_info_provider=_track_info_provider,
+            backend=FakePlaybackBackend(tick_interval_ms=50),
+            initial_state=PlayerState(volume=50),
+        )
+        await service.start()
+        await service.set_volume(60)
+        await service.set_volume(60)
+        await service.cycle_repeat_mode()
+        await service.shutdown()
+
+    _run(run())
+    assert [event.changed for event in events] == [
+        None,
+        frozenset(),
+        frozenset({"repeat_mode"}),
+    ]
+    assert not events[1].touches(frozenset({"volume"}))
+    assert events[2].touches(frozenset({"repeat_mode", "shuffle"}))
+
+
 def test_backend_event_handling_is_safe() -> None:
     async def emit_event(_event: object) -> None:
         return None
@@ -875,6 +906,49 @@ def test_next_prev_navigation() -> None:
     _run(run())
 
 
+def test_play_preloads_predicted_next_track(monkeypatch) -> None:
+    import tz_player.services.player_service as player_service_module
+
+    monkeypatch.setattr(player_service_module, "MEDIA_PRELOAD_DELAY_S", 0.0)
+
+    async def emit_event(_event: object) -> None:
+        return None
+
+    async def track_info(_playlist_id: int, item_id: int) -> TrackInfo:
+        return TrackInfo(
+            title=f"Song {item_id}",
+            artist=None,
+            album=None,
+            year=None,
+            path=f"/tmp/{item_id}.mp3",
+            duration_ms=5000,
+        )
+
+    async def next_provider(_playlist_id: int, item_id: int, wrap: bool) -> int | None:
+        return item_id + 1 if item_id < 3 else (1 if wrap else None)
+
+    async def run() -> list[str | None]:
+        backend = FakePlaybackBackend(tick_interval_ms=50)
+        service = PlayerService(
+            emit_event=emit_event,
+            track_info_provider=track_info,
+            backend=backend,
+            next_track_provider=next_provider,
+        )
+        await service.start()
+        seen: list[str | None] = []
+        await service.play_item(1, 2)
+        await asyncio.sleep(0.05)
+        seen.append(backend.preloaded_path)
+        await service.cycle_repeat_mode()
+        await asyncio.sleep(0.05)
+        seen.append(backend.preloaded_path)
+        await service.shutdown()
+        return seen
+
+    assert _run(run()) == ["/tmp/3.mp3", "/tmp/2.mp3"]
+
+
 def test_predict_next_item_id_repeat_and_linear_provider() -> None:
     async def emit_event(_event: object) -> None:
         return None
@@ -0,0 +1,64 @@
+"""Tests for M3U/PLS playlist import and export."""
+
+from __future__ import annotations
+
+import asyncio
+from pathlib import Path
+
+from tz_player.services.playlist_files import (
+    export_playlist_file,
+    import_playlist_file,
+    iter_playlist_entries,
+)
+from tz_player.services.playlist_store import PlaylistStore
+
+
+def _run(coro):
+    """Run async playlist-file workflow from sync test."""
+    return asyncio.run(coro)
+
+
+def test_iter_playlist_entries_parses_m3u_and_pls(tmp_path: Path) -> None:
+    (tmp_path / "sub").mkdir()
+    m3u = tmp_path / "mix.m3u8"
+    m3u.write_text(
+        "\ufeff#EXTM3U\n"
+        "#EXTINF:123,Artist - Song\n"
+        "sub/one.mp3\n"
+        "\n"
+        "http://radio.example/stream.mp3\n"
+        f"file://{tmp_path}/two%20tracks.flac\n"
+        "notes.txt\n",
+        encoding="utf-8",
+    )
+    assert list(iter_playlist_entries(m3u)) == [
+        tmp_path / "sub" / "one.mp3",
+        tmp_path / "two tracks.flac",
+    ]
+
+    pls = tmp_path / "mix.pls"
+    pls.write_text(
+        "[playlist]\nFile1=/abs/a.ogg\nTitle1=A\nFile2=b.wav\nNumberOfEntries=2\n",
+        encoding="utf-8",
+    )
+    assert list(iter_playlist_entries(pls)) == [Path("/abs/a.ogg"), tmp_path / "b.wav"]
+
+
+def test_import_in_chunks_and_export_round_trip(tmp_path: Path) -> None:
+    store = PlaylistStore(tmp_path / "library.sqlite")
+    _run(store.initialize())
+    source_id = _run(store.create_playlist("Source"))
+    names = [f"track{index}.mp3" for index in range(7)]
+    source = tmp_path / "in.m3u"
+    source.write_text("\n".join(names) + "\n", encoding="utf-8")
+
+    added = _run(import_playlist_file(store, source_id, source, chunk_size=3))
+    assert added == 7
+
+    for suffix in (".m3u8", ".pls"):
+        exported = tmp_path / f"out{suffix}"
+        assert _run(export_playlist_file(store, source_id, exported)) == 7
+        target_id = _run(store.create_playlist(f"Target{suffix}"))
+        assert _run(import_playlist_file(store, target_id, exported)) == 7
+        rows = _run(store.fetch_window(target_id, 0, 10))
+        assert [row.path.name for row in rows] == names
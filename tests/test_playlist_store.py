@@ -35,14 +35,8 @@ def test_playlist_store_basic(tmp_path) -> None:
                 "SELECT name FROM sqlite_master WHERE type = 'table'"
             )
         }
-    assert {
-        "tracks",
-        "track_meta",
-        "playlists",
-        "playlist_items",
-        "audio_envelopes",
-        "audio_envelope_points",
-    }.issubset(tables)
+    assert {"tracks", "track_meta", "playlists", "playlist_items"}.issubset(tables)
+    assert "audio_envelopes" not in tables
 
     playlist_id = _run(store.create_playlist("Favorites"))
     track_paths = [tmp_path / f"track_{idx}.mp3" for idx in range(3)]
@@ -224,7 +218,7 @@ def test_migration_adds_item_id(tmp_path) -> None:
         columns = [row[1] for row in conn.execute("PRAGMA table_info(playlist_items)")]
         assert "id" in columns
         version = conn.execute("PRAGMA user_version").fetchone()[0]
-        assert version == 7
+        assert version == 8
 
 
 def test_initialize_fails_on_newer_schema_version(tmp_path) -> None:
@@ -395,3 +389,37 @@ def test_clear_playlist_uses_lock_retry_wrapper(tmp_path, monkeypatch) -> None:
 
     assert calls["count"] == 1
     assert _run(store.count(playlist_id)) == 0
+
+
+def test_bulk_remove_rebuilds_search_index(tmp_path, monkeypatch) -> None:
+    monkeypatch.setattr(playlist_store_module, "BULK_FTS_REBUILD_MIN_ROWS", 2)
+    drops: list[int] = []
+    drop = playlist_store_module.drop_playlist_search
+
+    def counting_drop(conn) -> None:  # type: ignore[no-untyped-def]
+        drops.append(1)
+        drop(conn)
+
+    monkeypatch.setattr(playlist_store_module, "drop_playlist_search", counting_drop)
+    db_path = tmp_path / "library.sqlite"
+    store = PlaylistStore(db_path)
+    _run(store.initialize())
+    playlist_id = _run(store.create_playlist("Bulk"))
+    other_id = _run(store.create_playlist("Other"))
+    paths = [tmp_path / f"{name}_song.mp3" for name in ("red", "green", "blue", "gold")]
+    for path in paths:
+        _touch(path)
+    _run(store.add_tracks(playlist_id, paths))
+    _run(store.add_tracks(other_id, [paths[0]]))
+    rows = _run(store.fetch_window(playlist_id, 0, 10))
+
+    removed = _run(store.remove_items(playlist_id, {row.item_id for row in rows[:3]}))
+    assert removed == 3
+    assert drops == [1]
+    assert _run(store.count(playlist_id)) == 1
+    assert _run(store.search_item_ids(playlist_id, "red")) == []
+    assert _run(store.search_item_ids(playlist_id, "gold")) == [rows[3].item_id]
+    assert len(_run(store.search_item_ids(other_id, "red"))) == 1
+    # Triggers are restored, so new rows stay searchable.
+    _run(store.add_tracks(playlist_id, [paths[1]]))
+    assert len(_run(store.search_item_ids(playlist_id, "green"))) == 1
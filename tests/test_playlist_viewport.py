@@ -3,6 +3,7 @@
 from __future__ import annotations
 
 import asyncio
+from dataclasses import replace
 from pathlib import Path
 
 from rich.text import Text
@@ -246,3 +247,59 @@ def test_viewport_mouse_move_with_lost_capture_is_ignored() -> None:
     asyncio.run(run())
     assert emitted == []
     assert event.stopped is False
+
+
+def test_viewport_reuses_cached_rows_across_scroll(tmp_path: Path, monkeypatch) -> None:
+    import tz_player.ui.playlist_viewport as viewport_module
+
+    rows = [
+        PlaylistRow(
+            item_id=item_id,
+            track_id=item_id,
+            pos_key=item_id,
+            path=tmp_path / f"{item_id}.mp3",
+            title=f"Track {item_id}",
+            artist="",
+            album=None,
+            year=None,
+            duration_ms=None,
+            meta_valid=True,
+            meta_error=None,
+        )
+        for item_id in range(1, 6)
+    ]
+    built: list[int] = []
+    render_row = viewport_module._render_row
+
+    def counting_render_row(row, marker, width):  # type: ignore[no-untyped-def]
+        built.append(row.item_id)
+        return render_row(row, marker, width)
+
+    monkeypatch.setattr(viewport_module, "_render_row", counting_render_row)
+    viewport = PlaylistViewport()
+    viewport._size = Size(30, 3)
+    viewport.update_model(
+        rows=rows[0:3],
+        total_count=5,
+        offset=0,
+        limit=3,
+        cursor_item_id=1,
+        selected_item_ids=set(),
+        playing_item_id=None,
+    )
+    viewport.render()
+    assert built == [1, 2, 3]
+
+    built.clear()
+    viewport.update_model(rows=rows[1:4], offset=1, cursor_item_id=2)
+    lines = viewport.render().plain.splitlines()
+    # Row 2 changed marker and row 4 scrolled in; row 3 is reused.
+    assert built == [2, 4]
+    assert lines[0].startswith("> Track 2")
+
+    built.clear()
+    renamed = replace(rows[2], title="Renamed")
+    viewport.update_model(rows=[rows[1], renamed, rows[3]])
+    lines = viewport.render().plain.splitlines()
+    assert built == [3]
+    assert lines[1].startswith("  Renamed")
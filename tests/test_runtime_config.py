@@ -10,6 +10,7 @@ from tz_player.runtime_config import (
     profile_default_beat_hop_ms,
     profile_default_player_poll_interval_s,
     profile_default_spectrum_hop_ms,
+    profile_default_spectrum_interpolation,
     profile_default_visualizer_fps,
     resolve_log_level,
 )
@@ -37,9 +38,11 @@ def test_visualizer_responsiveness_profile_normalization_and_defaults() -> None:
     assert profile_default_visualizer_fps("safe") == 10
     assert profile_default_visualizer_fps("balanced") == 14
     assert profile_default_visualizer_fps("aggressive") == 22
-    assert profile_default_spectrum_hop_ms("safe") == 40
+    assert profile_default_spectrum_hop_ms("safe") == 60
     assert profile_default_spectrum_hop_ms("balanced") == 32
     assert profile_default_spectrum_hop_ms("aggressive") == 24
+    assert profile_default_spectrum_interpolation("safe") == "envelope"
+    assert profile_default_spectrum_interpolation("balanced") == "linear"
     assert profile_default_beat_hop_ms("safe") == 40
     assert profile_default_beat_hop_ms("balanced") == 32
     assert profile_default_beat_hop_ms("aggressive") == 24
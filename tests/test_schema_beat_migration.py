@@ -33,7 +33,7 @@ def test_schema_migrates_v5_adds_analysis_beat_frames(tmp_path) -> None:
         create_schema(conn)
 
         version = conn.execute("PRAGMA user_version").fetchone()[0]
-        assert version == 7
+        assert version == 8
         table = conn.execute(
             """
             SELECT name
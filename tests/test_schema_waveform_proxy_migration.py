@@ -33,7 +33,7 @@ def test_schema_migrates_v6_adds_analysis_waveform_proxy_frames(tmp_path) -> Non
         create_schema(conn)
 
         version = conn.execute("PRAGMA user_version").fetchone()[0]
-        assert version == 7
+        assert version == 8
         table = conn.execute(
             """
             SELECT name
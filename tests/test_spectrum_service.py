@@ -113,3 +113,144 @@ def test_spectrum_service_returns_loading_and_schedules_on_cache_miss() -> None:
         assert scheduled == [("/tmp/song.mp3", params)]
 
     _run(run())
+
+
+class _ListProvider(_CacheMissProvider):
+    async def list_frames(
+        self, track_path: str, *, params: SpectrumParams
+    ) -> list[SpectrumFrame]:
+        del track_path, params
+        return [
+            SpectrumFrame(position_ms=0, bands=bytes([0, 200])),
+            SpectrumFrame(position_ms=100, bands=bytes([100, 0])),
+        ]
+
+
+def test_spectrum_service_linear_interpolation_blends_adjacent_hops() -> None:
+    async def run() -> None:
+        params = SpectrumParams(band_count=2, hop_ms=100)
+        nearest = SpectrumService(cache_provider=_ListProvider())
+        linear = SpectrumService(cache_provider=_ListProvider(), interpolation="linear")
+        for service in (nearest, linear):
+            assert await service.preload_track("/tmp/song.mp3", params=params) == 2
+        assert nearest.bands_at("/tmp/song.mp3", 40, params=params) == bytes([0, 200])
+        assert linear.bands_at("/tmp/song.mp3", 40, params=params) == bytes([40, 120])
+        assert linear.bands_at("/tmp/song.mp3", 100, params=params) == bytes([100, 0])
+        reading = await linear.sample(
+            track_path="/tmp/song.mp3", position_ms=50, params=params
+        )
+        assert reading.bands == bytes([50, 100])
+        assert linear.bands_at("/tmp/other.mp3", 50, params=params) is None
+
+    _run(run())
+
+
+def test_spectrum_service_envelope_attacks_fast_and_decays_slowly() -> None:
+    async def run() -> None:
+        params = SpectrumParams(band_count=2, hop_ms=100)
+        service = SpectrumService(
+            cache_provider=_ListProvider(),
+            interpolation="envelope",
+            attack_ms=10.0,
+            decay_ms=400.0,
+        )
+        await service.preload_track("/tmp/song.mp3", params=params)
+        assert service.bands_at("/tmp/song.mp3", 0, params=params) == bytes([0, 200])
+        rising, falling = service.bands_at("/tmp/song.mp3", 50, params=params) or b""
+        assert rising == 50
+        assert 100 < falling < 200
+        # A late render timestamp reads the current envelope instead of
+        # rewinding it.
+        assert service.bands_at("/tmp/song.mp3", 20, params=params) == bytes(
+            [rising, falling]
+        )
+        # Polls return unsmoothed frames and leave the render envelope alone.
+        polled = await service.sample(
+            track_path="/tmp/song.mp3", position_ms=0, params=params
+        )
+        assert polled.bands == bytes([0, 200])
+        assert service.bands_at("/tmp/song.mp3", 50, params=params) == bytes(
+            [rising, falling]
+        )
+
+    _run(run())
+
+
+def test_spectrum_service_preload_splices_new_segment() -> None:
+    class _SegmentedProvider(_CacheMissProvider):
+        def __init__(self) -> None:
+            self.frames = [SpectrumFrame(position_ms=0, bands=b"\x01")]
+
+        async def list_frames(
+            self, track_path: str, *, params: SpectrumParams, start_ms: int = 0
+        ) -> list[SpectrumFrame]:
+            del track_path, params
+            return [frame for frame in self.frames if frame.position_ms >= start_ms]
+
+    async def run() -> None:
+        provider = _SegmentedProvider()
+        service = SpectrumService(cache_provider=provider)
+        params = SpectrumParams(band_count=1, hop_ms=40)
+        assert await service.preload_track("/tmp/mix.mp3", params=params) == 1
+        provider.frames.append(SpectrumFrame(position_ms=1000, bands=b"\x09"))
+        assert (
+            await service.preload_track("/tmp/mix.mp3", params=params, start_ms=1000)
+            == 2
+        )
+        assert service.bands_at("/tmp/mix.mp3", 1000, params=params) == b"\x09"
+        assert (
+            await service.preload_track("/tmp/other.mp3", params=params, start_ms=1000)
+            == 0
+        )
+
+    _run(run())
+
+
+def test_spectrum_service_does_not_freeze_past_analyzed_segments() -> None:
+    class _PartialProvider(_CacheMissProvider):
+        def __init__(self) -> None:
+            self.covered_ms: int | None = 1000
+            self.frames = [
+                SpectrumFrame(position_ms=0, bands=b"\x01"),
+                SpectrumFrame(position_ms=960, bands=b"\x02"),
+            ]
+
+        async def list_frames(
+            self, track_path: str, *, params: SpectrumParams, start_ms: int = 0
+        ) -> list[SpectrumFrame]:
+            del track_path, params
+            return [frame for frame in self.frames if frame.position_ms >= start_ms]
+
+        async def spectrum_resume_ms(
+            self, track_path: str, *, params: SpectrumParams
+        ) -> int | None:
+            del track_path, params
+            return self.covered_ms
+
+    async def run() -> None:
+        provider = _PartialProvider()
+        scheduled: list[str] = []
+
+        async def schedule(track_path: str, params: SpectrumParams) -> None:
+            del params
+            scheduled.append(track_path)
+
+        service = SpectrumService(cache_provider=provider, schedule_analysis=schedule)
+        params = SpectrumParams(band_count=1, hop_ms=40)
+        await service.preload_track("/tmp/mix.mp3", params=params)
+        assert service.bands_at("/tmp/mix.mp3", 980, params=params) == b"\x02"
+        # A seek past the analyzed prefix waits for analysis instead of
+        # holding the last analyzed frame.
+        assert service.bands_at("/tmp/mix.mp3", 60_000, params=params) is None
+        reading = await service.sample(
+            track_path="/tmp/mix.mp3", position_ms=60_000, params=params
+        )
+        assert reading.status == "loading"
+        assert scheduled == ["/tmp/mix.mp3"]
+
+        provider.frames.append(SpectrumFrame(position_ms=1000, bands=b"\x09"))
+        provider.covered_ms = None
+        await service.preload_track("/tmp/mix.mp3", params=params, start_ms=1000)
+        assert service.bands_at("/tmp/mix.mp3", 60_000, params=params) == b"\x09"
+
+    _run(run())
@@ -131,3 +131,66 @@ def test_spectrum_store_get_frame_does_not_write_access_timestamp(tmp_path) -> N
         ).fetchone()
     assert row is not None
     assert int(row[0]) == 100
+
+
+def test_spectrum_store_appends_segments_and_tracks_coverage(tmp_path) -> None:
+    store = SqliteSpectrumStore(tmp_path / "library.sqlite")
+    _run(store.initialize())
+    track = tmp_path / "mix.mp3"
+    _touch(track, b"long mix")
+    params = SpectrumParams(band_count=2, hop_ms=500)
+
+    _run(
+        store.upsert_spectrum(
+            track,
+            duration_ms=1000,
+            params=params,
+            frames=[(0, b"\x01\x01"), (500, b"\x02\x02")],
+            covered_ms=1000,
+        )
+    )
+    assert _run(store.spectrum_resume_ms(track, params=params)) == 1000
+    # Past the analyzed prefix there is no frame yet, not the last one.
+    assert _run(store.get_frame_at(track, position_ms=5000, params=params)) is None
+    _run(
+        store.upsert_spectrum(
+            track,
+            duration_ms=1600,
+            params=params,
+            frames=[(1000, b"\x03\x03"), (1500, b"\x04\x04")],
+            segment_start_ms=1000,
+        )
+    )
+
+    assert _run(store.spectrum_resume_ms(track, params=params)) is None
+    frame = _run(store.get_frame_at(track, position_ms=5000, params=params))
+    assert frame is not None and frame.position_ms == 1500
+    frames = _run(store.list_frames(track, params=params))
+    assert [frame.position_ms for frame in frames] == [0, 500, 1000, 1500]
+    tail = _run(store.list_frames(track, params=params, start_ms=1000))
+    assert [frame.bands for frame in tail] == [b"\x03\x03", b"\x04\x04"]
+    with sqlite3.connect(tmp_path / "library.sqlite") as conn:
+        row = conn.execute(
+            "SELECT frame_count, byte_size, duration_ms FROM analysis_cache_entries"
+        ).fetchone()
+    assert row == (4, 8, 1600)
+
+
+def test_spectrum_store_ignores_entries_from_older_analyzer(tmp_path) -> None:
+    db_path = tmp_path / "analysis.sqlite"
+    track = tmp_path / "song.mp3"
+    _touch(track, b"audio")
+    params = SpectrumParams(band_count=2, hop_ms=40)
+    legacy = SqliteSpectrumStore(
+        db_path, analysis_version=SqliteSpectrumStore.ANALYSIS_VERSION - 1
+    )
+    _run(legacy.initialize())
+    _run(
+        legacy.upsert_spectrum(
+            track, duration_ms=80, params=params, frames=[(0, b"\x01\x02")]
+        )
+    )
+
+    store = SqliteSpectrumStore(db_path)
+    assert _run(store.has_spectrum(track, params=params)) is False
+    assert _run(store.get_frame_at(track, position_ms=0, params=params)) is None
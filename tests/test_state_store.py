@@ -25,6 +25,7 @@ def test_state_roundtrip(tmp_path) -> None:
         log_level="DEBUG",
         native_helper_enabled=False,
         native_helper_timeout_s=12.5,
+        analysis_concurrency=3,
     )
 
     save_state(path, state)
@@ -0,0 +1,62 @@
+"""Tests for idle-aware tick scheduling."""
+
+from __future__ import annotations
+
+import asyncio
+
+from tz_player.utils.tick_scheduler import (
+    IDLE_RENDER_FPS,
+    UNFOCUSED_RENDER_FPS,
+    TickScheduler,
+)
+
+
+def test_wait_for_playing_parks_until_playback_starts() -> None:
+    async def run() -> None:
+        ticks = TickScheduler()
+        waiter = asyncio.create_task(ticks.wait_for_playing())
+        await asyncio.sleep(0.01)
+        assert not waiter.done()
+        ticks.set_playing(True)
+        await asyncio.wait_for(waiter, timeout=1.0)
+        ticks.set_playing(False)
+        parked = asyncio.create_task(ticks.wait_for_playing())
+        await asyncio.sleep(0.01)
+        assert not parked.done()
+        parked.cancel()
+
+    asyncio.run(run())
+
+
+def test_render_fps_is_capped_by_mode() -> None:
+    ticks = TickScheduler()
+    modes: list[str] = []
+    ticks.add_listener(lambda: modes.append(ticks.mode))
+
+    assert ticks.render_fps(30) == IDLE_RENDER_FPS
+    ticks.set_playing(True)
+    assert ticks.render_fps(30) == 30
+    ticks.set_focused(False)
+    assert ticks.render_fps(30) == UNFOCUSED_RENDER_FPS
+    assert ticks.render_fps(1) == 1
+    assert modes == ["active", "unfocused"]
+
+
+def test_wakeups_are_counted_per_channel(caplog) -> None:
+    async def run(ticks: TickScheduler) -> None:
+        await ticks.sleep("player_poll", 0.0)
+        await ticks.sleep("player_poll", 0.0)
+
+    ticks = TickScheduler()
+    asyncio.run(run(ticks))
+    ticks.record_wakeup("vlc_worker")
+    assert ticks.snapshot() == {"player_poll": 2, "vlc_worker": 1}
+
+    caplog.set_level("INFO", logger="tz_player.utils.tick_scheduler")
+    ticks.set_playing(True)
+    records = [
+        r for r in caplog.records if getattr(r, "event", "") == "tick_scheduler_wakeups"
+    ]
+    assert len(records) == 1
+    assert records[0].mode == "idle"
+    assert records[0].total_wakeups == 3
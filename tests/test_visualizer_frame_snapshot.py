@@ -0,0 +1,148 @@
+"""Tests for shared visualizer frame snapshots."""
+
+from __future__ import annotations
+
+from dataclasses import replace
+
+from tz_player.services.player_service import PlayerState, TrackInfo
+from tz_player.visualizers.frame_snapshot import (
+    EMPTY_TRACK_CONTEXT,
+    FrameSnapshotBuilder,
+    OnsetScheduler,
+    apply_frame_delta,
+    frame_delta,
+    intern_track_context,
+)
+
+
+def _track(title: str = "Song") -> TrackInfo:
+    return TrackInfo(
+        title=title,
+        artist="Artist",
+        album="Album",
+        year=None,
+        path="/music/song.mp3",
+        duration_ms=1000,
+    )
+
+
+def _build(builder: FrameSnapshotBuilder, state: PlayerState, track, index: int):
+    return builder.build(
+        frame_index=index,
+        monotonic_s=float(index),
+        width=20,
+        height=4,
+        state=state,
+        track=track,
+    )
+
+
+def test_builder_reuses_state_fields_until_snapshot_changes() -> None:
+    builder = FrameSnapshotBuilder()
+    state = PlayerState(status="playing", position_ms=1500, spectrum_bands=b"\x01\x02")
+    track = _track()
+    first = _build(builder, state, track, 0)
+    second = _build(builder, state, track, 1)
+    assert builder.version == 1
+    assert first.position_s == 1.5
+    assert first.title == "Song"
+    assert second.frame_index == 1
+    assert second.spectrum_bands is first.spectrum_bands
+
+    third = _build(builder, replace(state, position_ms=2000), track, 2)
+    assert builder.version == 2
+    assert third.position_s == 2.0
+    assert third.track_path is first.track_path
+
+
+def test_track_context_is_interned_per_track() -> None:
+    a = intern_track_context(None, "/a.mp3", "A", None, None)
+    assert intern_track_context(None, "/a.mp3", "A", None, None) is a
+    frame = _build(FrameSnapshotBuilder(), PlayerState(), None, 0)
+    assert frame.track_path is EMPTY_TRACK_CONTEXT.track_path is None
+    assert frame.duration_s is None
+
+
+def test_frame_delta_round_trips_changed_fields_only() -> None:
+    builder = FrameSnapshotBuilder()
+    state = PlayerState(status="playing", spectrum_bands=b"\x00" * 4)
+    base = _build(builder, state, _track(), 0)
+    nxt = _build(builder, replace(state, spectrum_bands=b"\x05" * 4), _track(), 1)
+    delta = frame_delta(base, nxt)
+    assert set(delta) == {"frame_index", "monotonic_s", "spectrum_bands"}
+    assert apply_frame_delta(base, delta) == nxt
+    assert apply_frame_delta(nxt, {}) is nxt
+
+
+def test_builder_fires_scheduled_onsets_on_nearest_render_frame() -> None:
+    builder = FrameSnapshotBuilder()
+    state = PlayerState(
+        status="playing",
+        position_ms=0,
+        beat_status="ready",
+        beat_is_onset=False,
+        beat_onsets_ms=(140, 160, 900),
+    )
+    track = _track()
+    fired = [
+        builder.build(
+            frame_index=idx,
+            monotonic_s=idx * 0.1,
+            width=20,
+            height=4,
+            state=state,
+            track=track,
+        ).beat_is_onset
+        for idx in range(4)
+    ]
+    # 140 ms is nearest the 100 ms frame, 160 ms nearest the 200 ms frame.
+    assert fired == [False, True, True, False]
+
+
+def test_onset_scheduler_skips_stale_onsets_and_rearms_after_seek() -> None:
+    scheduler = OnsetScheduler()
+    # 1000 ms is long past; 4990 ms is within the stale window and fires late.
+    assert scheduler.step((1000, 4990), 5000.0)
+    assert not scheduler.step((1000, 4990), 5050.0)
+    assert scheduler.step((1000,), 1000.0)
+
+
+def test_builder_resolves_spectrum_at_extrapolated_playhead() -> None:
+    builder = FrameSnapshotBuilder()
+    state = PlayerState(
+        status="playing",
+        position_ms=1000,
+        spectrum_bands=b"\x01",
+        spectrum_status="ready",
+    )
+    seen: list[int] = []
+
+    def spectrum_at(position_ms: int) -> bytes:
+        seen.append(position_ms)
+        return bytes([position_ms // 10 % 256])
+
+    frames = [
+        builder.build(
+            frame_index=idx,
+            monotonic_s=2.0 + idx * 0.05,
+            width=20,
+            height=4,
+            state=state,
+            track=None,
+            spectrum_at=spectrum_at,
+        )
+        for idx in range(3)
+    ]
+    assert seen == [1000, 1050, 1100]
+    assert [frame.spectrum_bands for frame in frames] == [b"d", b"i", b"n"]
+    paused = builder.build(
+        frame_index=3,
+        monotonic_s=3.0,
+        width=20,
+        height=4,
+        state=replace(state, status="paused"),
+        track=None,
+        spectrum_at=spectrum_at,
+    )
+    assert seen[-1] == 1000
+    assert paused.spectrum_bands == b"d"
@@ -3,7 +3,7 @@
 from __future__ import annotations
 
 import logging
-from dataclasses import dataclass
+from dataclasses import dataclass, replace
 from pathlib import Path
 
 import pytest
@@ -238,7 +238,7 @@ class IsolatedLocalViz:
         return None
 
     def render(self, frame):
-        return f"iso:{frame.status}"
+        return f"iso:{frame.status}:{frame.frame_index}:{frame.title}"
 """.strip(),
         encoding="utf-8",
     )
@@ -267,5 +267,8 @@ class IsolatedLocalViz:
         artist=None,
         album=None,
     )
-    assert plugin.render(frame) == "iso:playing"
+    assert plugin.render(frame) == "iso:playing:0:None"
+    paused = replace(frame, frame_index=1, status="paused", title="Song")
+    assert plugin.render(paused) == "iso:paused:1:Song"
+    assert plugin.render(replace(paused, frame_index=2)) == "iso:paused:2:Song"
     plugin.on_deactivate()
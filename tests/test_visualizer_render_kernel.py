@@ -0,0 +1,126 @@
+"""Tests for the optional native visualizer render kernel and its fallbacks."""
+
+from __future__ import annotations
+
+import os
+import random
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tz_player.visualizers import render_kernel
+from tz_player.visualizers.render_kernel import (
+    NATIVE_RENDER_DISABLE_ENV,
+    NATIVE_RENDER_LIB_ENV,
+    collapse_bands,
+    native_render_available,
+    rasterize_bars,
+    serialize_grid,
+    shade_levels,
+)
+from tz_player.visualizers.spectrum_lut import CellPalette, ramp_shading
+
+_RED = "\x1b[38;2;255;0;0m"
+_BLUE = "\x1b[38;2;0;0;255m"
+_PALETTE = CellPalette.build([(" ", ""), ("#", _RED), ("*", _BLUE), (".", "")])
+
+
+@pytest.fixture
+def python_fallback(monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setenv(NATIVE_RENDER_DISABLE_ENV, "1")
+
+
+def _build_kernel_or_skip(tmp_path: Path) -> Path:
+    if os.name == "nt" or shutil.which("gcc") is None:
+        pytest.skip("gcc not available")
+    repo_root = Path(__file__).resolve().parents[1]
+    subprocess.run(
+        [
+            "bash",
+            "tools/build_native_spectrum_helper.sh",
+            str(tmp_path / "tz_player_native_helper"),
+        ],
+        cwd=repo_root,
+        check=True,
+        capture_output=True,
+    )
+    return tmp_path / "libtz_player_render.so"
+
+
+@pytest.mark.usefixtures("python_fallback")
+def test_serialize_grid_coalesces_runs_and_keeps_spaces_inside_runs() -> None:
+    cells = bytes([1, 1, 0, 1, 2, 3, 0])
+    assert serialize_grid(cells, 7, _PALETTE) == [f"{_RED}## #{_BLUE}*\x1b[0m. "]
+
+
+@pytest.mark.usefixtures("python_fallback")
+def test_serialize_grid_closes_color_at_end_of_each_row() -> None:
+    lines = serialize_grid(bytes([0, 2, 1, 0]), 2, _PALETTE)
+    assert lines == [f" {_BLUE}*\x1b[0m", f"{_RED}# \x1b[0m"]
+
+
+@pytest.mark.usefixtures("python_fallback")
+def test_rasterize_bars_places_caps_above_bodies() -> None:
+    grid = rasterize_bars(
+        [0, 2, 1], 3, cap_ids=b"\x01\x01\x01", body_ids=b"\x02\x02\x02"
+    )
+    assert [grid[idx : idx + 3] for idx in range(0, 9, 3)] == [
+        b"\x00\x01\x00",
+        b"\x00\x02\x01",
+        b"\x01\x02\x02",
+    ]
+
+
+@pytest.mark.usefixtures("python_fallback")
+def test_collapse_and_shade_use_lookup_tables() -> None:
+    assert collapse_bands(bytes([0, 100, 200, 50]), 2, peak=True) == bytes([100, 200])
+    assert collapse_bands(bytes([1, 2]), 1, peak=False) == bytes([2])
+    assert collapse_bands(None, 3, peak=False) == bytes(3)
+    _palette, lut = ramp_shading(False, True)
+    assert shade_levels(bytes([0, 255]), lut) == bytes([0, lut[255]])
+    with pytest.raises(ValueError):
+        shade_levels(b"\x00", b"\x00")
+
+
+def test_native_kernel_matches_python_fallback(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    lib_path = _build_kernel_or_skip(tmp_path)
+    native_env = {NATIVE_RENDER_LIB_ENV: str(lib_path)}
+    assert native_render_available(native_env)
+    rng = random.Random(7)
+    palette, lut = ramp_shading(True, True)
+    cases = []
+    for _ in range(40):
+        bands = bytes(rng.randrange(256) for _ in range(rng.randrange(1, 96)))
+        width = rng.randrange(1, 160)
+        rows = rng.randrange(1, 24)
+        heights = [rng.randrange(-1, rows + 2) for _ in range(width)]
+        cases.append((bands, width, rows, heights))
+
+    def run_all() -> list[object]:
+        out: list[object] = []
+        for bands, width, rows, heights in cases:
+            peak = collapse_bands(bands, width, peak=True)
+            mean = collapse_bands(bands, width, peak=False)
+            grid = rasterize_bars(
+                heights, rows, cap_ids=bytes([1]) * width, body_ids=bytes([2]) * width
+            )
+            out.extend([peak, mean, grid])
+            out.append(serialize_grid(shade_levels(peak, lut), width, palette))
+            out.append(serialize_grid(grid, width, _PALETTE))
+        return out
+
+    monkeypatch.setenv(NATIVE_RENDER_DISABLE_ENV, "1")
+    expected = run_all()
+    monkeypatch.delenv(NATIVE_RENDER_DISABLE_ENV)
+    monkeypatch.setenv(NATIVE_RENDER_LIB_ENV, str(lib_path))
+    assert render_kernel._active_kernel() is not None
+    assert run_all() == expected
+
+
+def test_missing_native_library_falls_back_to_python(tmp_path: Path) -> None:
+    env = {NATIVE_RENDER_LIB_ENV: str(tmp_path / "missing.so")}
+    assert native_render_available(env) is False
@@ -492,7 +492,8 @@ def test_startup_logs_visualizer_responsiveness_profile_event(
     event = events[-1]
     assert getattr(event, "profile", None) == "safe"
     assert getattr(event, "visualizer_fps", None) == 10
-    assert getattr(event, "spectrum_hop_ms", None) == 40
+    assert getattr(event, "spectrum_hop_ms", None) == 60
+    assert getattr(event, "spectrum_interpolation", None) == "envelope"
     assert getattr(event, "beat_hop_ms", None) == 40
 
 
@@ -0,0 +1,75 @@
+"""Tests for shared spectrum visualizer lookup tables."""
+
+from __future__ import annotations
+
+from tz_player.visualizers.spectrum_lut import (
+    HEAT_HIGH_SGR,
+    HEAT_LOW_SGR,
+    HEAT_MID_SGR,
+    band_ranges,
+    collapse_bands_mean,
+    collapse_bands_peak,
+    fft_meter_shading,
+    ramp_shading,
+    row_heat_tiers,
+    tiered_palette,
+)
+
+
+def test_band_ranges_cover_every_column_and_are_memoized() -> None:
+    ranges = band_ranges(48, 20)
+    assert len(ranges) == 20
+    assert ranges[0][0] == 0
+    assert ranges[-1][1] == 48
+    assert all(end > start for start, end in ranges)
+    assert band_ranges(48, 20) is ranges
+
+
+def test_band_ranges_upsample_repeats_bands_when_width_exceeds_count() -> None:
+    ranges = band_ranges(4, 10)
+    assert len(ranges) == 10
+    assert all(end - start == 1 for start, end in ranges)
+
+
+def test_collapse_bands_mean_and_peak_pool_buckets() -> None:
+    bands = bytes([0, 100, 200, 50])
+    assert collapse_bands_mean(bands, 2) == [50, 125]
+    assert collapse_bands_peak(bands, 2) == [100, 200]
+    assert collapse_bands_mean(None, 3) == [0, 0, 0]
+    assert collapse_bands_peak(b"", 2) == [0, 0]
+
+
+def test_ramp_shading_maps_levels_to_tiered_palette_ids() -> None:
+    palette, lut = ramp_shading(True, True)
+    assert len(lut) == 256
+    assert lut[0] == 0
+    assert palette.glyphs[0] == " "
+    assert palette.sgrs[lut[60]] == HEAT_LOW_SGR
+    assert palette.sgrs[lut[150]] == HEAT_MID_SGR
+    assert palette.sgrs[lut[255]] == HEAT_HIGH_SGR
+    plain, plain_lut = ramp_shading(False, False)
+    assert plain.glyphs[plain_lut[255]] == "@"
+    assert not plain.colored
+
+
+def test_fft_meter_shading_matches_ascii_and_ansi_thresholds() -> None:
+    palette, lut = fft_meter_shading(False)
+    glyphs = tuple(palette.glyphs[lut[level]] for level in (10, 40, 120, 220))
+    assert glyphs == (".", "-", "=", "#")
+    colored, colored_lut = fft_meter_shading(True)
+    assert colored.sgrs[colored_lut[10]] == ""
+    assert colored.sgrs[colored_lut[220]] == HEAT_HIGH_SGR
+
+
+def test_row_heat_tiers_scale_with_row_count() -> None:
+    tiers = row_heat_tiers(10)
+    assert len(tiers) == 10
+    assert (tiers[0], tiers[5], tiers[9]) == (0, 1, 2)
+    assert row_heat_tiers(1) == (0,)
+
+
+def test_tiered_palette_reserves_blank_id_and_strips_color_without_ansi() -> None:
+    palette = tiered_palette(("^", "#"), True)
+    assert palette.glyphs == (" ", "^", "^", "^", "#", "#", "#")
+    assert palette.sgrs[4] == HEAT_LOW_SGR
+    assert not tiered_palette(("^", "#"), False).colored
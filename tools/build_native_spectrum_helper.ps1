@@ -16,22 +16,27 @@ if (-not $OutPath) {
     $OutPath = Join-Path $OutDir "tz_player_native_helper.exe"
 }
 $src = Join-Path $repoRoot "tools\tz_player_native_helper.c"
+$renderSrc = Join-Path $repoRoot "tools\tz_player_native_render.c"
 $outDir = Split-Path -Parent $OutPath
 if (-not (Test-Path -LiteralPath $outDir)) {
     New-Item -ItemType Directory -Path $outDir | Out-Null
 }
 
+$dspOutPath = Join-Path $outDir "tz_player_native.dll"
+$renderOutPath = Join-Path $outDir "tz_player_render.dll"
+
 function Invoke-Build {
     param(
         [string]$Compiler,
-        [string[]]$CompilerArgs
+        [string[]]$CompilerArgs,
+        [string]$ExpectedOutput = $OutPath
     )
     & $Compiler @CompilerArgs
     if ($LASTEXITCODE -ne 0) {
         throw "build failed via $Compiler (exit=$LASTEXITCODE)"
     }
-    if (-not (Test-Path -LiteralPath $OutPath)) {
-        throw "compiler exited successfully but output was not created: $OutPath"
+    if (-not (Test-Path -LiteralPath $ExpectedOutput)) {
+        throw "compiler exited successfully but output was not created: $ExpectedOutput"
     }
 }
 
@@ -112,6 +117,27 @@ if ($cl) {
         "Advapi32.lib"
     )
     Write-Output "built=$OutPath (compiler=cl.exe)"
+    Invoke-Build -Compiler $cl.Source -ExpectedOutput $dspOutPath -CompilerArgs @(
+        "/nologo",
+        "/O2",
+        "/W3",
+        "/LD",
+        "/D_CRT_SECURE_NO_WARNINGS",
+        "/DTZ_PLAYER_NATIVE_LIBRARY",
+        "/Fe:$dspOutPath",
+        $src,
+        "Advapi32.lib"
+    )
+    Write-Output "built=$dspOutPath (compiler=cl.exe)"
+    Invoke-Build -Compiler $cl.Source -ExpectedOutput $renderOutPath -CompilerArgs @(
+        "/nologo",
+        "/O2",
+        "/W3",
+        "/LD",
+        "/Fe:$renderOutPath",
+        $renderSrc
+    )
+    Write-Output "built=$renderOutPath (compiler=cl.exe)"
     exit 0
 }
 
@@ -137,6 +163,30 @@ if ($gcc) {
         "-lm"
     )
     Write-Output "built=$OutPath (compiler=gcc.exe)"
+    Invoke-Build -Compiler $gcc.Source -ExpectedOutput $dspOutPath -CompilerArgs @(
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-std=c11",
+        "-shared",
+        "-DTZ_PLAYER_NATIVE_LIBRARY",
+        "-o",
+        $dspOutPath,
+        $src,
+        "-lm"
+    )
+    Write-Output "built=$dspOutPath (compiler=gcc.exe)"
+    Invoke-Build -Compiler $gcc.Source -ExpectedOutput $renderOutPath -CompilerArgs @(
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-std=c11",
+        "-shared",
+        "-o",
+        $renderOutPath,
+        $renderSrc
+    )
+    Write-Output "built=$renderOutPath (compiler=gcc.exe)"
     exit 0
 }
 
@@ -153,6 +203,30 @@ if ($clang) {
         "-lm"
     )
     Write-Output "built=$OutPath (compiler=clang.exe)"
+    Invoke-Build -Compiler $clang.Source -ExpectedOutput $dspOutPath -CompilerArgs @(
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-std=c11",
+        "-shared",
+        "-DTZ_PLAYER_NATIVE_LIBRARY",
+        "-o",
+        $dspOutPath,
+        $src,
+        "-lm"
+    )
+    Write-Output "built=$dspOutPath (compiler=clang.exe)"
+    Invoke-Build -Compiler $clang.Source -ExpectedOutput $renderOutPath -CompilerArgs @(
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-std=c11",
+        "-shared",
+        "-o",
+        $renderOutPath,
+        $renderSrc
+    )
+    Write-Output "built=$renderOutPath (compiler=clang.exe)"
     exit 0
 }
 
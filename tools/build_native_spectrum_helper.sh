@@ -3,13 +3,16 @@ set -euo pipefail
 
 usage() {
   cat <<'EOF'
-Build the native spectrum helper.
+Build the native spectrum helper, the in-process DSP library, and the optional
+visualizer render kernel.
 
 Usage:
   tools/build_native_spectrum_helper.sh [OUT_PATH]
   tools/build_native_spectrum_helper.sh --out-dir DIR
 
-Defaults to the packaged helper path under src/tz_player/binaries.
+Defaults to the packaged helper path under src/tz_player/binaries. The DSP
+library (libtz_player_native.so) and render kernel shared library are written
+next to the helper.
 EOF
 }
 
@@ -54,3 +57,35 @@ gcc \
   -o "${out_path}"
 
 echo "built=${out_path}"
+
+dsp_out_path="$(dirname -- "${out_path}")/libtz_player_native.so"
+gcc \
+  -O3 \
+  -std=c11 \
+  -Wall \
+  -Wextra \
+  -pedantic \
+  -shared \
+  -fPIC \
+  -fvisibility=hidden \
+  -DTZ_PLAYER_NATIVE_LIBRARY \
+  tools/tz_player_native_helper.c \
+  -lm \
+  -o "${dsp_out_path}"
+
+echo "built=${dsp_out_path}"
+
+render_out_path="$(dirname -- "${out_path}")/libtz_player_render.so"
+gcc \
+  -O3 \
+  -std=c11 \
+  -Wall \
+  -Wextra \
+  -pedantic \
+  -shared \
+  -fPIC \
+  -fvisibility=hidden \
+  tools/tz_player_native_render.c \
+  -o "${render_out_path}"
+
+echo "built=${render_out_path}"
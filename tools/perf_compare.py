@@ -1,4 +1,11 @@
-"""Compare two opt-in performance benchmark JSON artifacts."""
+"""Compare baseline and candidate opt-in performance benchmark JSON artifacts.
+
+Each side may be a run artifact, a suite summary, or a directory of artifacts.
+With one run per side this prints the plain median diff. With repeated runs
+(`perf_run.py --repeat N`, N >= 4 at the default alpha) every metric is
+tested for significance and the exit status is 1 when any metric regressed
+beyond noise. Fewer runs are reported as insufficient data.
+"""
 
 from __future__ import annotations
 
@@ -6,19 +13,30 @@ import argparse
 from pathlib import Path
 
 from tz_player.perf_benchmarking import (
+    BOOTSTRAP_ITERATIONS,
+    SIGNIFICANCE_ALPHA,
+    compare_perf_run_groups,
     compare_perf_run_payloads,
-    load_perf_run_payload,
+    load_perf_run_payloads,
+    parse_metric_thresholds,
     render_perf_comparison_text,
+    render_perf_significance_text,
 )
 
 
 def _parse_args() -> argparse.Namespace:
-    parser = argparse.ArgumentParser(description=__doc__)
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
     parser.add_argument(
-        "baseline", type=Path, help="Path to baseline perf JSON artifact"
+        "baseline",
+        type=Path,
+        help="Baseline perf artifact, suite summary, or artifact directory",
     )
     parser.add_argument(
-        "candidate", type=Path, help="Path to candidate perf JSON artifact"
+        "candidate",
+        type=Path,
+        help="Candidate perf artifact, suite summary, or artifact directory",
     )
     parser.add_argument(
         "--regression-pct",
@@ -32,6 +50,28 @@ def _parse_args() -> argparse.Namespace:
         default=-5.0,
         help="Percent decrease threshold treated as improvement (default: -5.0).",
     )
+    parser.add_argument(
+        "--metric-threshold",
+        action="append",
+        default=[],
+        metavar="PATTERN=PCT",
+        help=(
+            "Per-metric symmetric threshold percent; PATTERN is an fnmatch glob "
+            "over scenario.metric keys. Repeatable; first match wins."
+        ),
+    )
+    parser.add_argument(
+        "--alpha",
+        type=float,
+        default=SIGNIFICANCE_ALPHA,
+        help=f"Mann-Whitney significance level (default: {SIGNIFICANCE_ALPHA}).",
+    )
+    parser.add_argument(
+        "--bootstrap-iterations",
+        type=int,
+        default=BOOTSTRAP_ITERATIONS,
+        help=f"Bootstrap resamples for CIs (default: {BOOTSTRAP_ITERATIONS}).",
+    )
     parser.add_argument(
         "--max-rows",
         type=int,
@@ -43,20 +83,41 @@ def _parse_args() -> argparse.Namespace:
 
 def main() -> int:
     args = _parse_args()
-    baseline = load_perf_run_payload(args.baseline.resolve())
-    candidate = load_perf_run_payload(args.candidate.resolve())
-    comparison = compare_perf_run_payloads(
-        baseline,
-        candidate,
+    try:
+        metric_thresholds = parse_metric_thresholds(args.metric_threshold)
+    except ValueError as exc:
+        print(f"error: {exc}")
+        return 2
+    baselines = load_perf_run_payloads(args.baseline.resolve())
+    candidates = load_perf_run_payloads(args.candidate.resolve())
+    if not baselines or not candidates:
+        print("error: no perf run artifacts found for baseline or candidate")
+        return 2
+    max_rows = max(1, args.max_rows)
+    if len(baselines) == 1 and len(candidates) == 1:
+        comparison = compare_perf_run_payloads(
+            baselines[0],
+            candidates[0],
+            regression_pct_threshold=float(args.regression_pct),
+            improvement_pct_threshold=float(args.improvement_pct),
+        )
+        print(render_perf_comparison_text(comparison, max_rows_per_section=max_rows))
+        print(
+            "note: single runs cannot separate regressions from noise; "
+            "use perf_run.py --repeat N for a significance-gated comparison"
+        )
+        return 0
+    result = compare_perf_run_groups(
+        baselines,
+        candidates,
         regression_pct_threshold=float(args.regression_pct),
         improvement_pct_threshold=float(args.improvement_pct),
+        metric_thresholds=metric_thresholds,
+        alpha=float(args.alpha),
+        bootstrap_iterations=max(1, int(args.bootstrap_iterations)),
     )
-    print(
-        render_perf_comparison_text(
-            comparison, max_rows_per_section=max(1, args.max_rows)
-        )
-    )
-    return 0
+    print(render_perf_significance_text(result, max_rows_per_section=max_rows))
+    return 1 if result.regressed_metrics else 0
 
 
 if __name__ == "__main__":
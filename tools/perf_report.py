@@ -11,7 +11,14 @@ from pathlib import Path, PureWindowsPath
 from statistics import fmean
 from typing import Any
 
-from tz_player.perf_benchmarking import compare_perf_run_payloads, load_perf_run_payload
+from tz_player.perf_benchmarking import (
+    VERDICT_IMPROVED,
+    VERDICT_REGRESSED,
+    compare_perf_run_groups,
+    compare_perf_run_payloads,
+    load_perf_run_payload,
+    parse_metric_thresholds,
+)
 
 
 @dataclass(frozen=True)
@@ -194,6 +201,13 @@ def _parse_args() -> argparse.Namespace:
         default=-5.0,
         help="Comparison improvement threshold percent (default: -5.0).",
     )
+    parser.add_argument(
+        "--metric-threshold",
+        action="append",
+        default=[],
+        metavar="PATTERN=PCT",
+        help="Per-metric comparison threshold percent (fnmatch over scenario.metric).",
+    )
     return parser.parse_args()
 
 
@@ -467,6 +481,7 @@ def _render_compare_section(
     *,
     regression_pct: float,
     improvement_pct: float,
+    metric_thresholds: dict[str, float] | None = None,
 ) -> str:
     base_groups = _group_entries(baseline_entries)
     cand_groups = _group_entries(candidate_entries)
@@ -528,6 +543,13 @@ def _render_compare_section(
             "</section>"
         )
 
+    significance_html = _render_significance_section(
+        baseline_entries,
+        candidate_entries,
+        regression_pct=regression_pct,
+        improvement_pct=improvement_pct,
+        metric_thresholds=metric_thresholds,
+    )
     mismatch_html = ""
     if mismatches:
         mismatch_html = (
@@ -548,11 +570,70 @@ def _render_compare_section(
     return (
         "<section><h2>Comparison Summary</h2>"
         f"<div class='cards'>{summary_cards}</div></section>"
+        + significance_html
         + mismatch_html
         + "".join(sections)
     )
 
 
+_VERDICT_LABELS = {
+    VERDICT_REGRESSED: ("regressed", "bad"),
+    VERDICT_IMPROVED: ("improved", "good"),
+}
+
+
+def _render_significance_section(
+    baseline_entries: list[SuiteArtifactEntry],
+    candidate_entries: list[SuiteArtifactEntry],
+    *,
+    regression_pct: float,
+    improvement_pct: float,
+    metric_thresholds: dict[str, float] | None,
+) -> str:
+    result = compare_perf_run_groups(
+        [entry.payload for entry in baseline_entries],
+        [entry.payload for entry in candidate_entries],
+        regression_pct_threshold=regression_pct,
+        improvement_pct_threshold=improvement_pct,
+        metric_thresholds=metric_thresholds,
+    )
+    if not result.metrics:
+        return ""
+    rows = []
+    for item in result.metrics:
+        label, css = _VERDICT_LABELS.get(item.verdict, ("within noise", "muted"))
+        if item.p_value is None:
+            label, css = "insufficient runs", "muted"
+        ci = (
+            "n/a"
+            if item.ci_low_pct is None or item.ci_high_pct is None
+            else f"{_fmt_pct(item.ci_low_pct)} .. {_fmt_pct(item.ci_high_pct)}"
+        )
+        p_text = "n/a" if item.p_value is None else f"{item.p_value:.3f}"
+        rows.append(
+            "<tr>"
+            f"<td>{_escape(item.scenario_id + '.' + item.metric_name)}</td>"
+            f"<td>{_escape(item.unit)}</td>"
+            f"<td>{len(item.baseline_values)}/{len(item.candidate_values)}</td>"
+            f"<td>{_fmt_num(item.baseline_median)}</td>"
+            f"<td>{_fmt_num(item.candidate_median)}</td>"
+            f"<td class='{css}'>{_fmt_pct(item.pct_median)}</td>"
+            f"<td>{_escape(ci)}</td>"
+            f"<td>{_escape(p_text)}</td>"
+            f"<td class='{css}'>{_escape(label)}</td>"
+            "</tr>"
+        )
+    return (
+        "<section><h2>Significance (repeated runs)</h2>"
+        f"<p class='muted'>Per-run medians compared with a Mann-Whitney U test "
+        f"(alpha={result.alpha:g}) and a bootstrap 95% CI of the median change.</p>"
+        "<table><thead><tr><th>Metric</th><th>Unit</th><th>Runs (base/cand)</th>"
+        "<th>Base median</th><th>Cand median</th><th>Delta %</th><th>95% CI</th>"
+        "<th>p</th><th>Verdict</th></tr></thead>"
+        f"<tbody>{''.join(rows)}</tbody></table></section>"
+    )
+
+
 def _render_html(
     suite_path: Path,
     summary: dict[str, Any],
@@ -564,6 +645,7 @@ def _render_html(
     max_metrics: int,
     regression_pct: float,
     improvement_pct: float,
+    metric_thresholds: dict[str, float] | None = None,
 ) -> str:
     title = f"tz-player Perf Report: {summary.get('run_id', suite_path.name)}"
     group_sections = "".join(
@@ -583,6 +665,7 @@ def _render_html(
             compare_entries,
             regression_pct=regression_pct,
             improvement_pct=improvement_pct,
+            metric_thresholds=metric_thresholds,
         )
     selected_scenarios = summary.get("selected_scenarios") or []
     scenarios_html = "".join(
@@ -681,6 +764,7 @@ def main() -> int:
         max_metrics=max(1, int(args.max_metrics)),
         regression_pct=float(args.regression_pct),
         improvement_pct=float(args.improvement_pct),
+        metric_thresholds=parse_metric_thresholds(args.metric_threshold),
     )
     output_path.write_text(html_text, encoding="utf-8")
     print(f"Wrote perf report: {output_path}")
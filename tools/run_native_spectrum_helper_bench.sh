@@ -17,6 +17,8 @@ Options:
                         Supported: analysis-cache, analysis-bundle-sw
   --timeout-s SECONDS    Helper timeout (default: 30 for stub, 8 for c)
   --python PATH          Python executable (default: .ubuntu-venv/bin/python)
+  --perf-counters        Collect per-stage hardware counters (Linux perf_event;
+                        reported as unavailable when the host forbids it)
   -h, --help             Show this help text
 
 Examples:
@@ -32,6 +34,7 @@ REPEAT="1"
 SCENARIO="analysis-cache"
 TIMEOUT_S=""
 PYTHON_BIN=".ubuntu-venv/bin/python"
+PERF_COUNTERS="0"
 
 while [[ $# -gt 0 ]]; do
   case "$1" in
@@ -63,6 +66,10 @@ while [[ $# -gt 0 ]]; do
       PYTHON_BIN="${2:?missing value for --python}"
       shift 2
       ;;
+    --perf-counters)
+      PERF_COUNTERS="1"
+      shift 1
+      ;;
     -h|--help)
       usage
       exit 0
@@ -113,6 +120,7 @@ echo "helper_cmd=${HELPER_CMD}"
 echo "helper_timeout_s=${TIMEOUT_S}"
 echo "repeat=${REPEAT}"
 echo "scenario=${SCENARIO}"
+echo "perf_counters=${PERF_COUNTERS}"
 if [[ -n "${MEDIA_DIR}" ]]; then
   echo "media_dir=${MEDIA_DIR}"
 fi
@@ -121,6 +129,7 @@ ENV_ARGS=(
   "TZ_PLAYER_RUN_PERF=1"
   "TZ_PLAYER_NATIVE_SPECTRUM_HELPER_CMD=${HELPER_CMD}"
   "TZ_PLAYER_NATIVE_SPECTRUM_HELPER_TIMEOUT_S=${TIMEOUT_S}"
+  "TZ_PLAYER_HELPER_PERF_COUNTERS=${PERF_COUNTERS}"
 )
 if [[ -n "${MEDIA_DIR}" ]]; then
   ENV_ARGS+=("TZ_PLAYER_PERF_MEDIA_DIR=${MEDIA_DIR}")
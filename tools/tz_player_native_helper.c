@@ -1,4 +1,8 @@
 #define _POSIX_C_SOURCE 200809L
+#ifdef __linux__
+/* Declares syscall(2), used for the optional perf_event_open counters. */
+#define _DEFAULT_SOURCE
+#endif
 
 #include <ctype.h>
 #include <errno.h>
@@ -20,6 +24,10 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
 
 /*
  * tz_player_native_helper.c
@@ -34,6 +42,11 @@
  * Data flow (high level)
  *   stdin JSON -> parse Request -> decode audio -> resample (mono) ->
  *   spectrum/beat/waveform -> stdout JSON
+ *
+ * Shared library build
+ * - Compiled with -DTZ_PLAYER_NATIVE_LIBRARY the same kernels are exported as
+ *   `libtz_player_native` (see the ABI section at the end of this file) so
+ *   Python paths that already hold PCM can call them in-process via ctypes.
  */
 
 #define REQUEST_SCHEMA "tz_player.native_spectrum_helper_request.v1"
@@ -73,6 +86,10 @@ typedef struct {
     int waveform_proxy_enabled;
     int waveform_hop_ms;
     int waveform_max_frames;
+    int perf_counters;
+    /* Full-scale references carried from an earlier segment; 0 derives them. */
+    float spectrum_peak;
+    double beat_peak;
 } Request;
 
 /* Decoded audio (mono + stereo copies) in floating point [-1, 1]. */
@@ -97,6 +114,7 @@ typedef struct {
     int duration_ms;
     size_t frame_count;
     SpectrumFrame *frames;
+    float peak; /* magnitude quantized to full scale */
 } SpectrumResult;
 
 /* Beat detection output: per-frame strength + beat flags. */
@@ -111,6 +129,7 @@ typedef struct {
     double bpm;
     size_t frame_count;
     BeatFrame *frames;
+    double peak; /* onset strength quantized to full scale */
 } BeatResult;
 
 /* Waveform proxy: per-frame min/max for left/right channels. */
@@ -128,6 +147,22 @@ typedef struct {
     WaveformProxyFrame *frames;
 } WaveformProxyResult;
 
+/* Window size selection (clamped) for spectrum analysis. */
+static int next_pow2_clamped(int value) {
+    int size = 1;
+    while (size < value) {
+        size <<= 1;
+    }
+    if (size < 256) {
+        size = 256;
+    }
+    if (size > 2048) {
+        size = 2048;
+    }
+    return size;
+}
+
+#ifndef TZ_PLAYER_NATIVE_LIBRARY
 /* Monotonic clock in milliseconds for timing/metrics. */
 static double now_ms(void) {
 #ifdef _WIN32
@@ -159,21 +194,6 @@ static uint16_t read_u16_le(const uint8_t *p) {
     return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
 }
 
-/* Window size selection (clamped) for spectrum analysis. */
-static int next_pow2_clamped(int value) {
-    int size = 1;
-    while (size < value) {
-        size <<= 1;
-    }
-    if (size < 256) {
-        size = 256;
-    }
-    if (size > 2048) {
-        size = 2048;
-    }
-    return size;
-}
-
 /* Slurp stdin into a null-terminated buffer. */
 static char *read_stdin_all(size_t *out_len) {
     size_t cap = 4096;
@@ -452,6 +472,7 @@ static int parse_request(const char *json, Request *req) {
         req->waveform_max_frames = 30000;
     }
     free(waveform_obj);
+    (void)json_extract_int(json, "perf_counters", &req->perf_counters);
     if (req->hop_ms < 10) {
         req->hop_ms = 10;
     }
@@ -502,6 +523,7 @@ static void free_request(Request *req) {
     req->track_path = NULL;
 }
 
+/* File decoding (WAV parser, ffmpeg) is CLI-only; the library takes PCM. */
 static int path_has_suffix_ci(const char *path, const char *suffix) {
     if (!path || !suffix) {
         return 0;
@@ -546,6 +568,45 @@ static char *cmd_double_quote(const char *input) {
 }
 #endif
 
+/*
+ * Analysis reads each file once, front to back. Hint that to the kernel so it
+ * reads ahead, read in large aligned chunks, and drop the pages afterwards so
+ * they do not evict data the player is streaming.
+ */
+#define ANALYSIS_READ_CHUNK_BYTES (1u << 20)
+
+static void advise_sequential_read(FILE *fp) {
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    (void)posix_fadvise(fileno(fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    (void)fp;
+#endif
+}
+
+static void advise_done_reading(FILE *fp) {
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+    (void)posix_fadvise(fileno(fp), 0, 0, POSIX_FADV_DONTNEED);
+#else
+    (void)fp;
+#endif
+}
+
+static int read_file_chunked(FILE *fp, uint8_t *buf, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        size_t want = size - done;
+        if (want > ANALYSIS_READ_CHUNK_BYTES) {
+            want = ANALYSIS_READ_CHUNK_BYTES;
+        }
+        size_t got = fread(buf + done, 1, want, fp);
+        if (got == 0) {
+            return 0;
+        }
+        done += got;
+    }
+    return 1;
+}
+
 /* Decode a simple PCM WAV file (16-bit mono or stereo). */
 static int decode_wav_file(const char *path, DecodedAudio *out) {
     memset(out, 0, sizeof(*out));
@@ -567,16 +628,19 @@ static int decode_wav_file(const char *path, DecodedAudio *out) {
         return 0;
     }
     rewind(fp);
+    advise_sequential_read(fp);
     uint8_t *buf = (uint8_t *)malloc((size_t)file_size);
     if (!buf) {
         fclose(fp);
         return 0;
     }
-    if (fread(buf, 1, (size_t)file_size, fp) != (size_t)file_size) {
+    if (!read_file_chunked(fp, buf, (size_t)file_size)) {
         free(buf);
+        advise_done_reading(fp);
         fclose(fp);
         return 0;
     }
+    advise_done_reading(fp);
     fclose(fp);
 
     if (memcmp(buf, "RIFF", 4) != 0 || memcmp(buf + 8, "WAVE", 4) != 0) {
@@ -1123,6 +1187,7 @@ static void free_decoded_audio(DecodedAudio *audio) {
     free(audio->right_samples);
     memset(audio, 0, sizeof(*audio));
 }
+#endif /* !TZ_PLAYER_NATIVE_LIBRARY */
 
 /* Map 0..1 float magnitudes to a perceptually nicer 0..255 curve. */
 static uint8_t quantize_level(float normalized) {
@@ -1144,10 +1209,182 @@ static uint8_t quantize_level(float normalized) {
 }
 
 /*
- * Spectrum analysis for each hop using a Goertzel-style filter bank.
+ * Octave decimation for the spectrum filter bank: each level halves the sample
+ * rate with a half-band low-pass. A band moves down a level only while it stays
+ * below SPECTRUM_OCTAVE_BAND_LIMIT of that level's rate, clear of the filter's
+ * transition region.
+ */
+#define SPECTRUM_MAX_OCTAVE_DEPTH 6
+#define SPECTRUM_OCTAVE_BAND_LIMIT 0.35f
+#define SPECTRUM_MIN_OCTAVE_WINDOW 32
+#define HALF_BAND_HALF_LENGTH 7
+
+typedef struct {
+    int depth;
+    int window_size;
+    int band_count;
+    int *band_indices;
+    float *coeffs;
+    float *hann;
+    float *window;
+    float power_scale;
+} SpectrumLevel;
+
+static int spectrum_band_depth(int rate, float freq) {
+    int depth = 0;
+    while (depth < SPECTRUM_MAX_OCTAVE_DEPTH &&
+           freq < SPECTRUM_OCTAVE_BAND_LIMIT * (float)rate / (float)(1 << (depth + 1))) {
+        depth++;
+    }
+    return depth;
+}
+
+/* Hann-windowed sinc half-band taps: centre tap plus odd offsets 1,3,5,7. */
+static void half_band_taps(float *center, float *odd_taps) {
+    float sum = 0.0f;
+    int n = 0;
+    for (int offset = 1; offset <= HALF_BAND_HALF_LENGTH; offset += 2) {
+        float x = (float)offset * 0.5f;
+        float sinc = sinf((float)M_PI * x) / ((float)M_PI * x);
+        float weight =
+            0.5f + 0.5f * cosf((float)M_PI * (float)offset / (float)(HALF_BAND_HALF_LENGTH + 1));
+        odd_taps[n] = 0.5f * sinc * weight;
+        sum += odd_taps[n];
+        n++;
+    }
+    float gain = 0.5f + 2.0f * sum;
+    *center = 0.5f / gain;
+    for (int i = 0; i < n; i++) {
+        odd_taps[i] /= gain;
+    }
+}
+
+/* Low-pass below a quarter of the rate, then keep every other sample. */
+static float *half_band_decimate(const float *samples, size_t count, size_t *out_count) {
+    float center = 0.0f;
+    float odd_taps[(HALF_BAND_HALF_LENGTH + 1) / 2];
+    half_band_taps(&center, odd_taps);
+    size_t n_out = (count + 1) / 2;
+    float *out = (float *)malloc(sizeof(float) * (n_out > 0 ? n_out : 1));
+    if (!out) {
+        return NULL;
+    }
+    for (size_t m = 0; m < n_out; m++) {
+        size_t idx = m * 2;
+        float acc = center * samples[idx];
+        int tap = 0;
+        for (int offset = 1; offset <= HALF_BAND_HALF_LENGTH; offset += 2, tap++) {
+            float lo = idx >= (size_t)offset ? samples[idx - (size_t)offset] : 0.0f;
+            float hi = idx + (size_t)offset < count ? samples[idx + (size_t)offset] : 0.0f;
+            acc += odd_taps[tap] * (lo + hi);
+        }
+        out[m] = acc;
+    }
+    *out_count = n_out;
+    return out;
+}
+
+static void free_spectrum_levels(SpectrumLevel *levels, int level_count) {
+    for (int i = 0; i < level_count; i++) {
+        free(levels[i].band_indices);
+        free(levels[i].coeffs);
+        free(levels[i].hann);
+        free(levels[i].window);
+    }
+}
+
+/*
+ * Assign bands to the lowest sample rate that still contains them. Depth 0
+ * keeps the full-rate window; deeper levels size their window for roughly one
+ * Goertzel bin per band (constant-Q) while still spanning the hop, and rescale
+ * power to the depth-0 window length so bands stay comparable.
+ */
+static int build_spectrum_levels(int rate, const float *freqs, int band_count, int hop_samples,
+                                 int base_window, SpectrumLevel *levels, int *out_level_count) {
+    int depths[MAX_BAND_COUNT];
+    float q = 1.0f;
+    if (band_count > 1 && freqs[1] > freqs[0]) {
+        q = freqs[0] / (freqs[1] - freqs[0]);
+    }
+    for (int b = 0; b < band_count; b++) {
+        depths[b] = spectrum_band_depth(rate, freqs[b]);
+    }
+    int level_count = 0;
+    for (int depth = 0; depth <= SPECTRUM_MAX_OCTAVE_DEPTH; depth++) {
+        int members = 0;
+        float lowest = 0.0f;
+        for (int b = 0; b < band_count; b++) {
+            if (depths[b] == depth) {
+                if (members == 0 || freqs[b] < lowest) {
+                    lowest = freqs[b];
+                }
+                members++;
+            }
+        }
+        if (members == 0) {
+            continue;
+        }
+        float level_rate = (float)rate / (float)(1 << depth);
+        int window = base_window;
+        if (depth > 0) {
+            int needed = (2 * hop_samples + (1 << depth) - 1) >> depth;
+            int q_needed = (int)ceilf((q * level_rate) / lowest);
+            if (q_needed > needed) {
+                needed = q_needed;
+            }
+            if (needed < SPECTRUM_MIN_OCTAVE_WINDOW) {
+                needed = SPECTRUM_MIN_OCTAVE_WINDOW;
+            }
+            window = 1;
+            while (window < needed) {
+                window <<= 1;
+            }
+            if (window > base_window) {
+                window = base_window;
+            }
+        }
+        SpectrumLevel *level = &levels[level_count++];
+        memset(level, 0, sizeof(*level));
+        level->depth = depth;
+        level->window_size = window;
+        level->band_count = members;
+        level->power_scale = ((float)base_window / (float)window) * ((float)base_window / (float)window);
+        level->band_indices = (int *)malloc(sizeof(int) * (size_t)members);
+        level->coeffs = (float *)malloc(sizeof(float) * (size_t)members);
+        level->hann = (float *)malloc(sizeof(float) * (size_t)window);
+        level->window = (float *)malloc(sizeof(float) * (size_t)window);
+        if (!level->band_indices || !level->coeffs || !level->hann || !level->window) {
+            free_spectrum_levels(levels, level_count);
+            return 0;
+        }
+        for (int i = 0; i < window; i++) {
+            level->hann[i] = window <= 1 ? 1.0f
+                                         : 0.5f - 0.5f * cosf((2.0f * (float)M_PI * (float)i) /
+                                                              (float)(window - 1));
+        }
+        int n = 0;
+        for (int b = 0; b < band_count; b++) {
+            if (depths[b] != depth) {
+                continue;
+            }
+            int k = (int)(0.5f + (((float)window * freqs[b]) / (float)(int)level_rate));
+            float omega = (2.0f * (float)M_PI * (float)k) / (float)window;
+            level->band_indices[n] = b;
+            level->coeffs[n] = 2.0f * cosf(omega);
+            n++;
+        }
+    }
+    *out_level_count = level_count;
+    return 1;
+}
+
+/*
+ * Spectrum analysis for each hop using an octave-decimated Goertzel filter bank.
  *
- * We compute a logarithmic set of bands between ~40Hz and 5kHz (or Nyquist),
- * apply a Hann window, then compute magnitudes per band per frame.
+ * We compute a logarithmic set of bands between ~40Hz and 5kHz (or Nyquist).
+ * Each octave is analyzed at the lowest sample rate that still contains it,
+ * with a Hann window sized for that octave, so the low bands are both cheaper
+ * and better resolved than at the full rate.
  */
 static int compute_spectrum(const DecodedAudio *audio, const Request *req, SpectrumResult *out) {
     memset(out, 0, sizeof(*out));
@@ -1160,6 +1397,9 @@ static int compute_spectrum(const DecodedAudio *audio, const Request *req, Spect
     }
     int window_size = next_pow2_clamped(hop_samples * 2);
     int band_count = req->band_count;
+    if (band_count <= 0 || band_count > MAX_BAND_COUNT) {
+        return 0;
+    }
     float nyquist = ((float)audio->mono_rate * 0.5f) - 1.0f;
     if (nyquist < 100.0f) {
         nyquist = 100.0f;
@@ -1169,62 +1409,59 @@ static int compute_spectrum(const DecodedAudio *audio, const Request *req, Spect
     if (max_freq <= min_freq) {
         max_freq = min_freq + 1.0f;
     }
-    float *coeffs = (float *)malloc(sizeof(float) * (size_t)band_count);
-    float *hann = (float *)malloc(sizeof(float) * (size_t)window_size);
-    float *window = (float *)malloc(sizeof(float) * (size_t)window_size);
-    float *all_mags = NULL;
-    int *positions = NULL;
-    if (!coeffs || !hann || !window) {
-        free(coeffs);
-        free(hann);
-        free(window);
-        return 0;
-    }
-    for (int i = 0; i < window_size; i++) {
-        if (window_size <= 1) {
-            hann[i] = 1.0f;
-        } else {
-            hann[i] = 0.5f - 0.5f * cosf((2.0f * (float)M_PI * (float)i) /
-                                          (float)(window_size - 1));
-        }
-    }
+    float freqs[MAX_BAND_COUNT];
     if (band_count <= 1) {
-        coeffs[0] = 2.0f;
+        freqs[0] = min_freq;
     } else {
         float ratio = powf(max_freq / min_freq, 1.0f / (float)(band_count - 1));
         for (int b = 0; b < band_count; b++) {
-            float freq = min_freq * powf(ratio, (float)b);
-            int k = (int)(0.5f + (((float)window_size * freq) / (float)audio->mono_rate));
-            float omega = (2.0f * (float)M_PI * (float)k) / (float)window_size;
-            coeffs[b] = 2.0f * cosf(omega);
+            freqs[b] = min_freq * powf(ratio, (float)b);
+        }
+    }
+    SpectrumLevel levels[SPECTRUM_MAX_OCTAVE_DEPTH + 1];
+    int level_count = 0;
+    if (!build_spectrum_levels(audio->mono_rate, freqs, band_count, hop_samples, window_size,
+                               levels, &level_count)) {
+        return 0;
+    }
+
+    const float *signals[SPECTRUM_MAX_OCTAVE_DEPTH + 1];
+    size_t signal_counts[SPECTRUM_MAX_OCTAVE_DEPTH + 1];
+    float *owned[SPECTRUM_MAX_OCTAVE_DEPTH + 1];
+    int max_depth = levels[level_count - 1].depth;
+    signals[0] = audio->mono_samples;
+    signal_counts[0] = audio->mono_sample_count;
+    owned[0] = NULL;
+    for (int depth = 1; depth <= max_depth; depth++) {
+        owned[depth] = half_band_decimate(signals[depth - 1], signal_counts[depth - 1],
+                                          &signal_counts[depth]);
+        signals[depth] = owned[depth];
+        if (!owned[depth]) {
+            for (int j = 1; j < depth; j++) {
+                free(owned[j]);
+            }
+            free_spectrum_levels(levels, level_count);
+            return 0;
         }
     }
 
+    float *all_mags = NULL;
+    int *positions = NULL;
     size_t max_possible_frames =
         (audio->mono_sample_count + (size_t)hop_samples - 1) / (size_t)hop_samples;
     size_t frame_count = max_possible_frames;
     if (frame_count > (size_t)req->max_frames) {
         frame_count = (size_t)req->max_frames;
     }
-    if (frame_count == 0) {
-        free(coeffs);
-        free(hann);
-        free(window);
-        return 0;
-    }
-
-    if (band_count <= 0 || frame_count > (SIZE_MAX / (size_t)band_count)) {
-        free(coeffs);
-        free(hann);
-        free(window);
-        return 0;
+    if (frame_count > 0 && frame_count <= (SIZE_MAX / (size_t)band_count)) {
+        all_mags = (float *)malloc(sizeof(float) * frame_count * (size_t)band_count);
+        positions = (int *)malloc(sizeof(int) * frame_count);
     }
-    all_mags = (float *)malloc(sizeof(float) * frame_count * (size_t)band_count);
-    positions = (int *)malloc(sizeof(int) * frame_count);
     if (!all_mags || !positions) {
-        free(coeffs);
-        free(hann);
-        free(window);
+        for (int depth = 1; depth <= max_depth; depth++) {
+            free(owned[depth]);
+        }
+        free_spectrum_levels(levels, level_count);
         free(all_mags);
         free(positions);
         return 0;
@@ -1234,37 +1471,49 @@ static int compute_spectrum(const DecodedAudio *audio, const Request *req, Spect
     for (size_t frame_idx = 0; frame_idx < frame_count; frame_idx++) {
         size_t start = frame_idx * (size_t)hop_samples;
         positions[frame_idx] = (int)((start * 1000u) / (unsigned)audio->mono_rate);
-        for (int i = 0; i < window_size; i++) {
-            size_t idx = start + (size_t)i;
-            float sample = idx < audio->mono_sample_count ? audio->mono_samples[idx] : 0.0f;
-            window[i] = sample * hann[i];
-        }
-        for (int b = 0; b < band_count; b++) {
-            float coeff = coeffs[b];
-            float s_prev = 0.0f;
-            float s_prev2 = 0.0f;
-            for (int i = 0; i < window_size; i++) {
-                float s = window[i] + (coeff * s_prev) - s_prev2;
-                s_prev2 = s_prev;
-                s_prev = s;
+        /* Every octave's window is centred on the full-rate window's centre. */
+        long long center = (long long)start + (long long)(window_size / 2);
+        for (int l = 0; l < level_count; l++) {
+            SpectrumLevel *level = &levels[l];
+            const float *signal = signals[level->depth];
+            long long count = (long long)signal_counts[level->depth];
+            long long first = (center >> level->depth) - (long long)(level->window_size / 2);
+            for (int i = 0; i < level->window_size; i++) {
+                long long idx = first + i;
+                float sample = (idx >= 0 && idx < count) ? signal[idx] : 0.0f;
+                level->window[i] = sample * level->hann[i];
             }
-            float power = (s_prev2 * s_prev2) + (s_prev * s_prev) - (coeff * s_prev * s_prev2);
-            float mag = (power > 0.0f) ? log1pf(power) : 0.0f;
-            all_mags[(frame_idx * (size_t)band_count) + (size_t)b] = mag;
-            if (mag > max_mag) {
-                max_mag = mag;
+            for (int n = 0; n < level->band_count; n++) {
+                float coeff = level->coeffs[n];
+                float s_prev = 0.0f;
+                float s_prev2 = 0.0f;
+                for (int i = 0; i < level->window_size; i++) {
+                    float s = level->window[i] + (coeff * s_prev) - s_prev2;
+                    s_prev2 = s_prev;
+                    s_prev = s;
+                }
+                float power =
+                    (s_prev2 * s_prev2) + (s_prev * s_prev) - (coeff * s_prev * s_prev2);
+                float mag = (power > 0.0f) ? log1pf(power * level->power_scale) : 0.0f;
+                all_mags[(frame_idx * (size_t)band_count) + (size_t)level->band_indices[n]] = mag;
+                if (mag > max_mag) {
+                    max_mag = mag;
+                }
             }
         }
     }
-    if (max_mag <= 0.0f) {
+    for (int depth = 1; depth <= max_depth; depth++) {
+        free(owned[depth]);
+    }
+    free_spectrum_levels(levels, level_count);
+    if (req->spectrum_peak > 0.0f) {
+        max_mag = req->spectrum_peak;
+    } else if (max_mag <= 0.0f) {
         max_mag = 1.0f;
     }
 
     SpectrumFrame *frames = (SpectrumFrame *)calloc(frame_count, sizeof(SpectrumFrame));
     if (!frames) {
-        free(coeffs);
-        free(hann);
-        free(window);
         free(all_mags);
         free(positions);
         return 0;
@@ -1277,9 +1526,6 @@ static int compute_spectrum(const DecodedAudio *audio, const Request *req, Spect
                 free(frames[j].bands);
             }
             free(frames);
-            free(coeffs);
-            free(hann);
-            free(window);
             free(all_mags);
             free(positions);
             return 0;
@@ -1293,10 +1539,8 @@ static int compute_spectrum(const DecodedAudio *audio, const Request *req, Spect
     out->duration_ms = audio->duration_ms;
     out->frame_count = frame_count;
     out->frames = frames;
+    out->peak = max_mag;
 
-    free(coeffs);
-    free(hann);
-    free(window);
     free(all_mags);
     free(positions);
     return 1;
@@ -1404,10 +1648,12 @@ static int compute_beat(const DecodedAudio *audio, const Request *req, BeatResul
         onsets[i] = diff > 0.0 ? diff : 0.0;
     }
 
-    double max_onset = 0.0;
-    for (size_t i = 0; i < energy_count; i++) {
-        if (onsets[i] > max_onset) {
-            max_onset = onsets[i];
+    double max_onset = req->beat_peak;
+    if (max_onset <= 0.0) {
+        for (size_t i = 0; i < energy_count; i++) {
+            if (onsets[i] > max_onset) {
+                max_onset = onsets[i];
+            }
         }
     }
     if (max_onset <= 0.0) {
@@ -1516,6 +1762,7 @@ static int compute_beat(const DecodedAudio *audio, const Request *req, BeatResul
     out->bpm = bpm > 0.0 ? bpm : 0.0;
     out->frame_count = energy_count;
     out->frames = frames;
+    out->peak = max_onset;
 
     free(energies);
     free(onsets);
@@ -1611,6 +1858,180 @@ static void free_spectrum_result(SpectrumResult *result) {
     memset(result, 0, sizeof(*result));
 }
 
+#ifndef TZ_PLAYER_NATIVE_LIBRARY
+/*
+ * Optional hardware performance counters (Linux perf_event_open).
+ *
+ * Requested with `"perf_counters": 1` or TZ_PLAYER_HELPER_PERF_COUNTERS=1 and
+ * reported per stage under `timings.counters`. Counters cover this process
+ * only, so the decode stage measures PCM conversion, not the ffmpeg child.
+ * Each event is opened separately so one unsupported event (common in VMs)
+ * does not drop the others; when none can be opened (perf_event_paranoid,
+ * seccomp, non-Linux) the response says `"available":false` and analysis is
+ * unaffected. Counts are scaled by enabled/running time to undo kernel
+ * multiplexing.
+ */
+enum {
+    PERF_COUNTER_CYCLES,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_L1D_MISSES,
+    PERF_COUNTER_LLC_MISSES,
+    PERF_COUNTER_BRANCH_MISSES,
+    PERF_COUNTER_COUNT
+};
+
+static const char *const PERF_COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+enum {
+    STAGE_DECODE,
+    STAGE_RESAMPLE,
+    STAGE_SPECTRUM,
+    STAGE_BEAT,
+    STAGE_WAVEFORM,
+    STAGE_SERIALIZE,
+    STAGE_COUNT
+};
+
+static const char *const STAGE_NAMES[STAGE_COUNT] = {
+    "decode", "resample", "spectrum", "beat", "waveform_proxy", "serialize"};
+
+/* Counter values at one point in time; negative means unavailable. */
+typedef struct {
+    double ms;
+    double counts[PERF_COUNTER_COUNT];
+} PerfMark;
+
+typedef struct {
+    int ran;
+    double ms;
+    double counts[PERF_COUNTER_COUNT];
+} StageCounters;
+
+static int g_perf_enabled = 0;
+static int g_perf_available = 0;
+static int g_perf_fds[PERF_COUNTER_COUNT] = {-1, -1, -1, -1, -1};
+static StageCounters g_stage_counters[STAGE_COUNT];
+
+#ifdef __linux__
+static int perf_open_counter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    return fd < 0 ? -1 : (int)fd;
+}
+
+static uint64_t perf_cache_miss_config(uint64_t cache) {
+    return cache | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |
+           ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+static void perf_counters_open(int requested) {
+    const char *env = getenv("TZ_PLAYER_HELPER_PERF_COUNTERS");
+    g_perf_enabled = requested || (env && *env && strcmp(env, "0") != 0);
+    if (!g_perf_enabled) {
+        return;
+    }
+#ifdef __linux__
+    g_perf_fds[PERF_COUNTER_CYCLES] =
+        perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    g_perf_fds[PERF_COUNTER_INSTRUCTIONS] =
+        perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    g_perf_fds[PERF_COUNTER_L1D_MISSES] =
+        perf_open_counter(PERF_TYPE_HW_CACHE, perf_cache_miss_config(PERF_COUNT_HW_CACHE_L1D));
+    g_perf_fds[PERF_COUNTER_LLC_MISSES] =
+        perf_open_counter(PERF_TYPE_HW_CACHE, perf_cache_miss_config(PERF_COUNT_HW_CACHE_LL));
+    g_perf_fds[PERF_COUNTER_BRANCH_MISSES] =
+        perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (g_perf_fds[c] >= 0) {
+            g_perf_available = 1;
+        }
+    }
+}
+
+static void perf_counters_close(void) {
+#ifdef __linux__
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (g_perf_fds[c] >= 0) {
+            close(g_perf_fds[c]);
+            g_perf_fds[c] = -1;
+        }
+    }
+#endif
+}
+
+static void perf_mark(PerfMark *mark) {
+    if (!g_perf_enabled) {
+        return;
+    }
+    mark->ms = now_ms();
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        mark->counts[c] = -1.0;
+#ifdef __linux__
+        uint64_t values[3];
+        if (g_perf_fds[c] >= 0 &&
+            read(g_perf_fds[c], values, sizeof(values)) == (ssize_t)sizeof(values) &&
+            values[2] > 0) {
+            mark->counts[c] = (double)values[0] * ((double)values[1] / (double)values[2]);
+        }
+#endif
+    }
+}
+
+static void perf_stage_end(int stage, const PerfMark *start) {
+    if (!g_perf_enabled) {
+        return;
+    }
+    PerfMark end;
+    perf_mark(&end);
+    StageCounters *out = &g_stage_counters[stage];
+    out->ran = 1;
+    out->ms = end.ms - start->ms;
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        out->counts[c] = (start->counts[c] >= 0.0 && end.counts[c] >= 0.0)
+                             ? end.counts[c] - start->counts[c]
+                             : -1.0;
+    }
+}
+
+static void write_perf_counters(void) {
+    printf(",\"counters\":{\"available\":%s,\"stages\":{",
+           g_perf_available ? "true" : "false");
+    int first = 1;
+    for (int s = 0; g_perf_available && s < STAGE_COUNT; s++) {
+        const StageCounters *stage = &g_stage_counters[s];
+        if (!stage->ran) {
+            continue;
+        }
+        printf("%s\"%s\":{\"ms\":%.3f", first ? "" : ",", STAGE_NAMES[s], stage->ms);
+        first = 0;
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            if (stage->counts[c] < 0.0) {
+                printf(",\"%s\":null", PERF_COUNTER_NAMES[c]);
+            } else {
+                printf(",\"%s\":%.0f", PERF_COUNTER_NAMES[c], stage->counts[c]);
+            }
+        }
+        double cycles = stage->counts[PERF_COUNTER_CYCLES];
+        double instructions = stage->counts[PERF_COUNTER_INSTRUCTIONS];
+        if (cycles > 0.0 && instructions >= 0.0) {
+            printf(",\"ipc\":%.3f}", instructions / cycles);
+        } else {
+            printf(",\"ipc\":null}");
+        }
+    }
+    printf("}}");
+}
+
 /* We keep band_count in a static for response writing simplicity. */
 static int g_response_band_count = 0;
 
@@ -1623,8 +2044,10 @@ static void write_full_response(const SpectrumResult *spec, const BeatResult *be
                                 const WaveformProxyResult *waveform, double decode_ms,
                                 double spectrum_ms, double beat_ms, double waveform_ms,
                                 double total_ms) {
-    printf("{\"schema\":\"%s\",\"helper_version\":\"%s\",\"duration_ms\":%d,", RESPONSE_SCHEMA,
-           HELPER_VERSION, spec->duration_ms);
+    PerfMark serialize_start;
+    perf_mark(&serialize_start);
+    printf("{\"schema\":\"%s\",\"helper_version\":\"%s\",\"duration_ms\":%d,\"peak\":%.9g,",
+           RESPONSE_SCHEMA, HELPER_VERSION, spec->duration_ms, (double)spec->peak);
     printf("\"frames\":[");
     for (size_t i = 0; i < spec->frame_count; i++) {
         if (i) {
@@ -1641,8 +2064,8 @@ static void write_full_response(const SpectrumResult *spec, const BeatResult *be
     }
     printf("]");
     if (beat && beat->frames && beat->frame_count > 0) {
-        printf(",\"beat\":{\"duration_ms\":%d,\"bpm\":%.3f,\"frames\":[", beat->duration_ms,
-               beat->bpm);
+        printf(",\"beat\":{\"duration_ms\":%d,\"bpm\":%.3f,\"peak\":%.17g,\"frames\":[",
+               beat->duration_ms, beat->bpm, beat->peak);
         for (size_t i = 0; i < beat->frame_count; i++) {
             if (i) {
                 putchar(',');
@@ -1663,9 +2086,14 @@ static void write_full_response(const SpectrumResult *spec, const BeatResult *be
         }
         printf("]}");
     }
+    perf_stage_end(STAGE_SERIALIZE, &serialize_start);
     printf(
-        ",\"timings\":{\"decode_ms\":%.3f,\"spectrum_ms\":%.3f,\"beat_ms\":%.3f,\"waveform_proxy_ms\":%.3f,\"total_ms\":%.3f}}",
+        ",\"timings\":{\"decode_ms\":%.3f,\"spectrum_ms\":%.3f,\"beat_ms\":%.3f,\"waveform_proxy_ms\":%.3f,\"total_ms\":%.3f",
         decode_ms, spectrum_ms, beat_ms, waveform_ms, total_ms);
+    if (g_perf_enabled) {
+        write_perf_counters();
+    }
+    printf("}}");
 }
 
 #ifdef _WIN32
@@ -1806,47 +2234,61 @@ int main(void) {
         return 1;
     }
 
+    perf_counters_open(req.perf_counters);
+    PerfMark stage_start;
     double total_start = now_ms();
     double decode_start = total_start;
     DecodedAudio audio;
+    perf_mark(&stage_start);
     if (!decode_audio_file(req.track_path, &audio)) {
         fprintf(stderr, "analysis failed (decode)\n");
+        perf_counters_close();
         release_instance_lock();
         free_request(&req);
         return 1;
     }
+    perf_stage_end(STAGE_DECODE, &stage_start);
+    perf_mark(&stage_start);
     if (!resample_down_if_needed(&audio, req.mono_target_rate_hz)) {
         fprintf(stderr, "analysis failed (resample)\n");
         free_decoded_audio(&audio);
+        perf_counters_close();
         release_instance_lock();
         free_request(&req);
         return 1;
     }
+    perf_stage_end(STAGE_RESAMPLE, &stage_start);
     double decode_ms = now_ms() - decode_start;
 
     SpectrumResult spec;
     double spectrum_start = now_ms();
+    perf_mark(&stage_start);
     if (!compute_spectrum(&audio, &req, &spec)) {
         fprintf(stderr, "analysis failed (spectrum)\n");
         free_decoded_audio(&audio);
+        perf_counters_close();
         release_instance_lock();
         free_request(&req);
         return 1;
     }
     double spectrum_ms = now_ms() - spectrum_start;
+    perf_stage_end(STAGE_SPECTRUM, &stage_start);
     BeatResult beat;
     double beat_ms = 0.0;
     if (req.beat_enabled) {
         double beat_start = now_ms();
+        perf_mark(&stage_start);
         if (!compute_beat(&audio, &req, &beat)) {
             fprintf(stderr, "analysis failed (beat)\n");
             free_spectrum_result(&spec);
             free_decoded_audio(&audio);
+            perf_counters_close();
             release_instance_lock();
             free_request(&req);
             return 1;
         }
         beat_ms = now_ms() - beat_start;
+        perf_stage_end(STAGE_BEAT, &stage_start);
     } else {
         memset(&beat, 0, sizeof(beat));
     }
@@ -1854,16 +2296,19 @@ int main(void) {
     double waveform_ms = 0.0;
     if (req.waveform_proxy_enabled) {
         double waveform_start = now_ms();
+        perf_mark(&stage_start);
         if (!compute_waveform_proxy(&audio, &req, &waveform)) {
             fprintf(stderr, "analysis failed (waveform_proxy)\n");
             free_beat_result(&beat);
             free_spectrum_result(&spec);
             free_decoded_audio(&audio);
+            perf_counters_close();
             release_instance_lock();
             free_request(&req);
             return 1;
         }
         waveform_ms = now_ms() - waveform_start;
+        perf_stage_end(STAGE_WAVEFORM, &stage_start);
     } else {
         memset(&waveform, 0, sizeof(waveform));
     }
@@ -1877,7 +2322,212 @@ int main(void) {
     free_waveform_proxy_result(&waveform);
     free_spectrum_result(&spec);
     free_decoded_audio(&audio);
+    perf_counters_close();
     release_instance_lock();
     free_request(&req);
     return 0;
 }
+#endif /* !TZ_PLAYER_NATIVE_LIBRARY */
+
+#ifdef TZ_PLAYER_NATIVE_LIBRARY
+/*
+ * Stable C ABI over caller-owned plain buffers (libtz_player_native).
+ *
+ * - Bump TZN_ABI_VERSION on any signature or semantic change; the Python
+ *   loader (services/native_dsp.py) refuses mismatched libraries.
+ * - Output buffers are sized by the caller from `max_frames`; kernels never
+ *   write more than that many frames and return the frame count written,
+ *   0 when there is nothing to analyze, or -1 on invalid arguments or
+ *   allocation failure.
+ */
+#ifdef _WIN32
+#define TZN_EXPORT __declspec(dllexport)
+#else
+#define TZN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define TZN_ABI_VERSION 2
+
+static int clamp_int(int value, int lo, int hi) {
+    if (value < lo) {
+        return lo;
+    }
+    if (value > hi) {
+        return hi;
+    }
+    return value;
+}
+
+static int mono_view(const float *mono, long count, int rate, DecodedAudio *view) {
+    memset(view, 0, sizeof(*view));
+    if (!mono || count <= 0 || rate <= 0) {
+        return 0;
+    }
+    view->mono_rate = rate;
+    view->mono_sample_count = (size_t)count;
+    view->mono_samples = (float *)mono;
+    view->duration_ms = (int)(((size_t)count * 1000u) / (unsigned)rate);
+    if (view->duration_ms < 1) {
+        view->duration_ms = 1;
+    }
+    return 1;
+}
+
+TZN_EXPORT int tzn_abi_version(void) {
+    return TZN_ABI_VERSION;
+}
+
+/*
+ * Spectrum bands: positions[max_frames], bands[max_frames * band_count].
+ * `ref_peak` > 0 fixes the full-scale magnitude (0 derives it from the input);
+ * the scale used is written to `out_peak`.
+ */
+TZN_EXPORT int tzn_spectrum(const float *mono, long count, int rate, int hop_ms,
+                            int band_count, int max_frames, float ref_peak,
+                            int32_t *out_positions, uint8_t *out_bands, float *out_peak) {
+    DecodedAudio view;
+    if (!mono_view(mono, count, rate, &view) || band_count <= 0 || max_frames <= 0 ||
+        !out_positions || !out_bands || !out_peak) {
+        return -1;
+    }
+    Request req;
+    memset(&req, 0, sizeof(req));
+    req.hop_ms = clamp_int(hop_ms, 10, MAX_HOP_MS);
+    req.band_count = clamp_int(band_count, 1, MAX_BAND_COUNT);
+    req.max_frames = clamp_int(max_frames, 1, MAX_FRAME_COUNT);
+    req.spectrum_peak = ref_peak > 0.0f ? ref_peak : 0.0f;
+    if (req.band_count != band_count) {
+        return -1;
+    }
+    SpectrumResult spec;
+    if (!compute_spectrum(&view, &req, &spec)) {
+        return -1;
+    }
+    for (size_t i = 0; i < spec.frame_count; i++) {
+        out_positions[i] = spec.frames[i].pos_ms;
+        memcpy(out_bands + (i * (size_t)band_count), spec.frames[i].bands, (size_t)band_count);
+    }
+    *out_peak = spec.peak;
+    int written = (int)spec.frame_count;
+    free_spectrum_result(&spec);
+    return written;
+}
+
+/*
+ * Beat timeline: positions/strength/is_beat[max_frames] plus estimated BPM.
+ * `ref_peak` and `out_peak` carry the onset scale like tzn_spectrum.
+ */
+TZN_EXPORT int tzn_beat(const float *mono, long count, int rate, int hop_ms, int max_frames,
+                        double ref_peak, int32_t *out_positions, uint8_t *out_strength,
+                        uint8_t *out_is_beat, double *out_bpm, double *out_peak) {
+    DecodedAudio view;
+    if (!mono_view(mono, count, rate, &view) || max_frames <= 0 || !out_positions ||
+        !out_strength || !out_is_beat || !out_bpm || !out_peak) {
+        return -1;
+    }
+    Request req;
+    memset(&req, 0, sizeof(req));
+    req.beat_enabled = 1;
+    req.beat_hop_ms = clamp_int(hop_ms, 10, MAX_HOP_MS);
+    req.beat_max_frames = clamp_int(max_frames, 1, MAX_BEAT_FRAME_COUNT);
+    req.beat_peak = ref_peak > 0.0 ? ref_peak : 0.0;
+    BeatResult beat;
+    if (!compute_beat(&view, &req, &beat)) {
+        return -1;
+    }
+    for (size_t i = 0; i < beat.frame_count; i++) {
+        out_positions[i] = beat.frames[i].pos_ms;
+        out_strength[i] = (uint8_t)clamp_int(beat.frames[i].strength_u8, 0, 255);
+        out_is_beat[i] = beat.frames[i].is_beat ? 1u : 0u;
+    }
+    *out_bpm = beat.bpm;
+    *out_peak = beat.peak;
+    int written = (int)beat.frame_count;
+    free_beat_result(&beat);
+    return written;
+}
+
+/* Waveform proxy: positions[max_frames], levels[max_frames * 4] (lmin,lmax,rmin,rmax). */
+TZN_EXPORT int tzn_waveform_proxy(const float *left, const float *right, long count, int rate,
+                                  int hop_ms, int max_frames, int32_t *out_positions,
+                                  int8_t *out_levels) {
+    if (!left || !right || count <= 0 || rate <= 0 || max_frames <= 0 || !out_positions ||
+        !out_levels) {
+        return -1;
+    }
+    DecodedAudio view;
+    memset(&view, 0, sizeof(view));
+    view.stereo_rate = rate;
+    view.stereo_sample_count = (size_t)count;
+    view.left_samples = (float *)left;
+    view.right_samples = (float *)right;
+    view.duration_ms = (int)(((size_t)count * 1000u) / (unsigned)rate);
+    Request req;
+    memset(&req, 0, sizeof(req));
+    req.waveform_proxy_enabled = 1;
+    req.waveform_hop_ms = clamp_int(hop_ms, 10, MAX_HOP_MS);
+    req.waveform_max_frames = clamp_int(max_frames, 1, MAX_WAVEFORM_FRAME_COUNT);
+    WaveformProxyResult waveform;
+    if (!compute_waveform_proxy(&view, &req, &waveform)) {
+        return -1;
+    }
+    for (size_t i = 0; i < waveform.frame_count; i++) {
+        const WaveformProxyFrame *frame = &waveform.frames[i];
+        out_positions[i] = frame->pos_ms;
+        out_levels[i * 4u + 0u] = (int8_t)frame->lmin;
+        out_levels[i * 4u + 1u] = (int8_t)frame->lmax;
+        out_levels[i * 4u + 2u] = (int8_t)frame->rmin;
+        out_levels[i * 4u + 3u] = (int8_t)frame->rmax;
+    }
+    int written = (int)waveform.frame_count;
+    free_waveform_proxy_result(&waveform);
+    return written;
+}
+
+/*
+ * Streaming level envelope over interleaved s16 PCM.
+ *
+ * Accumulates mean |sample| per channel (first two channels; mono duplicates
+ * left) into buckets of `bucket_frames`. `carry` holds {left_sum, right_sum,
+ * frames_in_bucket} across calls so buckets may span chunk boundaries. Each
+ * completed bucket writes a clamped (left, right) pair to `out_levels`.
+ * Accumulation order and double precision match the Python fallback.
+ */
+TZN_EXPORT int tzn_envelope_s16(const int16_t *pcm, long frames, int channels,
+                                int bucket_frames, double *carry, double *out_levels,
+                                int max_buckets) {
+    if (!pcm || frames < 0 || channels <= 0 || bucket_frames <= 0 || !carry ||
+        !out_levels || max_buckets < 0) {
+        return -1;
+    }
+    double left_sum = carry[0];
+    double right_sum = carry[1];
+    long bucket_count = (long)carry[2];
+    int written = 0;
+    for (long i = 0; i < frames; i++) {
+        const int16_t *frame = pcm + (i * (long)channels);
+        int left = frame[0];
+        int right = channels > 1 ? frame[1] : left;
+        left_sum += (double)(left < 0 ? -left : left) / 32768.0;
+        right_sum += (double)(right < 0 ? -right : right) / 32768.0;
+        bucket_count += 1;
+        if (bucket_count >= bucket_frames) {
+            if (written >= max_buckets) {
+                return -1;
+            }
+            double l = left_sum / (double)bucket_count;
+            double r = right_sum / (double)bucket_count;
+            out_levels[written * 2] = l > 1.0 ? 1.0 : l;
+            out_levels[written * 2 + 1] = r > 1.0 ? 1.0 : r;
+            written += 1;
+            left_sum = 0.0;
+            right_sum = 0.0;
+            bucket_count = 0;
+        }
+    }
+    carry[0] = left_sum;
+    carry[1] = right_sum;
+    carry[2] = (double)bucket_count;
+    return written;
+}
+#endif /* TZ_PLAYER_NATIVE_LIBRARY */
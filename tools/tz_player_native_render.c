@@ -0,0 +1,184 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define TZR_EXPORT __declspec(dllexport)
+#else
+#define TZR_EXPORT __attribute__((visibility("default")))
+#endif
+
+/*
+ * tz_player_native_render.c
+ *
+ * Overview
+ * - Optional, dependency-free shared library with hot visualizer render
+ *   primitives. tz-player loads it via ctypes when present and falls back to
+ *   pure-Python implementations otherwise (see visualizers/render_kernel.py).
+ * - Every entry point works on caller-owned plain buffers; nothing here
+ *   allocates, so the library is safe to call from any thread.
+ * - Results must stay byte-identical to the Python fallbacks.
+ *
+ * Cell model
+ *   A render grid is `rows * width` uint8 cell ids. A palette maps each id to
+ *   a UTF-8 glyph plus an optional SGR prefix. Serialization coalesces runs of
+ *   cells sharing one SGR prefix and emits a single reset per run.
+ */
+
+#define TZR_ABI_VERSION 1
+#define TZR_SGR_RESET "\x1b[0m"
+#define TZR_SGR_RESET_LEN 4
+
+TZR_EXPORT int tzr_abi_version(void) {
+    return TZR_ABI_VERSION;
+}
+
+/* Round-half-to-even integer division to match Python's round(a / b). */
+static int div_round_half_even(long total, long count) {
+    long quotient = total / count;
+    long remainder = total % count;
+    if (remainder * 2 > count) {
+        return (int)(quotient + 1);
+    }
+    if (remainder * 2 == count && (quotient & 1L)) {
+        return (int)(quotient + 1);
+    }
+    return (int)quotient;
+}
+
+/*
+ * Collapse `band_count` u8 bands into `width` columns using the same bucket
+ * bounds as spectrum_lut.band_ranges. `peak != 0` max-pools, else mean-pools.
+ */
+TZR_EXPORT int tzr_collapse_bands(const uint8_t *bands, int band_count, int width,
+                                  int peak, uint8_t *out) {
+    if (width <= 0 || out == NULL) {
+        return -1;
+    }
+    if (bands == NULL || band_count <= 0) {
+        memset(out, 0, (size_t)width);
+        return 0;
+    }
+    for (int idx = 0; idx < width; ++idx) {
+        int start = (int)(((long)idx * band_count) / width);
+        int end = (int)(((long)(idx + 1) * band_count) / width);
+        if (end <= start) {
+            end = start + 1 < band_count ? start + 1 : band_count;
+        }
+        if (start >= band_count || end <= start) {
+            out[idx] = 0;
+            continue;
+        }
+        if (peak) {
+            uint8_t best = 0;
+            for (int b = start; b < end; ++b) {
+                if (bands[b] > best) {
+                    best = bands[b];
+                }
+            }
+            out[idx] = best;
+        } else {
+            long total = 0;
+            for (int b = start; b < end; ++b) {
+                total += bands[b];
+            }
+            out[idx] = (uint8_t)div_round_half_even(total, end - start);
+        }
+    }
+    return 0;
+}
+
+/*
+ * Rasterize per-column bar heights (0..rows-1, bottom-up) into a top-down cell
+ * grid. The cell at a column's height gets `cap_ids[col]`, cells below it get
+ * `body_ids[col]`, and cells above it get id 0.
+ */
+TZR_EXPORT int tzr_rasterize_bars(const int32_t *heights, const uint8_t *cap_ids,
+                                  const uint8_t *body_ids, int width, int rows,
+                                  uint8_t *grid) {
+    if (width <= 0 || rows <= 0) {
+        return -1;
+    }
+    for (int row = 0; row < rows; ++row) {
+        int threshold = rows - 1 - row;
+        uint8_t *line = grid + ((size_t)row * (size_t)width);
+        for (int col = 0; col < width; ++col) {
+            int32_t height = heights[col];
+            if (height < threshold) {
+                line[col] = 0;
+            } else if (height == threshold) {
+                line[col] = cap_ids[col];
+            } else {
+                line[col] = body_ids[col];
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Serialize a cell grid into UTF-8 lines separated by '\n'.
+ *
+ * Palette entry `id` spans glyph_blob[glyph_offsets[id]..glyph_offsets[id+1]]
+ * and sgr_blob[sgr_offsets[id]..sgr_offsets[id+1]]. Uncolored spaces do not
+ * break a colored run. Returns bytes written, or -1 if `out_cap` is too small
+ * or a cell id is outside the palette.
+ */
+TZR_EXPORT long tzr_serialize_grid(const uint8_t *cells, int width, int rows,
+                                   const char *glyph_blob,
+                                   const int32_t *glyph_offsets,
+                                   const char *sgr_blob, const int32_t *sgr_offsets,
+                                   int palette_size, char *out, long out_cap) {
+    long used = 0;
+#define TZR_APPEND(ptr, len)                                                  \
+    do {                                                                      \
+        long n_ = (long)(len);                                                \
+        if (used + n_ > out_cap) {                                            \
+            return -1;                                                        \
+        }                                                                     \
+        memcpy(out + used, (ptr), (size_t)n_);                                \
+        used += n_;                                                           \
+    } while (0)
+
+    for (int row = 0; row < rows; ++row) {
+        const uint8_t *line = cells + ((size_t)row * (size_t)width);
+        int current = -1;
+        if (row > 0) {
+            TZR_APPEND("\n", 1);
+        }
+        for (int col = 0; col < width; ++col) {
+            int id = line[col];
+            if (id >= palette_size) {
+                return -1;
+            }
+            const char *glyph = glyph_blob + glyph_offsets[id];
+            long glyph_len = glyph_offsets[id + 1] - glyph_offsets[id];
+            long sgr_len = sgr_offsets[id + 1] - sgr_offsets[id];
+            if (sgr_len == 0) {
+                if (current >= 0 && !(glyph_len == 1 && glyph[0] == ' ')) {
+                    TZR_APPEND(TZR_SGR_RESET, TZR_SGR_RESET_LEN);
+                    current = -1;
+                }
+            } else {
+                const char *sgr = sgr_blob + sgr_offsets[id];
+                int same = 0;
+                if (current >= 0) {
+                    long cur_len = sgr_offsets[current + 1] - sgr_offsets[current];
+                    same = cur_len == sgr_len &&
+                           memcmp(sgr_blob + sgr_offsets[current], sgr,
+                                  (size_t)sgr_len) == 0;
+                }
+                if (!same) {
+                    TZR_APPEND(sgr, sgr_len);
+                    current = id;
+                }
+            }
+            TZR_APPEND(glyph, glyph_len);
+        }
+        if (current >= 0) {
+            TZR_APPEND(TZR_SGR_RESET, TZR_SGR_RESET_LEN);
+        }
+    }
+#undef TZR_APPEND
+    return used;
+}